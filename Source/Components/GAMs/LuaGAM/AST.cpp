@@ -22,7 +22,7 @@ namespace Rules {
  * @param[out] ok control flag reference for correct node building
  * @return Block node
  */
-Nodep block(Rc<TokenpList::iterator> &tok_it, bool &ok);
+Nodep block(TokenpList::iterator &tok_it, bool &ok);
 
 /**
  * @brief Build statement noe
@@ -30,7 +30,7 @@ Nodep block(Rc<TokenpList::iterator> &tok_it, bool &ok);
  * @param[out] ok control flag reference for correct node building
  * @return Statement node
  */
-Nodep stat(Rc<TokenpList::iterator> &tok_it, bool &ok);
+Nodep stat(TokenpList::iterator &tok_it, bool &ok);
 
 /**
  * @brief Build attribute namelist
@@ -38,7 +38,7 @@ Nodep stat(Rc<TokenpList::iterator> &tok_it, bool &ok);
  * @param[out] ok control flag reference for correct node building
  * @return Atribute name list node
  */
-Nodep attnamelist(Rc<TokenpList::iterator> &tok_it, bool &ok);
+Nodep attnamelist(TokenpList::iterator &tok_it, bool &ok);
 
 /**
  * @brief Build return statement node
@@ -46,7 +46,7 @@ Nodep attnamelist(Rc<TokenpList::iterator> &tok_it, bool &ok);
  * @param[out] ok control flag reference for correct node building
  * @return Return statement node
  */
-Nodep retstat(Rc<TokenpList::iterator> &tok_it, bool &ok);
+Nodep retstat(TokenpList::iterator &tok_it, bool &ok);
 
 /**
  * @brief Build function name
@@ -54,7 +54,7 @@ Nodep retstat(Rc<TokenpList::iterator> &tok_it, bool &ok);
  * @param[out] ok control flag reference for correct node building
  * @return Functionbody node
  */
-Nodep funcname(Rc<TokenpList::iterator> &tok_it, bool &ok);
+Nodep funcname(TokenpList::iterator &tok_it, bool &ok);
 
 /**
  * @brief Build variable list
@@ -62,7 +62,7 @@ Nodep funcname(Rc<TokenpList::iterator> &tok_it, bool &ok);
  * @param[out] ok control flag reference for correct node building
  * @return Variable list node
  */
-Nodep varlist(Rc<TokenpList::iterator> &tok_it, bool &ok);
+Nodep varlist(TokenpList::iterator &tok_it, bool &ok);
 
 /**
  * @brief Build variable or function call
@@ -72,7 +72,7 @@ Nodep varlist(Rc<TokenpList::iterator> &tok_it, bool &ok);
  * FUNCTIONCALL)
  * @return Variable/functioncall node
  */
-Nodep var_or_funcall(Rc<TokenpList::iterator> &tok_it, bool &ok, LuaNode expected);
+Nodep var_or_funcall(TokenpList::iterator &tok_it, bool &ok, LuaNode expected);
 
 /**
  * @brief Build name list
@@ -80,7 +80,7 @@ Nodep var_or_funcall(Rc<TokenpList::iterator> &tok_it, bool &ok, LuaNode expecte
  * @param[out] ok control flag reference for correct node building
  * @return Name list node
  */
-Nodep namelist(Rc<TokenpList::iterator> &tok_it, bool &ok);
+Nodep namelist(TokenpList::iterator &tok_it, bool &ok);
 
 /**
  * @brief Build expression list
@@ -88,7 +88,7 @@ Nodep namelist(Rc<TokenpList::iterator> &tok_it, bool &ok);
  * @param[out] ok control flag reference for correct node building
  * @return Expression list list node
  */
-Nodep explist(Rc<TokenpList::iterator> &tok_it, bool &ok);
+Nodep explist(TokenpList::iterator &tok_it, bool &ok);
 
 /**
  * @brief Build expression
@@ -96,7 +96,7 @@ Nodep explist(Rc<TokenpList::iterator> &tok_it, bool &ok);
  * @param[out] ok control flag reference for correct node building
  * @return Expression node
  */
-Nodep exp(Rc<TokenpList::iterator> &tok_it, bool &ok);
+Nodep exp(TokenpList::iterator &tok_it, bool &ok);
 
 /**
  * @brief Build prefixed expression
@@ -104,7 +104,7 @@ Nodep exp(Rc<TokenpList::iterator> &tok_it, bool &ok);
  * @param[out] ok control flag reference for correct node building
  * @return Prefixed expression node
  */
-Nodep prefixexp(Rc<TokenpList::iterator> &tok_it, bool &ok);
+Nodep prefixexp(TokenpList::iterator &tok_it, bool &ok);
 
 /**
  * @brief Build arguments
@@ -112,7 +112,7 @@ Nodep prefixexp(Rc<TokenpList::iterator> &tok_it, bool &ok);
  * @param[out] ok control flag reference for correct node building
  * @return Arguments node
  */
-Nodep args(Rc<TokenpList::iterator> &tok_it, bool &ok);
+Nodep args(TokenpList::iterator &tok_it, bool &ok);
 
 /**
  * @brief Build functionbody
@@ -120,7 +120,7 @@ Nodep args(Rc<TokenpList::iterator> &tok_it, bool &ok);
  * @param[out] ok control flag reference for correct node building
  * @return Function body node
  */
-Nodep funcbody(Rc<TokenpList::iterator> &tok_it, bool &ok);
+Nodep funcbody(TokenpList::iterator &tok_it, bool &ok);
 
 /**
  * @brief Build parameter list
@@ -128,7 +128,7 @@ Nodep funcbody(Rc<TokenpList::iterator> &tok_it, bool &ok);
  * @param[out] ok control flag reference for correct node building
  * @return Parameter list node
  */
-Nodep parlist(Rc<TokenpList::iterator> &tok_it, bool &ok);
+Nodep parlist(TokenpList::iterator &tok_it, bool &ok);
 
 /**
  * @brief Build table constructor
@@ -136,7 +136,7 @@ Nodep parlist(Rc<TokenpList::iterator> &tok_it, bool &ok);
  * @param[out] ok control flag reference for correct node building
  * @return Table constructor node
  */
-Nodep table(Rc<TokenpList::iterator> &tok_it, bool &ok);
+Nodep table(TokenpList::iterator &tok_it, bool &ok);
 
 /**
  * @brief Build generic Node instance
@@ -144,7 +144,7 @@ Nodep table(Rc<TokenpList::iterator> &tok_it, bool &ok);
  * @param[in] type LuaNode value
  * @return Node instance of declared type
  */
-Nodep node(Rc<TokenpList::iterator> &tok_it, LuaNode type);
+Nodep node(TokenpList::iterator &tok_it, LuaNode type);
 } // namespace Rules
 } // namespace LUA
 } // namespace MARTe
@@ -168,31 +168,38 @@ NodepList *ast_t::operator->() { return &nodes; }
 Nodep &ast_t::operator[](const uint32 &ind) const { return nodes[ind]; }
 
 void ast_t::print() {
-  for (Rc<NodepList::iterator> it = nodes.iterate(); it; it = it->next()) {
-    printf("%s\n", it->value()->toString(0, 4, true).cstr());
+  for (NodepList::iterator it = nodes.begin(); it != nodes.end(); ++it) {
+    printf("%s\n", it.value()->toString(0, 4, true).cstr());
   }
 }
 
 ast_t generate_ast(tokens_t tokens, bool &ok) {
   uint32 token_i = 0;
   ast_t ast;
-  Rc<TokenpList::iterator> tok_it = tokens->iterate();
-  while (tok_it && tok_it->value()->type != ENDCODE && ok) {
+  ast.symbols = tokens.symbols;
+  TokenpList::iterator tok_it = tokens->iterate();
+  while (tok_it && tok_it.value()->type != ENDCODE && ok) {
     ast += Rules::block(tok_it, ok);
+    // a block stops at `end`, `else`, `elseif` and `until` without
+    // consuming them: at top level they cannot close anything
+    if (ok && tok_it && tok_it.value()->type != ENDCODE) {
+      AST_ERROR(tok_it.value(), "Unexpected token outside of any block");
+      ok = false;
+    }
   }
   ok &= ast->len() > 0;
   return ast;
 }
 
-Nodep Rules::block(Rc<TokenpList::iterator> &tok_it, bool &ok) {
-  Nodep block = new Node(BLOCK);
-  while (tok_it && tok_it->value()->type != RETURN &&
-         tok_it->value()->type != ENDCODE && tok_it->value()->type != END &&
-         tok_it->value()->type != ELSEIF && tok_it->value()->type != UNTIL &&
-         tok_it->value()->type != ELSE && ok) {
+Nodep Rules::block(TokenpList::iterator &tok_it, bool &ok) {
+  Nodep block = make_rc<Node>(BLOCK);
+  while (tok_it && tok_it.value()->type != RETURN &&
+         tok_it.value()->type != ENDCODE && tok_it.value()->type != END &&
+         tok_it.value()->type != ELSEIF && tok_it.value()->type != UNTIL &&
+         tok_it.value()->type != ELSE && ok) {
     block->append(Rules::stat(tok_it, ok));
   }
-  if (tok_it->value()->type == RETURN && ok) {
+  if (tok_it.value()->type == RETURN && ok) {
     block->append(Rules::retstat(tok_it, ok));
   }
 
@@ -203,85 +210,85 @@ Nodep Rules::block(Rc<TokenpList::iterator> &tok_it, bool &ok) {
   return block;
 }
 
-Nodep Rules::stat(Rc<TokenpList::iterator> &tok_it, bool &ok) {
+Nodep Rules::stat(TokenpList::iterator &tok_it, bool &ok) {
   Nodep stat;
-  if (tok_it && tok_it->value()->type != ENDCODE && ok) {
+  if (tok_it && tok_it.value()->type != ENDCODE && ok) {
 
     // Comment
-    if (tok_it->value()->type == COMM) {
+    if (tok_it.value()->type == COMM) {
       stat = Rules::node(tok_it, COMMENT);
     }
 
     // Semicolon/break
-    else if (tok_it->value()->type == SEMCOL ||
-             tok_it->value()->type == BREAK) {
+    else if (tok_it.value()->type == SEMCOL ||
+             tok_it.value()->type == BREAK) {
       stat = Rules::node(tok_it, STAT);
     }
 
     // Reqiure
-    else if (tok_it->value()->type == REQUIRE) {
+    else if (tok_it.value()->type == REQUIRE) {
       stat = Rules::node(tok_it, STAT);
       stat->append(Rules::node(tok_it, MODULE));
     }
 
     // Label
-    else if (tok_it->value()->type == COLCOL) {
+    else if (tok_it.value()->type == COLCOL) {
       stat = Rules::node(tok_it, STAT);
-      if (tok_it->value()->type == ID) {
+      if (tok_it.value()->type == ID) {
         stat->append(Rules::node(tok_it, LABEL));
       } else {
-        AST_ERROR(tok_it->value(), "Missing name for `label` statement");
+        AST_ERROR(tok_it.value(), "Missing name for `label` statement");
         ok = false;
       }
-      if (tok_it->value()->type != COLCOL) {
-        AST_ERROR(tok_it->value(),
+      if (tok_it.value()->type != COLCOL) {
+        AST_ERROR(tok_it.value(),
                   "Missing closing double semicolon for `label` statement");
         ok = false;
       } else {
-        tok_it = tok_it->next();
+        tok_it = tok_it.next();
       }
     }
 
     // Goto
-    else if (tok_it->value()->type == GOTO) {
+    else if (tok_it.value()->type == GOTO) {
       stat = Rules::node(tok_it, STAT);
-      if (tok_it->value()->type == ID) {
+      if (tok_it.value()->type == ID) {
         stat->append(Rules::node(tok_it, NAME));
       } else {
-        AST_ERROR(tok_it->value(), "Missing name for `goto` statement");
+        AST_ERROR(tok_it.value(), "Missing name for `goto` statement");
         ok = false;
       }
     }
 
     // Do
-    else if (tok_it->value()->type == DO) {
+    else if (tok_it.value()->type == DO) {
       stat = Rules::node(tok_it, STAT);
       stat->append(Rules::block(tok_it, ok));
-      if (tok_it->value()->type != END) {
-        AST_ERROR(tok_it->value(), "Missing `end` for `do` statement");
+      if (tok_it.value()->type != END) {
+        AST_ERROR(tok_it.value(), "Missing `end` for `do` statement");
         ok = false;
       } else {
-        tok_it = tok_it->next();
+        tok_it = tok_it.next();
       }
     }
 
     // While loop
-    else if (tok_it->value()->type == WHILE) {
+    else if (tok_it.value()->type == WHILE) {
       stat = Rules::node(tok_it, STAT);
       stat->append(Rules::exp(tok_it, ok));
       if (ok) {
-        if (tok_it->value()->type == DO) {
-          tok_it = tok_it->next();
+        if (tok_it.value()->type == DO) {
+          tok_it = tok_it.next();
           stat->append(Rules::block(tok_it, ok));
-          if (ok && tok_it->value()->type != END) {
-            AST_ERROR(tok_it->value(), "Missing `end` after `while` statement");
+          if (ok && tok_it.value()->type != END) {
+            AST_ERROR(tok_it.value(), "Missing `end` after `while` statement");
             ok = false;
           }
           if (ok) {
-            tok_it = tok_it->next();
+            tok_it = tok_it.next();
           }
         } else {
-          AST_ERROR(tok_it->value(),
+          AST_ERROR(tok_it.value(),
                     "Missing `do` block for `while` statement");
           ok = false;
         }
@@ -289,15 +296,15 @@ Nodep Rules::stat(Rc<TokenpList::iterator> &tok_it, bool &ok) {
     }
 
     // Repeat until
-    else if (tok_it->value()->type == REPEAT) {
+    else if (tok_it.value()->type == REPEAT) {
       stat = Rules::node(tok_it, STAT);
       stat->append(Rules::block(tok_it, ok));
       if (ok) {
-        if (tok_it->value()->type == UNTIL) {
-          tok_it = tok_it->next();
+        if (tok_it.value()->type == UNTIL) {
+          tok_it = tok_it.next();
           stat->append(Rules::exp(tok_it, ok));
         } else {
-          AST_ERROR(tok_it->value(),
+          AST_ERROR(tok_it.value(),
                     "Missing `until` token for `repeat` statement");
           ok = false;
         }
@@ -305,127 +312,127 @@ Nodep Rules::stat(Rc<TokenpList::iterator> &tok_it, bool &ok) {
     }
 
     // If then
-    else if (tok_it->value()->type == IF) {
+    else if (tok_it.value()->type == IF) {
       stat = Rules::node(tok_it, STAT);
       stat->append(Rules::exp(tok_it, ok));
       if (ok) {
-        if (tok_it->value()->type == THEN) {
-          tok_it = tok_it->next();
+        if (tok_it.value()->type == THEN) {
+          tok_it = tok_it.next();
           stat->append(Rules::block(tok_it, ok));
         } else {
-          AST_ERROR(tok_it->value(), "Expecting `then` after `if`");
+          AST_ERROR(tok_it.value(), "Expecting `then` after `if`");
           ok = false;
         }
       }
-      while (ok && tok_it->value()->type == ELSEIF) {
+      while (ok && tok_it.value()->type == ELSEIF) {
         Nodep elseif = Rules::node(tok_it, STAT);
         stat->append(elseif);
         elseif->append(Rules::exp(tok_it, ok));
         if (ok) {
-          if (tok_it->value()->type == THEN) {
-            tok_it = tok_it->next();
+          if (tok_it.value()->type == THEN) {
+            tok_it = tok_it.next();
             elseif->append(Rules::block(tok_it, ok));
           } else {
-            AST_ERROR(tok_it->value(), "Expecting `then` after `elseif`");
+            AST_ERROR(tok_it.value(), "Expecting `then` after `elseif`");
             ok = false;
           }
         }
       }
-      if (ok && tok_it->value()->type == ELSE) {
+      if (ok && tok_it.value()->type == ELSE) {
         Nodep else_ = Rules::node(tok_it, STAT);
         stat->append(else_);
         else_->append(Rules::block(tok_it, ok));
       }
-      if (ok && tok_it->value()->type != END) {
-        AST_ERROR(tok_it->value(), "Missing `end` after `if` statement");
+      if (ok && tok_it.value()->type != END) {
+        AST_ERROR(tok_it.value(), "Missing `end` after `if` statement");
         ok = false;
       }
       if (ok) {
-        tok_it = tok_it->next();
+        tok_it = tok_it.next();
       }
     }
 
     // For statement
-    else if (tok_it->value()->type == FOR) {
+    else if (tok_it.value()->type == FOR) {
       stat = Rules::node(tok_it, STAT);
-      if (tok_it->value()->type != ID) {
-        AST_ERROR(tok_it->value(), "Expecting name or namelist");
+      if (tok_it.value()->type != ID) {
+        AST_ERROR(tok_it.value(), "Expecting name or namelist");
         ok = false;
       } else {
-        if (tok_it->next() && (tok_it->next()->value()->type == COMMA ||
-                               tok_it->next()->value()->type == IN)) {
+        if (tok_it.next() && (tok_it.next().value()->type == COMMA ||
+                               tok_it.next().value()->type == IN)) {
           stat->append(Rules::namelist(tok_it, ok));
           if (ok) {
-            if (tok_it->value()->type == IN) {
-              tok_it = tok_it->next();
+            if (tok_it.value()->type == IN) {
+              tok_it = tok_it.next();
               stat->append(Rules::explist(tok_it, ok));
             } else {
-              AST_ERROR(tok_it->value(), "Missing `in` after namelist");
+              AST_ERROR(tok_it.value(), "Missing `in` after namelist");
               ok = false;
             }
           }
         } else {
           stat->append(Rules::node(tok_it, NAME));
-          if (tok_it->value()->type == ASSIGN) {
-            tok_it = tok_it->next();
+          if (tok_it.value()->type == ASSIGN) {
+            tok_it = tok_it.next();
             stat->append(Rules::exp(tok_it, ok));
           } else {
-            AST_ERROR(tok_it->value(), "Missing variable assignment");
+            AST_ERROR(tok_it.value(), "Missing variable assignment");
             ok = false;
           }
           if (ok) {
-            if (tok_it->value()->type == COMMA) {
-              tok_it = tok_it->next();
+            if (tok_it.value()->type == COMMA) {
+              tok_it = tok_it.next();
               stat->append(Rules::exp(tok_it, ok));
             } else {
-              AST_ERROR(tok_it->value(), "Missing comma");
+              AST_ERROR(tok_it.value(), "Missing comma");
               ok = false;
             }
           }
           if (ok) {
-            if (tok_it->value()->type == COMMA) {
-              tok_it = tok_it->next();
+            if (tok_it.value()->type == COMMA) {
+              tok_it = tok_it.next();
               stat->append(Rules::exp(tok_it, ok));
             }
           }
         }
       }
       if (ok) {
-        if (tok_it->value()->type == DO) {
-          tok_it = tok_it->next();
+        if (tok_it.value()->type == DO) {
+          tok_it = tok_it.next();
           stat->append(Rules::block(tok_it, ok));
-          if (ok && tok_it->value()->type != END) {
-            AST_ERROR(tok_it->value(), "Missing `end after `for` statement");
+          if (ok && tok_it.value()->type != END) {
+            AST_ERROR(tok_it.value(), "Missing `end after `for` statement");
             ok = false;
           }
         } else {
-          AST_ERROR(tok_it->value(), "Missing `do` after `for` conditions");
+          AST_ERROR(tok_it.value(), "Missing `do` after `for` conditions");
           ok = false;
         }
       }
       if (ok) {
-        tok_it = tok_it->next();
+        tok_it = tok_it.next();
       }
     }
 
     // Function
-    else if (tok_it->value()->type == FUNCTION) {
+    else if (tok_it.value()->type == FUNCTION) {
       stat = Rules::node(tok_it, STAT);
       stat->append(Rules::funcname(tok_it, ok));
       stat->append(Rules::funcbody(tok_it, ok));
     }
 
     // Local definition
-    else if (tok_it->value()->type == LOCAL) {
+    else if (tok_it.value()->type == LOCAL) {
       stat = Rules::node(tok_it, LOCALSTAT);
 
       // Function
-      if (tok_it->value()->type == FUNCTION) {
+      if (tok_it.value()->type == FUNCTION) {
         stat->append(Rules::node(tok_it, LOCALFUNCTION));
-        if (tok_it->value()->type == ID) {
+        if (tok_it.value()->type == ID) {
           stat->append(Rules::node(tok_it, NAME));
         } else {
-          AST_ERROR(tok_it->value(),
+          AST_ERROR(tok_it.value(),
                     "Missing local function name for `local` statement");
           ok = false;
         }
@@ -433,38 +440,38 @@ Nodep Rules::stat(Rc<TokenpList::iterator> &tok_it, bool &ok) {
       }
 
       // Build attnamelist
-      else if (tok_it->value()->type == ID) {
+      else if (tok_it.value()->type == ID) {
         stat->append(Rules::attnamelist(tok_it, ok));
-        if (tok_it->value()->type == ASSIGN) {
-          tok_it = tok_it->next();
+        if (tok_it.value()->type == ASSIGN) {
+          tok_it = tok_it.next();
           stat->append(Rules::explist(tok_it, ok));
         }
       }
 
       else {
-        AST_ERROR(tok_it->value(),
+        AST_ERROR(tok_it.value(),
                   "Missing local function or attribute name list for "
                   "`local` statement");
         ok = false;
       }
     }
 
-    else if (tok_it->value()->type != OPAR && tok_it->value()->type != ID) {
-      AST_ERROR(tok_it->value(), "Invalid statement");
+    else if (tok_it.value()->type != OPAR && tok_it.value()->type != ID) {
+      AST_ERROR(tok_it.value(), "Invalid statement");
       ok = false;
     }
 
     // Varlist/functioncall
     else {
       bool ret = true;
-      Rc<TokenpList::iterator> init_it = tok_it;
-      stat = new Node(STAT);
+      TokenpList::iterator init_it = tok_it;
+      stat = make_rc<Node>(STAT);
 
       // Varlist
       stat->append(Rules::varlist(tok_it, ret));
       if (ret) {
-        if (tok_it->value()->type == ASSIGN) {
-          tok_it = tok_it->next();
+        if (tok_it.value()->type == ASSIGN) {
+          tok_it = tok_it.next();
         } else {
           ret = false;
         }
@@ -482,7 +489,7 @@ Nodep Rules::stat(Rc<TokenpList::iterator> &tok_it, bool &ok) {
       }
 
       if (!ret) {
-        AST_ERROR(tok_it->value(), "Invalid statement");
+        AST_ERROR(tok_it.value(), "Invalid statement");
         ok = false;
       }
     }
@@ -495,14 +502,14 @@ Nodep Rules::stat(Rc<TokenpList::iterator> &tok_it, bool &ok) {
   return stat;
 }
 
-Nodep Rules::varlist(Rc<TokenpList::iterator> &tok_it, bool &ok) {
-  Rc<TokenpList::iterator> init_it = tok_it;
+Nodep Rules::varlist(TokenpList::iterator &tok_it, bool &ok) {
+  TokenpList::iterator init_it = tok_it;
   Nodep varlist;
-  if (tok_it->value()->type != ENDCODE) {
-    varlist = new Node(VARLIST);
+  if (tok_it.value()->type != ENDCODE) {
+    varlist = make_rc<Node>(VARLIST);
     varlist->append(Rules::var_or_funcall(tok_it, ok, VAR));
-    while (tok_it->value()->type == COMMA && ok) {
-      tok_it = tok_it->next();
+    while (tok_it.value()->type == COMMA && ok) {
+      tok_it = tok_it.next();
       varlist->append(Rules::var_or_funcall(tok_it, ok, VAR));
     }
   }
@@ -515,60 +522,60 @@ Nodep Rules::varlist(Rc<TokenpList::iterator> &tok_it, bool &ok) {
   return varlist;
 }
 
-Nodep Rules::var_or_funcall(Rc<TokenpList::iterator> &tok_it, bool &ok,
+Nodep Rules::var_or_funcall(TokenpList::iterator &tok_it, bool &ok,
                             LuaNode expected) {
-  Rc<TokenpList::iterator> init_it = tok_it;
+  TokenpList::iterator init_it = tok_it;
   Nodep var;
-  if (tok_it->value()->type == ID) {
-    var = new Node(VAR);
+  if (tok_it.value()->type == ID) {
+    var = make_rc<Node>(VAR);
     var->append(Rules::node(tok_it, NAME));
-  } else if (tok_it->value()->type == OPAR) {
-    tok_it = tok_it->next();
-    var = new Node(VAR);
+  } else if (tok_it.value()->type == OPAR) {
+    tok_it = tok_it.next();
+    var = make_rc<Node>(VAR);
     var->append(Rules::exp(tok_it, ok));
-    if (tok_it->value()->type != CPAR && ok) {
-      AST_ERROR(tok_it->value(), "Missing closing parenthesys");
+    if (tok_it.value()->type != CPAR && ok) {
+      AST_ERROR(tok_it.value(), "Missing closing parenthesys");
       ok = false;
     } else {
-      tok_it = tok_it->next();
+      tok_it = tok_it.next();
     }
     if (ok &&
-        (tok_it->value()->type != OBRACK || tok_it->value()->type != DOT)) {
-      AST_ERROR(tok_it->value(), "Expecting `[` or `.` after `)`");
+        (tok_it.value()->type != OBRACK || tok_it.value()->type != DOT)) {
+      AST_ERROR(tok_it.value(), "Expecting `[` or `.` after `)`");
       ok = false;
     }
   } else {
     ok = false;
   }
 
-  while (tok_it->value()->type != ENDCODE && ok) {
-    if (tok_it->value()->type == DOT && tok_it->next() &&
-        tok_it->next()->value()->type == ID) {
-      tok_it = tok_it->next();
+  while (tok_it.value()->type != ENDCODE && ok) {
+    if (tok_it.value()->type == DOT && tok_it.next() &&
+        tok_it.next().value()->type == ID) {
+      tok_it = tok_it.next();
       var->sub_nodes[-1]->type = PREFIXEXP;
       var->append(Rules::node(tok_it, NAME));
       var->type = VAR;
-    } else if (tok_it->value()->type == OBRACK) {
-      tok_it = tok_it->next();
+    } else if (tok_it.value()->type == OBRACK) {
+      tok_it = tok_it.next();
       var->sub_nodes[-1]->type = PREFIXEXP;
       var->append(Rules::exp(tok_it, ok));
       var->type = VAR;
-      if (tok_it->value()->type != CBRACK && ok) {
-        AST_ERROR(tok_it->value(), "Missing closing bracket.")
+      if (tok_it.value()->type != CBRACK && ok) {
+        AST_ERROR(tok_it.value(), "Missing closing bracket.")
         ok = false;
       } else {
-        tok_it = tok_it->next();
+        tok_it = tok_it.next();
       }
-    } else if (tok_it->value()->type == COL && tok_it->next() &&
-               tok_it->next()->value()->type == ID) {
-      tok_it = tok_it->next();
+    } else if (tok_it.value()->type == COL && tok_it.next() &&
+               tok_it.next().value()->type == ID) {
+      tok_it = tok_it.next();
       var->sub_nodes[-1]->type = PREFIXEXP;
       var->append(Rules::node(tok_it, NAME));
       var->append(Rules::args(tok_it, ok));
       var->type = FUNCTIONCALL;
-    } else if (tok_it->value()->type == OPAR ||
-               tok_it->value()->type == STRING ||
-               tok_it->value()->type == OBRACE) {
+    } else if (tok_it.value()->type == OPAR ||
+               tok_it.value()->type == STRING ||
+               tok_it.value()->type == OBRACE) {
       var->sub_nodes[-1]->type = PREFIXEXP;
       var->append(Rules::args(tok_it, ok));
       var->type = FUNCTIONCALL;
@@ -589,12 +596,12 @@ Nodep Rules::var_or_funcall(Rc<TokenpList::iterator> &tok_it, bool &ok,
   return var;
 }
 
-Nodep Rules::explist(Rc<TokenpList::iterator> &tok_it, bool &ok) {
-  Rc<TokenpList::iterator> init_it = tok_it;
-  Nodep explist = new Node(EXPLIST);
+Nodep Rules::explist(TokenpList::iterator &tok_it, bool &ok) {
+  TokenpList::iterator init_it = tok_it;
+  Nodep explist = make_rc<Node>(EXPLIST);
   explist->append(Rules::exp(tok_it, ok));
-  while (tok_it->value()->type == COMMA && ok) {
-    tok_it = tok_it->next();
+  while (tok_it.value()->type == COMMA && ok) {
+    tok_it = tok_it.next();
     explist->append(Rules::exp(tok_it, ok));
   }
 
@@ -605,29 +612,29 @@ Nodep Rules::explist(Rc<TokenpList::iterator> &tok_it, bool &ok) {
   return explist;
 }
 
-Nodep Rules::exp(Rc<TokenpList::iterator> &tok_it, bool &ok) {
-  Rc<TokenpList::iterator> init_it = tok_it;
-  Nodep exp = new Node(EXP);
+Nodep Rules::exp(TokenpList::iterator &tok_it, bool &ok) {
+  TokenpList::iterator init_it = tok_it;
+  Nodep exp = make_rc<Node>(EXP);
   bool expect_exp = false;
-  while (tok_it->value()->type != ENDCODE && ok) {
+  while (tok_it.value()->type != ENDCODE && ok) {
     expect_exp = false;
-    if (tok_it->value()->type == NIL || tok_it->value()->type == FALSE ||
-        tok_it->value()->type == TRUE || tok_it->value()->type == VARARGS) {
+    if (tok_it.value()->type == NIL || tok_it.value()->type == FALSE ||
+        tok_it.value()->type == TRUE || tok_it.value()->type == VARARGS) {
       exp->append(Rules::node(tok_it, VALUE));
-    } else if (tok_it->value()->type == FUNCTION) {
+    } else if (tok_it.value()->type == FUNCTION) {
       exp->append(Rules::node(tok_it, FUNCTIONDEF));
-    } else if (tok_it->value()->type == STRING) {
+    } else if (tok_it.value()->type == STRING) {
       exp->append(Rules::node(tok_it, LITERALSTRING));
-    } else if (tok_it->value()->type == NUM) {
+    } else if (tok_it.value()->type == NUM) {
       exp->append(Rules::node(tok_it, NUMERAL));
-    } else if (tok_it->value()->type == ID || tok_it->value()->type == OPAR) {
+    } else if (tok_it.value()->type == ID || tok_it.value()->type == OPAR) {
       exp->append(Rules::prefixexp(tok_it, ok));
-    } else if (tok_it->value()->type == OBRACE) {
+    } else if (tok_it.value()->type == OBRACE) {
       exp->append(Rules::table(tok_it, ok));
     }
 
-    if (tok_it && tok_it->value()->unop && tok_it->value()->binop) {
-      switch (tok_it->prev()->value()->type) {
+    if (tok_it && tok_it.value()->unop && tok_it.value()->binop) {
+      switch (tok_it.prev().value()->type) {
       case ID:
       case NUM:
       case STRING:
@@ -637,12 +644,12 @@ Nodep Rules::exp(Rc<TokenpList::iterator> &tok_it, bool &ok) {
         exp->append(Rules::node(tok_it, UNOP));
       }
       expect_exp = true;
-    } else if (tok_it && tok_it->value()->unop) {
+    } else if (tok_it && tok_it.value()->unop) {
       exp->append(Rules::node(tok_it, UNOP));
       expect_exp = true;
-    } else if (tok_it && tok_it->value()->binop) {
-      if (tok_it->prev()->value()->binop) {
-        AST_ERROR(tok_it->value(), "Invalid expression");
+    } else if (tok_it && tok_it.value()->binop) {
+      if (tok_it.prev().value()->binop) {
+        AST_ERROR(tok_it.value(), "Invalid expression");
         ok = false;
       } else {
         exp->append(Rules::node(tok_it, BINOP));
@@ -654,7 +661,7 @@ Nodep Rules::exp(Rc<TokenpList::iterator> &tok_it, bool &ok) {
   }
 
   if (expect_exp) {
-    AST_ERROR(tok_it->value(), "Expecting expression after operator");
+    AST_ERROR(tok_it.value(), "Expecting expression after operator");
     ok = false;
   }
 
@@ -666,18 +673,18 @@ Nodep Rules::exp(Rc<TokenpList::iterator> &tok_it, bool &ok) {
   return exp;
 }
 
-Nodep Rules::prefixexp(Rc<TokenpList::iterator> &tok_it, bool &ok) {
-  Rc<TokenpList::iterator> init_it = tok_it;
+Nodep Rules::prefixexp(TokenpList::iterator &tok_it, bool &ok) {
+  TokenpList::iterator init_it = tok_it;
   bool ret = true;
   Nodep prefixexp;
-  if (tok_it->value()->type == OPAR) {
-    tok_it = tok_it->next();
+  if (tok_it.value()->type == OPAR) {
+    tok_it = tok_it.next();
     prefixexp = Rules::exp(tok_it, ret);
-    if (ret && tok_it->value()->type != CPAR) {
-      AST_ERROR(tok_it->value(), "Missing closing parenhtesis");
+    if (ret && tok_it.value()->type != CPAR) {
+      AST_ERROR(tok_it.value(), "Missing closing parenhtesis");
       ok = false;
     } else if (ret) {
-      tok_it = tok_it->next();
+      tok_it = tok_it.next();
     }
   } else {
     ret = false;
@@ -701,25 +708,25 @@ Nodep Rules::prefixexp(Rc<TokenpList::iterator> &tok_it, bool &ok) {
   return prefixexp;
 }
 
-Nodep Rules::args(Rc<TokenpList::iterator> &tok_it, bool &ok) {
-  Rc<TokenpList::iterator> init_it = tok_it;
-  Nodep args = new Node(ARGS);
+Nodep Rules::args(TokenpList::iterator &tok_it, bool &ok) {
+  TokenpList::iterator init_it = tok_it;
+  Nodep args = make_rc<Node>(ARGS);
 
-  if (tok_it->value()->type == OPAR) {
-    tok_it = tok_it->next();
+  if (tok_it.value()->type == OPAR) {
+    tok_it = tok_it.next();
     args->append(Rules::explist(tok_it, ok));
-    if (ok && tok_it->value()->type != CPAR) {
-      AST_ERROR(tok_it->value(), "Missing closing parenthesys after arguments");
+    if (ok && tok_it.value()->type != CPAR) {
+      AST_ERROR(tok_it.value(), "Missing closing parenthesys after arguments");
       ok = false;
     } else {
-      tok_it = tok_it->next();
+      tok_it = tok_it.next();
     }
-  } else if (tok_it->value()->type == STRING) {
+  } else if (tok_it.value()->type == STRING) {
     args->append(Rules::node(tok_it, LITERALSTRING));
-  } else if (tok_it->value()->type == OBRACE) {
+  } else if (tok_it.value()->type == OBRACE) {
     args->append(Rules::table(tok_it, ok));
   } else {
-    AST_ERROR(tok_it->value(), "Invalid arguments for function call");
+    AST_ERROR(tok_it.value(), "Invalid arguments for function call");
     ok = false;
     args.del();
     tok_it = init_it;
@@ -728,36 +735,36 @@ Nodep Rules::args(Rc<TokenpList::iterator> &tok_it, bool &ok) {
   return args;
 }
 
-Nodep Rules::table(Rc<TokenpList::iterator> &tok_it, bool &ok) {
-  Rc<TokenpList::iterator> init_it = tok_it;
-  if (tok_it->value()->type != OBRACE) {
-    AST_ERROR(tok_it->value(), "Missing opening brace for table");
+Nodep Rules::table(TokenpList::iterator &tok_it, bool &ok) {
+  TokenpList::iterator init_it = tok_it;
+  if (tok_it.value()->type != OBRACE) {
+    AST_ERROR(tok_it.value(), "Missing opening brace for table");
     ok = false;
     return Nodep();
   }
-  tok_it = tok_it->next();
-  Nodep table = new Node(TABLECONSTRUCTOR);
-  Nodep fieldlist = new Node(FIELDLIST);
+  tok_it = tok_it.next();
+  Nodep table = make_rc<Node>(TABLECONSTRUCTOR);
+  Nodep fieldlist = make_rc<Node>(FIELDLIST);
   table->append(fieldlist);
 
   while (true) {
-    Nodep field = new Node(FIELD);
+    Nodep field = make_rc<Node>(FIELD);
     bool ret = true;
-    if (tok_it->value()->type == OBRACK) {
-      tok_it = tok_it->next();
+    if (tok_it.value()->type == OBRACK) {
+      tok_it = tok_it.next();
       field->append(Rules::exp(tok_it, ret));
-      if (ret && tok_it->value()->type == CBRACK) {
-        tok_it = tok_it->next();
-        if (tok_it->value()->type == ASSIGN) {
-          tok_it = tok_it->next();
+      if (ret && tok_it.value()->type == CBRACK) {
+        tok_it = tok_it.next();
+        if (tok_it.value()->type == ASSIGN) {
+          tok_it = tok_it.next();
           // field->append(Rules::node(tok_it, BINOP));
           field->append(Rules::exp(tok_it, ret));
         }
       }
-    } else if (tok_it->value()->type == ID && tok_it->next() &&
-               tok_it->next()->value()->type == ASSIGN) {
+    } else if (tok_it.value()->type == ID && tok_it.next() &&
+               tok_it.next().value()->type == ASSIGN) {
       field->append(Rules::node(tok_it, NAME));
-      tok_it = tok_it->next();
+      tok_it = tok_it.next();
       // field->append(Rules::node(tok_it, BINOP));
       field->append(Rules::exp(tok_it, ret));
     } else {
@@ -770,18 +777,18 @@ Nodep Rules::table(Rc<TokenpList::iterator> &tok_it, bool &ok) {
     }
 
     fieldlist->append(field);
-    if (tok_it->value()->type == COMMA || tok_it->value()->type == SEMCOL) {
+    if (tok_it.value()->type == COMMA || tok_it.value()->type == SEMCOL) {
       fieldlist->append(Rules::node(tok_it, FIELDSEP));
     } else {
       break;
     }
   }
 
-  if (tok_it->value()->type != CBRACE) {
-    AST_ERROR(tok_it->value(), "Missing closing brace for table");
+  if (tok_it.value()->type != CBRACE) {
+    AST_ERROR(tok_it.value(), "Missing closing brace for table");
     ok = false;
   } else {
-    tok_it = tok_it->next();
+    tok_it = tok_it.next();
   }
 
   if (!ok) {
@@ -793,28 +800,28 @@ Nodep Rules::table(Rc<TokenpList::iterator> &tok_it, bool &ok) {
   return table;
 }
 
-Nodep Rules::funcname(Rc<TokenpList::iterator> &tok_it, bool &ok) {
-  Rc<TokenpList::iterator> init_it = tok_it;
+Nodep Rules::funcname(TokenpList::iterator &tok_it, bool &ok) {
+  TokenpList::iterator init_it = tok_it;
   Nodep funcname;
 
-  if (tok_it->value()->type == ID && ok) {
+  if (tok_it.value()->type == ID && ok) {
     funcname = Rules::node(tok_it, FUNCNAME);
   } else {
-    AST_ERROR(tok_it->value(), "Missing name for function");
+    AST_ERROR(tok_it.value(), "Missing name for function");
     ok = false;
   }
 
-  while (tok_it->value()->type == DOT && ok) {
-    tok_it = tok_it->next();
-    if (tok_it->value()->type == ID && ok) {
+  while (tok_it.value()->type == DOT && ok) {
+    tok_it = tok_it.next();
+    if (tok_it.value()->type == ID && ok) {
       funcname->append(Rules::node(tok_it, NAME));
     } else {
       break;
     }
   }
 
-  if (tok_it->value()->type == COL && ok) {
-    tok_it = tok_it->next();
+  if (tok_it.value()->type == COL && ok) {
+    tok_it = tok_it.next();
     funcname->append(Rules::node(tok_it, NAME));
   }
 
@@ -826,37 +833,37 @@ Nodep Rules::funcname(Rc<TokenpList::iterator> &tok_it, bool &ok) {
   return funcname;
 }
 
-Nodep Rules::funcbody(Rc<TokenpList::iterator> &tok_it, bool &ok) {
-  Rc<TokenpList::iterator> init_it = tok_it;
+Nodep Rules::funcbody(TokenpList::iterator &tok_it, bool &ok) {
+  TokenpList::iterator init_it = tok_it;
   Nodep funcbody;
 
-  if (tok_it->value()->type == OPAR && ok) {
-    funcbody = new Node(FUNCBODY);
-    tok_it = tok_it->next();
-    if (tok_it->value()->type != CPAR) {
+  if (tok_it.value()->type == OPAR && ok) {
+    funcbody = make_rc<Node>(FUNCBODY);
+    tok_it = tok_it.next();
+    if (tok_it.value()->type != CPAR) {
       funcbody->append(Rules::parlist(tok_it, ok));
     }
-    if (tok_it->value()->type != CPAR && ok) {
-      AST_ERROR(tok_it->value(), "Missing closing parenthesis");
+    if (tok_it.value()->type != CPAR && ok) {
+      AST_ERROR(tok_it.value(), "Missing closing parenthesis");
       ok = false;
     } else {
-      tok_it = tok_it->next();
+      tok_it = tok_it.next();
     }
   } else {
-    AST_ERROR(tok_it->value(), "Missing function arguments");
+    AST_ERROR(tok_it.value(), "Missing function arguments");
     ok = false;
   }
 
   if (ok) {
     funcbody->append(Rules::block(tok_it, ok));
   }
-  if (ok && tok_it->value()->type != END) {
-    AST_ERROR(tok_it->value(), "Missing `end` for function body");
+  if (ok && tok_it.value()->type != END) {
+    AST_ERROR(tok_it.value(), "Missing `end` for function body");
     ok = false;
   }
 
   if (ok) {
-    tok_it = tok_it->next();
+    tok_it = tok_it.next();
   }
 
   if (!ok) {
@@ -867,15 +874,15 @@ Nodep Rules::funcbody(Rc<TokenpList::iterator> &tok_it, bool &ok) {
   return funcbody;
 }
 
-Nodep Rules::parlist(Rc<TokenpList::iterator> &tok_it, bool &ok) {
-  Rc<TokenpList::iterator> init_it = tok_it;
+Nodep Rules::parlist(TokenpList::iterator &tok_it, bool &ok) {
+  TokenpList::iterator init_it = tok_it;
   Nodep parlist;
-  if (tok_it->value()->type == VARARGS) {
+  if (tok_it.value()->type == VARARGS) {
     parlist = Rules::node(tok_it, PARLIST);
   } else {
-    parlist = new Node(PARLIST);
+    parlist = make_rc<Node>(PARLIST);
     parlist->append(Rules::namelist(tok_it, ok));
-    if (tok_it->value()->type == VARARGS) {
+    if (tok_it.value()->type == VARARGS) {
       parlist->append(Rules::node(tok_it, NAME));
     }
   }
@@ -888,14 +895,14 @@ Nodep Rules::parlist(Rc<TokenpList::iterator> &tok_it, bool &ok) {
   return parlist;
 }
 
-Nodep Rules::retstat(Rc<TokenpList::iterator> &tok_it, bool &ok) {
-  Rc<TokenpList::iterator> init_it = tok_it;
+Nodep Rules::retstat(TokenpList::iterator &tok_it, bool &ok) {
+  TokenpList::iterator init_it = tok_it;
   Nodep retstat;
 
-  if (tok_it->value()->type == RETURN) {
+  if (tok_it.value()->type == RETURN) {
     retstat = Rules::node(tok_it, RETSTAT);
     retstat->append(Rules::explist(tok_it, ok));
-    if (ok && tok_it->value()->type == SEMCOL) {
+    if (ok && tok_it.value()->type == SEMCOL) {
       retstat->append(Rules::node(tok_it, UNDEFINED));
     }
   }
@@ -908,24 +915,24 @@ Nodep Rules::retstat(Rc<TokenpList::iterator> &tok_it, bool &ok) {
   return retstat;
 }
 
-Nodep Rules::namelist(Rc<TokenpList::iterator> &tok_it, bool &ok) {
-  Rc<TokenpList::iterator> init_it = tok_it;
+Nodep Rules::namelist(TokenpList::iterator &tok_it, bool &ok) {
+  TokenpList::iterator init_it = tok_it;
   Nodep namelist;
 
-  if (tok_it->value()->type == ID && ok) {
-    namelist = new Node(NAMELIST);
+  if (tok_it.value()->type == ID && ok) {
+    namelist = make_rc<Node>(NAMELIST);
     namelist->append(Rules::node(tok_it, NAME));
   } else {
-    AST_ERROR(tok_it->value(), "Empty namelist");
+    AST_ERROR(tok_it.value(), "Empty namelist");
     ok = false;
   }
 
-  if (tok_it->value()->type == COMMA && ok) {
-    tok_it = tok_it->next();
-    while (tok_it->value()->type == ID) {
+  if (tok_it.value()->type == COMMA && ok) {
+    tok_it = tok_it.next();
+    while (tok_it.value()->type == ID) {
       namelist->append(Rules::node(tok_it, NAME));
-      if (tok_it->value()->type == COMMA) {
-        tok_it = tok_it->next();
+      if (tok_it.value()->type == COMMA) {
+        tok_it = tok_it.next();
       } else {
         break;
       }
@@ -940,49 +947,49 @@ Nodep Rules::namelist(Rc<TokenpList::iterator> &tok_it, bool &ok) {
   return namelist;
 }
 
-Nodep Rules::attnamelist(Rc<TokenpList::iterator> &tok_it, bool &ok) {
-  Rc<TokenpList::iterator> init_it = tok_it;
+Nodep Rules::attnamelist(TokenpList::iterator &tok_it, bool &ok) {
+  TokenpList::iterator init_it = tok_it;
   Nodep attnamelist;
 
-  if (tok_it->value()->type == ID && ok) {
-    attnamelist = new Node(ATTNAMELIST);
+  if (tok_it.value()->type == ID && ok) {
+    attnamelist = make_rc<Node>(ATTNAMELIST);
     attnamelist->append(Rules::node(tok_it, NAME));
-    if (tok_it->value()->type == LT) {
-      tok_it = tok_it->next();
-      if (tok_it->value()->type == ID) {
+    if (tok_it.value()->type == LT) {
+      tok_it = tok_it.next();
+      if (tok_it.value()->type == ID) {
         attnamelist->append(Rules::node(tok_it, ATTRIB));
-        if (tok_it->value()->type == GT) {
-          tok_it = tok_it->next();
+        if (tok_it.value()->type == GT) {
+          tok_it = tok_it.next();
         } else {
-          AST_ERROR(tok_it->value(), "Missing closing attribute token");
+          AST_ERROR(tok_it.value(), "Missing closing attribute token");
           ok = false;
         }
       } else {
-        AST_ERROR(tok_it->value(), "Missing attribute name");
+        AST_ERROR(tok_it.value(), "Missing attribute name");
         ok = false;
       }
     }
   } else {
-    AST_ERROR(tok_it->value(), "Empty namelist");
+    AST_ERROR(tok_it.value(), "Empty namelist");
     ok = false;
   }
 
-  while (tok_it->value()->type == COMMA && ok) {
-    tok_it = tok_it->next();
-    if (tok_it->value()->type == ID && ok) {
+  while (tok_it.value()->type == COMMA && ok) {
+    tok_it = tok_it.next();
+    if (tok_it.value()->type == ID && ok) {
       attnamelist->append(Rules::node(tok_it, NAME));
-      if (tok_it->value()->type == LT) {
-        tok_it = tok_it->next();
-        if (tok_it->value()->type == ID) {
+      if (tok_it.value()->type == LT) {
+        tok_it = tok_it.next();
+        if (tok_it.value()->type == ID) {
           attnamelist->append(Rules::node(tok_it, ATTRIB));
-          if (tok_it->value()->type == GT) {
-            tok_it = tok_it->next();
+          if (tok_it.value()->type == GT) {
+            tok_it = tok_it.next();
           } else {
-            AST_ERROR(tok_it->value(), "Missing closing attribute token");
+            AST_ERROR(tok_it.value(), "Missing closing attribute token");
             ok = false;
           }
         } else {
-          AST_ERROR(tok_it->value(), "Missing attribute name");
+          AST_ERROR(tok_it.value(), "Missing attribute name");
           ok = false;
         }
       }
@@ -999,9 +1006,9 @@ Nodep Rules::attnamelist(Rc<TokenpList::iterator> &tok_it, bool &ok) {
   return attnamelist;
 }
 
-Nodep Rules::node(Rc<TokenpList::iterator> &tok_it, LuaNode type) {
-  Nodep n(new Node(type, tok_it->value()));
-  tok_it = tok_it->next();
+Nodep Rules::node(TokenpList::iterator &tok_it, LuaNode type) {
+  Nodep n = make_rc<Node>(type, tok_it.value());
+  tok_it = tok_it.next();
   return n;
 }
 } // namespace LUA
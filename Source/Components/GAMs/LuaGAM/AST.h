@@ -35,6 +35,7 @@ struct ast_t {
    */
   void print();
   NodepList nodes; //!< List of nodes representing the Abstract syntax tree
+  Rc<symbols_t> symbols; //!< Identifiers of the parsed code (if any)
 };
 
 /**
@@ -38,6 +38,8 @@
 #include "ErrorType.h"
 #include "Helpers.h"
 #include "LuaParser.h"
+#include "Optimiser.h"
+#include "ParseService.h"
 #include "StreamString.h"
 #include "StringHelper.h"
 #include "StructuredDataI.h"
@@ -585,6 +587,9 @@ LuaGAM::LuaGAM() : GAM(), MessageI() {
   code = NULL_PTR(char8 *);
   file_path = NULL_PTR(char8*);
   L = NULL_PTR(lua_State *);
+  cycle_budget = 0u;
+  optimise = 0u;
+  parse_job = NULL_PTR(LUA::parse_job_t *);
   inputs_functions = NULL_PTR(push_signal *);
   inputs_pointers = NULL_PTR(void **);
   inputs_sizes = NULL_PTR(uint32 *);
@@ -596,6 +601,11 @@ LuaGAM::LuaGAM() : GAM(), MessageI() {
 }
 
 LuaGAM::~LuaGAM() {
+  if (parse_job != NULL_PTR(LUA::parse_job_t *)) {
+    // the job references the code: it must be completed before freeing it
+    (void)LUA::ParseService::instance().wait(*parse_job);
+    delete parse_job;
+  }
   if (code != NULL_PTR(char8 *)) {
     delete[] code;
   }
@@ -653,6 +663,16 @@ bool LuaGAM::Initialise(StructuredDataI &data) {
   StreamString code_str;
   AnyType params_p[NUM_PARAMS] = {code_str};
   ok &= EC::validate_parameters(data, parameters, params_p, NUM_PARAMS);
+  if (!data.Read("CycleBudget", cycle_budget)) {
+    cycle_budget = 0u;
+  }
+  if (!data.Read("Optimise", optimise)) {
+    optimise = 0u;
+  }
+  uint8 parallel_parsing = 0u;
+  if (!data.Read("ParallelParsing", parallel_parsing)) {
+    parallel_parsing = 0u;
+  }
   uint32 code_str_size = 0;
   if (ok) {
     if (StringHelper::CompareN(code_str.Buffer(), "file://", 7) == 0) {
@@ -681,15 +701,20 @@ bool LuaGAM::Initialise(StructuredDataI &data) {
       memset(code, 0, code_str_size);
       ok &= StringHelper::Copy(code, code_str.Buffer());
     }
+    Str optimised;
+    const char8 *source = code;
+    if (ok && optimise != 0u && optimise_code(data, optimised)) {
+      source = optimised.cstr();
+    }
     if (ok) {
       L = luaL_newstate();
       ok &= init(L);
-      ok &= luaL_dostring(L, code) == LUA_OK;
+      ok &= luaL_dostring(L, source) == LUA_OK;
       if (!ok) {
         REPORT_ERROR(ErrorManagement::InitialisationError,
                      "Lua initialization error: `%s`", lua_tostring(L, -1));
         REPORT_ERROR(ErrorManagement::InitialisationError, "Lua code:\n%s",
-                     code);
+                     source);
       } else {
         uint32 stackSize = lua_gettop(L);
         lua_pop(L, stackSize);
@@ -715,7 +740,14 @@ bool LuaGAM::Initialise(StructuredDataI &data) {
     REPORT_ERROR(ErrorManagement::InitialisationError,
                  "Auxiliries initalisation failed");
   }
-  if (ok && code) {
+  if (ok && code && parallel_parsing != 0u) {
+    parse_job = new LUA::parse_job_t();
+    parse_job->code = code;
+    parse_job->only_gam = !IsCodeExternal();
+    // the budget depends on the signals (lengths of the arrays), see Setup
+    parse_job->cycle_budget = 0u;
+    LUA::ParseService::instance().submit(*parse_job);
+  } else if (ok && code) {
     ast = LUA::parse(code, ok);
   }
 
@@ -748,10 +780,22 @@ bool LuaGAM::Setup() {
     }
   }
   
+  bool verified = false;
+  if (parse_job != NULL_PTR(LUA::parse_job_t *)) {
+    const bool parsed = LUA::ParseService::instance().wait(*parse_job);
+    ok = ok && parsed;
+    ast = parse_job->ast;
+    delete parse_job;
+    parse_job = NULL_PTR(LUA::parse_job_t *);
+    verified = true;
+  }
+
   LUA::Verifier::LuaGAMValidator validator(ast);
-  ok &= validator.check_gam();
-  if (ok && !IsCodeExternal()){
-    ok &= validator.check_only_gam();
+  if (!verified) {
+    ok &= validator.check_gam();
+    if (ok && !IsCodeExternal()){
+      ok &= validator.check_only_gam();
+    }
   }
   if (ok && signalsDatabase.MoveRelative("InputSignals")) {
     inputs_functions = new push_signal[numberOfInputSignals];
@@ -796,6 +840,18 @@ bool LuaGAM::Setup() {
     }
     ok &= signalsDatabase.MoveToAncestor(1u);
   }
+  if (ok && cycle_budget > 0u) {
+    // loops can be bounded by the length of the array signals (`#x`)
+    LUA::Verifier::sizes_map_t sizes(numberOfInputSignals +
+                                     numberOfOutputSignals);
+    for (uint32 i = 0; inputs_sig_names && i < numberOfInputSignals; i++) {
+      sizes.set(StrView(inputs_sig_names[i]), inputs_sizes[i]);
+    }
+    for (uint32 i = 0; outputs_sig_names && i < numberOfOutputSignals; i++) {
+      sizes.set(StrView(outputs_sig_names[i]), outputs_sizes[i]);
+    }
+    ok &= validator.check_cycle_budget(cycle_budget, &sizes);
+  }
   // if (ok) {
   //   const char **variable_names = new const char
   //       *[numberOfInternals + numberOfInputSignals + numberOfOutputSignals];
@@ -1164,5 +1220,40 @@ bool LuaGAM::init_auxiliaries(StructuredDataI &data) {
   return ok;
 }
 
+bool LuaGAM::optimise_code(StructuredDataI &data, Str &optimised) {
+  bool ok = true;
+  LUA::Optimiser::LuaGAMOptimiser optimiser(code, ok);
+  if (ok && data.MoveRelative("AuxiliaryFunctions")) {
+    for (uint32 i = 0u; (i < data.GetNumberOfChildren()) && ok; i++) {
+      StreamString fun;
+      ok = data.Read(data.GetChildName(i), fun);
+      ok = ok && optimiser.add_code(fun.Buffer());
+    }
+    ok &= data.MoveToAncestor(1u);
+  }
+  if (ok && data.MoveRelative("InternalStates")) {
+    for (uint32 i = 0u; (i < data.GetNumberOfChildren()) && ok; i++) {
+      StreamString value;
+      const char8 *name = data.GetChildName(i);
+      ok = data.Read(name, value);
+      if (ok) {
+        // non literal values are simply not folded
+        optimiser.add_constant(name, value.Buffer());
+      }
+    }
+    ok &= data.MoveToAncestor(1u);
+  }
+  if (ok) {
+    optimised = optimiser.optimise();
+    REPORT_ERROR(ErrorManagement::Information,
+                 "%u constants folded, %u branches eliminated",
+                 optimiser.folded(), optimiser.eliminated());
+  } else {
+    REPORT_ERROR(ErrorManagement::Warning,
+                 "Code optimisation failed, the original code is used");
+  }
+  return ok;
+}
+
 CLASS_REGISTER(LuaGAM, "1.0")
 } /* namespace MARTe */
@@ -49,6 +49,10 @@
 
 namespace MARTe {
 
+namespace LUA {
+struct parse_job_t;
+}
+
 typedef bool (*push_signal)(lua_State *, const char8 *, void *, uint32);
 typedef bool (*get_signal)(lua_State *, const char8 *, void *, uint32);
 
@@ -56,6 +60,9 @@ typedef bool (*get_signal)(lua_State *, const char8 *, void *, uint32);
  * {
  *   Class: "LuaGAM"
  *   Code: string
+ *   CycleBudget: uint64 (optional)
+ *   Optimise: uint8 (optional)
+ *   ParallelParsing: uint8 (optional)
  *   InputSignals: {
  *      ...
  *   }
@@ -120,6 +127,9 @@ private:
   char8 *file_path; //!< file path of code
   LUA::ast_t ast;        //!< Code AST
   lua_State *L;     //!< lua state
+  uint64 cycle_budget; //!< maximum estimated cost of `GAM()` (0 = no limit)
+  uint8 optimise;      //!< fold constant internal states before loading
+  LUA::parse_job_t *parse_job; //!< pending parallel parsing (if any)
 
   push_signal *inputs_functions; //!< Array of functions pushing the GAM input
                                  //!< signals in the Lua stack
@@ -165,6 +175,15 @@ private:
    * @return true if correct initialization
    */
   bool init_auxiliaries(StructuredDataI &data);
+
+  /**
+   * @brief Fold the internal states never assigned by the code and remove
+   * the dead branches of `GAM()`
+   * @param[in] data GAM StructuredDataI
+   * @param[out] optimised simplified Lua code
+   * @return true if the code has been optimised
+   */
+  bool optimise_code(StructuredDataI &data, Str &optimised);
 };
 
 } // namespace MARTe
@@ -33,13 +33,17 @@
 
 #include "AdvancedErrorManagement.h"
 #include "Architecture/x86_gcc/CompilerTypes.h"
+#include "Arena.h"
 #include "LuaParser.h"
+#include "StrBuilder.h"
 #include "StringHelper.h"
 
 /*---------------------------------------------------------------------------*/
 /*                           Static definitions                              */
 /*---------------------------------------------------------------------------*/
 
+#define SCAN_ARENA_CHUNK_SIZE 65536u
+
 /*---------------------------------------------------------------------------*/
 /*                           Method definitions                              */
 /*---------------------------------------------------------------------------*/
@@ -306,22 +310,22 @@ bool check_variable(Nodep node, const char8 *name, LuaNode node_type,
                     uint32 &line_i, uint32 &col_i) {
   bool found = false;
   if (node->type == node_type) {
-    for (Rc<NodepList::iterator> it = node->sub_nodes.iterate(); it && !found;
-         it = it->next()) {
-      for (Rc<NodepList::iterator> jt = it->value()->sub_nodes.iterate();
-           jt && !found; jt = jt->next()) {
-        if (!jt->value()->tok.isNull() && jt->value()->tok->raw == name) {
+    for (NodepList::iterator it = node->sub_nodes.begin();
+         it != node->sub_nodes.end() && !found; ++it) {
+      for (NodepList::iterator jt = it.value()->sub_nodes.begin();
+           jt != it.value()->sub_nodes.end() && !found; ++jt) {
+        if (!jt.value()->tok.isNull() && jt.value()->tok->raw == name) {
           found = true;
-          line_i = jt->value()->tok->row;
-          col_i = jt->value()->tok->col;
+          line_i = jt.value()->tok->row;
+          col_i = jt.value()->tok->col;
         }
       }
     }
   }
   if (!found) {
-    for (Rc<NodepList::iterator> it = node->sub_nodes.iterate(); it;
-         it = it->next()) {
-      if (check_variable(it->value(), name, node_type, line_i, col_i)) {
+    for (NodepList::iterator it = node->sub_nodes.begin();
+         it != node->sub_nodes.end(); ++it) {
+      if (check_variable(it.value(), name, node_type, line_i, col_i)) {
         found = true;
         break;
       }
@@ -333,24 +337,25 @@ bool check_variable(Nodep node, const char8 *name, LuaNode node_type,
 /**
  * @brief Divide Lua code in lines.
  * @param[in] code Lua code
- * @param[out] ok flag for correct linearization
+ * @param[in] allocator source of the memory of the lines
  * @return list of lines.
  */
-strList linearize(const char8 *code) {
-  strList lines;
-  Str code_s = code;
-  uint32 code_pos = 0;
-  code_s = code_s + '\n';
-  Option<uint32> maybe_eol_i = code_s.find("\n");
-  while (!maybe_eol_i.empty()) {
-    uint32 eol_i = maybe_eol_i.val();
-    uint32 nl = eol_i == 0 ? (eol_i + 1) : eol_i;
-    Str line = code_s.substr(0, nl);
-    if (line.len() > 0) {
-      lines.append(line);
+strList linearize(const char8 *code, Allocator *allocator) {
+  strList lines(16u, allocator);
+  StrView code_s = code;
+  uint32 line_start = 0;
+  // the code is implicitly terminated by a new line
+  while (line_start <= code_s.len()) {
+    Option<uint32> maybe_eol_i = code_s.find('\n', line_start);
+    uint32 eol_i = maybe_eol_i.empty() ? code_s.len() : maybe_eol_i.val();
+    if (eol_i == line_start) {
+      // empty lines are kept as a single new line
+      lines.append(Str("\n", 1u, allocator));
+    } else {
+      lines.append(
+          Str(code_s.data() + line_start, eol_i - line_start, allocator));
     }
-    code_s = code_s.substr(eol_i + 1, 0);
-    maybe_eol_i = code_s.find("\n");
+    line_start = eol_i + 1;
   }
   return lines;
 }
@@ -364,7 +369,7 @@ strList linearize(const char8 *code) {
  * @param[in] is_string expected string flag
  * @param[in] ok flag for correct tokenization
  */
-Tokenp get_long_bracket_token(strList code_lines, uint32 &line_index,
+Tokenp get_long_bracket_token(const strList &code_lines, uint32 &line_index,
                               uint32 &line_pos, uint32 &char_pos,
                               bool is_string, bool &ok) {
   Tokenp t;
@@ -374,54 +379,65 @@ Tokenp get_long_bracket_token(strList code_lines, uint32 &line_index,
   if (!is_string) {
     add_tok_len = 3;
   }
-  Str closing_long_bracket = "]";
-  Str long_token = "";
+  StrBuilder closing_long_bracket;
+  closing_long_bracket.append(']');
   uint32 long_bracket_level = 0;
   while (ok) {
+    if (line_pos + char_pos + long_bracket_level + add_tok_len >= line.len()) {
+      // opening bracket truncated by the end of the line
+      ok = false;
+      break;
+    }
     if (line[line_pos + char_pos + long_bracket_level + add_tok_len] == '=') {
       long_bracket_level++;
-      closing_long_bracket = closing_long_bracket + '=';
+      closing_long_bracket.append('=');
     } else {
       if (line[line_pos + char_pos + long_bracket_level + add_tok_len] != '[') {
         ok = false;
       }
-      closing_long_bracket = closing_long_bracket + ']';
+      closing_long_bracket.append(']');
       break;
     }
   }
   if (ok) {
-    Str line_str = line;
+    // the token is accumulated in place (linear in its length)
+    StrBuilder long_token;
+    const StrView closing = closing_long_bracket.view();
+    StrView line_str = line.view();
     uint32 init_line_index = line_index;
-    Option<uint32> end_index = line_str.find(closing_long_bracket);
+    Option<uint32> end_index = line_str.find(closing);
     if (end_index.empty() && line_index + 1 < code_lines.len()) {
-      long_token = long_token + line_str;
+      long_token.append(line_str);
       line_index++;
-      line_str = code_lines[line_index];
-      end_index = line_str.find(closing_long_bracket);
+      line_str = code_lines[line_index].view();
+      end_index = line_str.find(closing);
     }
     while (end_index.empty() && line_index + 1 < code_lines.len()) {
-      long_token = long_token + '\n';
-      long_token = long_token + line_str;
+      long_token.append('\n');
+      long_token.append(line_str);
       line_index++;
-      line_str = code_lines[line_index];
-      end_index = line_str.find(closing_long_bracket);
+      line_str = code_lines[line_index].view();
+      end_index = line_str.find(closing);
     }
-    if (line_index > init_line_index && long_token[-1] != '\n') {
-      long_token = long_token + '\n';
+    if (line_index > init_line_index &&
+        (long_token.len() == 0u || long_token.view()[-1] != '\n')) {
+      long_token.append('\n');
     }
     if (!end_index.empty() && end_index.val() > 0) {
-      long_token = long_token + line_str.substr(0, end_index.val());
+      long_token.append(line_str.substr(0, end_index.val()));
     }
-    long_token = long_token + closing_long_bracket;
-    t = new Token(long_token.cstr(), long_token.len(), init_line_index,
-                  line_pos + char_pos);
+    long_token.append(closing);
+    t = make_rc<Token>(long_token.cstr(), long_token.len(), init_line_index,
+                       line_pos + char_pos);
   }
   line_index++;
   return t;
 }
 
 tokens_t scan(const char8 *code, bool &ok) {
-  strList lines = linearize(code);
+  // the lines are only needed while scanning: released all at once
+  Arena arena(SCAN_ARENA_CHUNK_SIZE);
+  strList lines = linearize(code, &arena);
   tokens_t tokens;
   uint32 line_pos = 0;
   uint32 char_pos = 0;
@@ -441,8 +457,8 @@ tokens_t scan(const char8 *code, bool &ok) {
       if (line[line_pos + char_pos] == ' ' ||
           line[line_pos + char_pos] == '\t') {
         if (char_pos > 0) {
-          tokens.add(line.substr(line_pos, char_pos + line_pos), line_index,
-                     line_pos);
+          tokens.add(line.view().substr(line_pos, char_pos + line_pos),
+                     line_index, line_pos);
           line_pos += char_pos;
           char_pos = 0;
         }
@@ -464,8 +480,9 @@ tokens_t scan(const char8 *code, bool &ok) {
             break;
           }
           if (line[end_string.val() - 1] != '\\') {
-            tokens.add(line.substr(line_pos + char_pos, end_string.val() + 1),
-                       line_index, line_pos + char_pos);
+            tokens.add(
+                line.view().substr(line_pos + char_pos, end_string.val() + 1),
+                line_index, line_pos + char_pos);
             line_pos = end_string.val() + 1;
             char_pos = 0;
             break;
@@ -473,7 +490,7 @@ tokens_t scan(const char8 *code, bool &ok) {
             closing_quotes_index = end_string.val();
           }
         }
-      } else if (line.substr(line_pos + char_pos, 0).len() > 2 &&
+      } else if (line.len() - (line_pos + char_pos) > 2 &&
                  line[line_pos + char_pos] == '[' &&
                  ((line[line_pos + char_pos + 1] == '[') ||
                   (line[line_pos + char_pos + 1] == '='))) {
@@ -491,10 +508,10 @@ tokens_t scan(const char8 *code, bool &ok) {
       }
 
       // Check for comments -> after --
-      else if (line.substr(line_pos + char_pos, 0).len() >= 2 &&
+      else if (line.len() - (line_pos + char_pos) >= 2 &&
                line[line_pos + char_pos] == '-' &&
                line[line_pos + char_pos + 1] == '-') {
-        if (line.substr(line_pos + char_pos + 1, 0).len() > 2 &&
+        if (line.len() - (line_pos + char_pos + 1) > 2 &&
             line[line_pos + char_pos + 2] == '[' &&
             (line[line_pos + char_pos + 3] == '[' ||
              line[line_pos + char_pos + 3] == '=')) {
@@ -510,21 +527,19 @@ tokens_t scan(const char8 *code, bool &ok) {
                         "Error in long bracket.");
           }
         } else {
-          len_token = line.substr(line_pos + char_pos, line.len()).len();
-          tokens.add(line.substr(line_pos + char_pos, 0), line_index,
+          len_token = line.len() - (line_pos + char_pos);
+          tokens.add(line.view().substr(line_pos + char_pos, 0), line_index,
                      line_pos + char_pos);
           char_pos += len_token + 1;
         }
       }
 
       // Number
-      else if (is_decimal(line.substr(line_pos + char_pos, 0).cstr()) &&
-               char_pos == 0) {
-        if (check_number(line.substr(line_pos + char_pos, 0).cstr(),
-                         len_token)) {
+      else if (is_decimal(line.cstr() + line_pos + char_pos) && char_pos == 0) {
+        if (check_number(line.cstr() + line_pos + char_pos, len_token)) {
           if (len_token > 0) {
-            tokens.add(line.substr(line_pos + char_pos,
-                                   line_pos + char_pos + len_token),
+            tokens.add(line.view().substr(line_pos + char_pos,
+                                          line_pos + char_pos + len_token),
                        line_index, line_pos + char_pos);
           }
         } else {
@@ -535,18 +550,13 @@ tokens_t scan(const char8 *code, bool &ok) {
       }
 
       // Check for Lua tokens
-      else if (is_lua_token(line.substr(line_pos + char_pos, 0).cstr(),
-                            len_token)) {
+      else if (is_lua_token(line.cstr() + line_pos + char_pos, len_token)) {
         if (char_pos == 0) {
-          tokens.add(line.substr(line_pos, line_pos + len_token).cstr(),
-                     line_index, line_pos, len_token);
+          tokens.add(line.cstr() + line_pos, line_index, line_pos, len_token);
         } else {
-          tokens.add(line.substr(line_pos, line_pos + char_pos).cstr(),
-                     line_index, line_pos, char_pos);
-          tokens.add(
-              line.substr(line_pos + char_pos, line_pos + char_pos + len_token)
-                  .cstr(),
-              line_index, line_pos + char_pos, len_token);
+          tokens.add(line.cstr() + line_pos, line_index, line_pos, char_pos);
+          tokens.add(line.cstr() + line_pos + char_pos, line_index,
+                     line_pos + char_pos, len_token);
         }
         line_pos += char_pos + len_token;
         char_pos = 0;
@@ -555,8 +565,8 @@ tokens_t scan(const char8 *code, bool &ok) {
       // End of line
       else if (line_pos + char_pos == line.len() - 1 &&
                line[line_pos + char_pos] != '\n') {
-        len_token = line.substr(line_pos, 0).len();
-        tokens.add(line.substr(line_pos, 0), line_index, line_pos + char_pos);
+        len_token = line.len() - line_pos;
+        tokens.add(line.view().substr(line_pos, 0), line_index, line_pos);
         line_pos += char_pos + len_token;
         char_pos = 0;
       }
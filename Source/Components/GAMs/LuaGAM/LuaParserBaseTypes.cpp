@@ -88,6 +88,7 @@ bool is_binop(uint32 type) {
 Token::Token() {
   raw = NULL_PTR(char8 *);
   type = ID;
+  sym = NO_SYMBOL;
   row = 0;
   col = 0;
   unop = false;
@@ -95,12 +96,12 @@ Token::Token() {
 }
 
 Token::Token(const char8 *str, uint32 len, uint32 row, uint32 col)
-    : raw(str), type(tok_type(str, len)), row(row), col(col),
-      unop(is_unop(type)), binop(is_binop(type)) {}
+    : raw(str, len), type(tok_type(str, len)), sym(NO_SYMBOL), row(row),
+      col(col), unop(is_unop(type)), binop(is_binop(type)) {}
 
 Token::Token(char8 *str, uint32 len, uint32 row, uint32 col)
-    : raw(str), type(tok_type(str, len)), row(row), col(col),
-      unop(is_unop(type)), binop(is_binop(type)) {}
+    : raw(str, len), type(tok_type(str, len)), sym(NO_SYMBOL), row(row),
+      col(col), unop(is_unop(type)), binop(is_binop(type)) {}
 
 Token::~Token() {}
 
@@ -121,18 +122,89 @@ Str Token::toString(bool show_type, bool show_val) {
   return s;
 }
 
-void tokens_t::add(Tokenp t) { toks.append(t); }
+#define SYMBOLS_INIT_SLOTS 64u
 
-void tokens_t::add(Str t, uint32 row, uint32 col) {
-  toks.append(new Token(t.cstr(), t.len(), row, col));
+symbols_t::symbols_t()
+    : slots(new uint32[SYMBOLS_INIT_SLOTS]), n_slots(SYMBOLS_INIT_SLOTS) {
+  memset(slots, 0, n_slots * sizeof(uint32));
+}
+
+symbols_t::~symbols_t() { delete[] slots; }
+
+uint32 symbols_t::slot(const char8 *str, const uint32 len,
+                       const uint32 hash) const {
+  uint32 i = hash & (n_slots - 1u);
+  while (slots[i] != 0u) {
+    const uint32 sym = slots[i] - 1u;
+    if (hashes[sym] == hash && names[sym].len() == len &&
+        memcmp(names[sym].cstr(), str, len) == 0) {
+      break;
+    }
+    i = (i + 1u) & (n_slots - 1u);
+  }
+  return i;
+}
+
+void symbols_t::grow() {
+  delete[] slots;
+  n_slots *= 2u;
+  slots = new uint32[n_slots];
+  memset(slots, 0, n_slots * sizeof(uint32));
+  for (uint32 sym = 0u; sym < names.len(); sym++) {
+    uint32 i = hashes[sym] & (n_slots - 1u);
+    while (slots[i] != 0u) {
+      i = (i + 1u) & (n_slots - 1u);
+    }
+    slots[i] = sym + 1u;
+  }
+}
+
+uint32 symbols_t::intern(const char8 *str, const uint32 len) {
+  const uint32 hash = StrView(str, len).hash();
+  uint32 i = slot(str, len, hash);
+  if (slots[i] == 0u) {
+    // keep the load factor below 1/2
+    if (2u * (names.len() + 1u) > n_slots) {
+      grow();
+      i = slot(str, len, hash);
+    }
+    names.append(Str(str, len));
+    hashes.append(hash);
+    slots[i] = names.len();
+  }
+  return slots[i] - 1u;
+}
+
+bool symbols_t::find(const char8 *str, uint32 &sym) const {
+  const uint32 len = StringHelper::Length(str);
+  const uint32 i = slot(str, len, StrView(str, len).hash());
+  sym = slots[i] == 0u ? NO_SYMBOL : slots[i] - 1u;
+  return slots[i] != 0u;
+}
+
+const Str &symbols_t::name(const uint32 sym) const { return names[sym]; }
+
+uint32 symbols_t::len() const { return names.len(); }
+
+tokens_t::tokens_t() : symbols(make_rc<symbols_t>()) {}
+
+void tokens_t::add(Tokenp t) {
+  if (!t.isNull() && t->type == ID && t->sym == NO_SYMBOL) {
+    t->sym = symbols->intern(t->raw.cstr(), t->raw.len());
+  }
+  toks.append(t);
+}
+
+void tokens_t::add(const StrView &t, uint32 row, uint32 col) {
+  add(make_rc<Token>(t.data(), t.len(), row, col));
 }
 
 void tokens_t::add(const char8 *t, uint32 row, uint32 col, uint32 len) {
-  toks.append(new Token(t, len, row, col));
+  add(make_rc<Token>(t, len, row, col));
 }
 
 void tokens_t::add(char8 *t, uint32 row, uint32 col, uint32 len) {
-  toks.append(new Token(t, len, row, col));
+  add(make_rc<Token>(t, len, row, col));
 }
 
 void tokens_t::add_long_bracket_token(strList code_lines, uint32 &line_index,
@@ -189,11 +261,11 @@ void tokens_t::add_long_bracket_token(strList code_lines, uint32 &line_index,
   line_index++;
 }
 
-uint32 tokens_t::len() { return toks.len(); }
+uint32 tokens_t::len() const { return toks.len(); }
 
 void tokens_t::print() {
-  for (Rc<TokenpList::iterator>it = toks.iterate(); it; it = it->next()) {
-    printf("%s\n", it->value()->toString().cstr());
+  for (TokenpList::iterator it = toks.begin(); it != toks.end(); ++it) {
+    printf("%s\n", it.value()->toString().cstr());
   }
 }
 
@@ -219,7 +291,7 @@ void Node::append(Nodep n) {
 
 void Node::append(Tokenp tok_, LuaNode type_) {
   if (!tok_.isNull()) {
-    sub_nodes.append(new Node(type_, tok_));
+    sub_nodes.append(make_rc<Node>(type_, tok_));
   }
 }
 
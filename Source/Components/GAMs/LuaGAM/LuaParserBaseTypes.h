@@ -3,6 +3,7 @@
 
 #include "CompilerTypes.h"
 #include "Rc.h"
+#include "SmallVec.h"
 #include "Str.h"
 #include "Vec.h"
 
@@ -10,6 +11,10 @@
 #define NUM_LUA_SYNTAX_ELEMENTS 63
 #define NUM_UNOP 4
 #define NUM_BINOP 21
+/**
+ * @brief Children of a node stored without heap allocation
+ */
+#define NODE_INLINE_CHILDREN 3u
 
 namespace MARTe {
 namespace LUA {
@@ -198,6 +203,71 @@ const MARTe::char8 lua_node_names[][32] = {
     "COMMENT",
 };
 
+/**
+ * @brief Symbol of tokens that are not identifiers
+ */
+#define NO_SYMBOL 0xFFFFFFFFu
+
+/**
+ * @brief Table of the identifiers of a Lua code.
+ *
+ * Every distinct identifier is stored once, together with its hash, and is
+ * referred by an integer symbol: tokens with the same name share the same
+ * symbol, so names can be compared as integers.
+ */
+struct symbols_t {
+
+  /**
+   * @brief Empty table
+   */
+  symbols_t();
+
+  /**
+   * @brief Destructor
+   */
+  ~symbols_t();
+
+  /**
+   * @brief Get the symbol of a name, adding it if not present
+   * @param[in] str name
+   * @param[in] len name length
+   * @return symbol of the name
+   */
+  uint32 intern(const char8 *str, uint32 len);
+
+  /**
+   * @brief Look for the symbol of a name, without adding it
+   * @param[in] str name (null terminated)
+   * @param[out] sym symbol of the name, NO_SYMBOL if not found
+   * @return true if the name is present in the table
+   */
+  bool find(const char8 *str, uint32 &sym) const;
+
+  /**
+   * @brief Get the name of a symbol
+   * @param[in] sym symbol
+   * @return name of the symbol
+   */
+  const Str &name(uint32 sym) const;
+
+  /**
+   * @brief Number of distinct names
+   */
+  uint32 len() const;
+
+private:
+  symbols_t(const symbols_t &);
+  symbols_t &operator=(const symbols_t &);
+
+  uint32 slot(const char8 *str, uint32 len, uint32 hash) const;
+  void grow();
+
+  Vec<Str> names;     //!< names by symbol
+  Vec<uint32> hashes; //!< hashes by symbol
+  uint32 *slots;      //!< open addressing table (symbol + 1, 0 if empty)
+  uint32 n_slots;     //!< size of the table (power of 2)
+};
+
 /**
  * @brief Simple token class
  */
@@ -234,6 +304,7 @@ struct Token {
 
   Str raw;     //!< Token name
   uint32 type; //!< Token type
+  uint32 sym;  //!< Interned identifier (NO_SYMBOL if not an identifier)
   uint32 row;  //!< Row number of the token in the lua code
   uint32 col;  //!< Column number of the token in the lua code
   bool unop;   //!< flag to design unary operators
@@ -244,6 +315,11 @@ typedef Rc<Token> Tokenp;
 typedef Vec<Tokenp> TokenpList;
 struct tokens_t {
 
+  /**
+   * @brief Empty token list with a new symbol table
+   */
+  tokens_t();
+
   /**
    * @brief Add token to list
    * @param[in] t token
@@ -252,11 +328,11 @@ struct tokens_t {
 
   /**
    * @brief Add token to list
-   * @param[in] t token name
+   * @param[in] t token name (slice of the code)
    * @param[in] row row in code
    * @param[in] col column in code
    */
-  void add(Str t, uint32 row, uint32 col);
+  void add(const StrView &t, uint32 row, uint32 col);
 
   /**
    * @brief Add token to list
@@ -287,7 +363,7 @@ struct tokens_t {
    * @brief Get token list len
    * @return token list len
    */
-  uint32 len();
+  uint32 len() const;
 
   /**
    * @brief Print tokens
@@ -309,6 +385,11 @@ struct tokens_t {
    */
   TokenpList toks;
 
+  /**
+   * Identifiers of the tokens
+   */
+  Rc<symbols_t> symbols;
+
 };
 
 /**
@@ -368,9 +449,9 @@ public:
    */
   void del();
 
-  Tokenp tok;           //!< Token linked to this node
-  LuaNode type;         //!< Node type
-  Vec<Nodep> sub_nodes; //!< List of children nodes
+  Tokenp tok;   //!< Token linked to this node
+  LuaNode type; //!< Node type
+  SmallVec<Nodep, NODE_INLINE_CHILDREN> sub_nodes; //!< Children nodes
 };
 
 typedef Rc<Node> Nodep;
@@ -0,0 +1,500 @@
+#include "Optimiser.h"
+#include "AST.h"
+#include "AdvancedErrorManagement.h"
+#include "LuaParser.h"
+#include "LuaParserBaseTypes.h"
+#include "Verifier.h"
+
+#include <stdlib.h>
+
+namespace MARTe {
+namespace LUA {
+namespace Optimiser {
+
+/**
+ * @brief Truthiness of a constant following Lua semantics
+ */
+bool truthy(const const_t &value) {
+  return value.type != NIL && value.type != FALSE;
+}
+
+/**
+ * @brief Make a boolean constant
+ */
+const_t boolean(const bool value) {
+  const_t c;
+  c.type = value ? TRUE : FALSE;
+  c.number = 0.0;
+  c.text = value ? "true" : "false";
+  return c;
+}
+
+/**
+ * @brief Collect the names assigned or declared in a node and its subnodes.
+ * @param[in] node node to inspect
+ * @param[out] names list of names found
+ */
+void collect_assigned(Nodep node, strList &names) {
+  if (!node) {
+    return;
+  }
+  const uint32 n = node->sub_nodes.len();
+  if (node->type == VARLIST) {
+    for (uint32 i = 0u; i < n; i++) {
+      Nodep var = node->sub_nodes[i];
+      if (var->sub_nodes.len() > 0u && !var->sub_nodes[0]->tok.isNull()) {
+        names.append(var->sub_nodes[0]->tok->raw);
+      }
+    }
+  } else if (node->type == NAMELIST || node->type == ATTNAMELIST) {
+    for (uint32 i = 0u; i < n; i++) {
+      if (node->sub_nodes[i]->type == NAME) {
+        names.append(node->sub_nodes[i]->tok->raw);
+      }
+    }
+  } else if (node->type == FUNCNAME) {
+    names.append(node->tok->raw);
+  } else if (node->type == LOCALSTAT && n > 1u &&
+             node->sub_nodes[0]->type == LOCALFUNCTION) {
+    names.append(node->sub_nodes[1]->tok->raw);
+  } else if (node->type == STAT && !node->tok.isNull() &&
+             node->tok->type == FOR && n > 0u &&
+             node->sub_nodes[0]->type == NAME) {
+    names.append(node->sub_nodes[0]->tok->raw);
+  }
+  for (uint32 i = 0u; i < n; i++) {
+    collect_assigned(node->sub_nodes[i], names);
+  }
+}
+
+void collect_assigned(const ast_t &ast, strList &names) {
+  for (uint32 i = 0u; i < ast.nodes.len(); i++) {
+    collect_assigned(ast[i], names);
+  }
+}
+
+/**
+ * @brief Count the new lines in a portion of a string
+ */
+uint32 count_lines(const Str &str, const uint32 start, const uint32 end) {
+  uint32 n = 0u;
+  for (uint32 i = start; i < end; i++) {
+    if (str[i] == '\n') {
+      n++;
+    }
+  }
+  return n;
+}
+
+/**
+ * @brief Append a portion of the source to a string
+ */
+void append(Str &out, const Str &source, const uint32 start, const uint32 end) {
+  if (end > start) {
+    out = out + source.substr(start, end);
+  }
+}
+
+LuaGAMOptimiser::LuaGAMOptimiser(const char8 *code, bool &ok)
+    : source(code), folded_(0u), eliminated_(0u) {
+  bool ret = true;
+  tokens = scan(code, ret);
+  if (ret) {
+    ast = generate_ast(tokens, ret);
+  }
+  if (ret) {
+    collect_assigned(ast, assigned);
+    lines.append(0u);
+    for (uint32 i = 0u; i < source.len(); i++) {
+      if (source[i] == '\n') {
+        lines.append(i + 1u);
+      }
+    }
+  }
+  ok &= ret;
+}
+
+bool LuaGAMOptimiser::add_constant(const char8 *name, const char8 *value) {
+  bool ok = true;
+  tokens_t toks = scan(value, ok);
+  const_t c;
+  c.number = 0.0;
+  // the last token is always `endcode`
+  const uint32 n = ok ? toks.len() - 1u : 0u;
+  uint32 i = 0u;
+  bool negative = false;
+  if (n == 2u && toks[0]->type == MINUS) {
+    negative = true;
+    i = 1u;
+  } else {
+    ok = n == 1u;
+  }
+  if (ok) {
+    c.type = toks[i]->type;
+    c.text = toks[i]->raw;
+    ok = c.type == NIL || c.type == TRUE || c.type == FALSE ||
+         c.type == NUM || c.type == STRING;
+    ok = ok && (!negative || c.type == NUM);
+  }
+  if (ok && c.type == NUM) {
+    char8 *end = NULL_PTR(char8 *);
+    c.number = strtod(c.text.cstr(), &end);
+    ok = end != NULL_PTR(char8 *) && *end == '\0';
+    if (negative) {
+      c.number = -c.number;
+      // parenthesis avoid creating a comment after a unary minus
+      c.text = Str("(-") + c.text + ")";
+    }
+  }
+  if (ok && c.type == STRING) {
+    // long strings and escapes are kept at runtime
+    ok = c.text.find('\n').empty() && c.text.find('\\').empty();
+  }
+  if (ok) {
+    names.append(name);
+    values.append(c);
+  }
+  return ok;
+}
+
+bool LuaGAMOptimiser::add_code(const char8 *code) {
+  bool ok = true;
+  ast_t code_ast = parse(code, ok);
+  if (ok) {
+    collect_assigned(code_ast, assigned);
+  }
+  return ok;
+}
+
+uint32 LuaGAMOptimiser::folded() const { return folded_; }
+
+uint32 LuaGAMOptimiser::eliminated() const { return eliminated_; }
+
+bool LuaGAMOptimiser::is_assigned(const Str &name) const {
+  bool found = false;
+  for (uint32 i = 0u; i < assigned.len() && !found; i++) {
+    found = assigned[i] == name;
+  }
+  return found;
+}
+
+bool LuaGAMOptimiser::constant(const Str &name, const_t &value) const {
+  bool found = false;
+  for (uint32 i = 0u; i < names.len() && !found; i++) {
+    if (names[i] == name) {
+      found = !is_assigned(name);
+      value = values[i];
+    }
+  }
+  return found;
+}
+
+bool LuaGAMOptimiser::eval_operand(Nodep node, const_t &value) const {
+  bool ok = false;
+  value.number = 0.0;
+  if (node->type == VALUE && node->tok->type != VARARGS) {
+    value.type = node->tok->type;
+    value.text = node->tok->raw;
+    ok = true;
+  } else if (node->type == NUMERAL) {
+    char8 *end = NULL_PTR(char8 *);
+    value.type = NUM;
+    value.text = node->tok->raw;
+    value.number = strtod(node->tok->raw.cstr(), &end);
+    ok = end != NULL_PTR(char8 *) && *end == '\0';
+  } else if (node->type == LITERALSTRING) {
+    value.type = STRING;
+    value.text = node->tok->raw;
+    ok = true;
+  } else if (node->type == VAR && node->sub_nodes.len() == 1u &&
+             node->sub_nodes[0]->type == NAME) {
+    ok = constant(node->sub_nodes[0]->tok->raw, value);
+  } else if (node->type == EXP) {
+    ok = eval(node, value);
+  }
+  return ok;
+}
+
+bool LuaGAMOptimiser::eval(Nodep exp, const_t &value) const {
+  // Only `[unop] operand [binop [unop] operand]` expressions are evaluated,
+  // longer ones would need operator precedence.
+  const_t operands[2];
+  uint32 binop = ENDCODE;
+  uint32 count = 0u;
+  bool ok = exp && exp->type == EXP;
+  uint32 i = 0u;
+  while (ok && i < exp->sub_nodes.len()) {
+    uint32 unop = ENDCODE;
+    if (exp->sub_nodes[i]->type == UNOP) {
+      unop = exp->sub_nodes[i]->tok->type;
+      i++;
+    }
+    ok = count < 2u && i < exp->sub_nodes.len() &&
+         eval_operand(exp->sub_nodes[i], operands[count]);
+    if (ok && unop == NOT) {
+      operands[count] = boolean(!truthy(operands[count]));
+    } else if (ok && unop == MINUS) {
+      ok = operands[count].type == NUM;
+      operands[count].number = -operands[count].number;
+    } else if (ok && unop != ENDCODE) {
+      ok = false;
+    }
+    i++;
+    count++;
+    if (ok && i < exp->sub_nodes.len()) {
+      ok = count == 1u && exp->sub_nodes[i]->type == BINOP;
+      if (ok) {
+        binop = exp->sub_nodes[i]->tok->type;
+        i++;
+      }
+    }
+  }
+  ok = ok && count > 0u && (binop == ENDCODE) == (count == 1u);
+  if (ok && count == 1u) {
+    value = operands[0];
+  } else if (ok) {
+    const const_t &a = operands[0];
+    const const_t &b = operands[1];
+    const bool numbers = a.type == NUM && b.type == NUM;
+    switch (binop) {
+    case AND:
+      value = truthy(a) ? b : a;
+      break;
+    case OR:
+      value = truthy(a) ? a : b;
+      break;
+    case EQ:
+    case NEQ:
+      if (numbers) {
+        value = boolean((a.number == b.number) == (binop == EQ));
+      } else if (a.type == STRING && b.type == STRING && !(a.text == b.text)) {
+        // different quoting may represent the same string
+        ok = false;
+      } else {
+        bool same = (a.type == b.type) && (a.type != STRING || a.text == b.text);
+        value = boolean(same == (binop == EQ));
+      }
+      break;
+    case LT:
+      ok = numbers;
+      value = boolean(a.number < b.number);
+      break;
+    case GT:
+      ok = numbers;
+      value = boolean(a.number > b.number);
+      break;
+    case LTEQ:
+      ok = numbers;
+      value = boolean(a.number <= b.number);
+      break;
+    case GTEQ:
+      ok = numbers;
+      value = boolean(a.number >= b.number);
+      break;
+    default:
+      ok = false;
+    }
+  }
+  return ok;
+}
+
+uint32 LuaGAMOptimiser::token_index(const Tokenp &tok) const {
+  uint32 lo = 0u;
+  uint32 hi = tokens.len();
+  while (lo < hi) {
+    uint32 mid = (lo + hi) / 2u;
+    const Tokenp &t = tokens[mid];
+    if (t->row < tok->row || (t->row == tok->row && t->col < tok->col)) {
+      lo = mid + 1u;
+    } else {
+      hi = mid;
+    }
+  }
+  return lo;
+}
+
+uint32 LuaGAMOptimiser::offset(const Tokenp &tok) const {
+  uint32 off = source.len();
+  if (tok->row < lines.len()) {
+    off = lines[tok->row] + tok->col;
+  }
+  return off < source.len() ? off : source.len();
+}
+
+void LuaGAMOptimiser::visit(Nodep node, const LuaNode parent) {
+  if (!node) {
+    return;
+  }
+  const_t value;
+  if (node->type == STAT && !node->tok.isNull() && node->tok->type == IF) {
+    visit_if(node);
+    return;
+  }
+  if (parent == EXP && node->type == VAR &&
+             node->sub_nodes.len() == 1u && node->sub_nodes[0]->type == NAME &&
+             constant(node->sub_nodes[0]->tok->raw, value)) {
+    edit_t edit;
+    edit.span.start = offset(node->sub_nodes[0]->tok);
+    edit.span.end = edit.span.start + node->sub_nodes[0]->tok->raw.len();
+    edit.span.valid = true;
+    edit.text = value.text;
+    edit.branch = false;
+    edits.append(edit);
+  }
+  for (uint32 i = 0u; i < node->sub_nodes.len(); i++) {
+    visit(node->sub_nodes[i], node->type);
+  }
+}
+
+void LuaGAMOptimiser::visit_if(Nodep stat) {
+  // AST branches: EXP BLOCK [STAT(elseif) EXP BLOCK]* [STAT(else) BLOCK]
+  Vec<Nodep> conds;
+  conds.append(stat->sub_nodes.len() > 0u ? stat->sub_nodes[0] : Nodep());
+  for (uint32 i = 2u; i < stat->sub_nodes.len(); i++) {
+    Nodep sub = stat->sub_nodes[i];
+    conds.append(sub->tok->type == ELSEIF && sub->sub_nodes.len() > 0u
+                     ? sub->sub_nodes[0]
+                     : Nodep());
+  }
+  // Token branches: keyword, `then` and closing keyword at depth 0
+  Vec<uint32> keywords;
+  Vec<uint32> thens;
+  uint32 depth = 0u;
+  uint32 last = tokens.len();
+  keywords.append(token_index(stat->tok));
+  thens.append(last);
+  for (uint32 i = keywords[0] + 1u; i < tokens.len() && last == tokens.len();
+       i++) {
+    const uint32 type = tokens[i]->type;
+    if (type == IF || type == FUNCTION || type == DO || type == REPEAT) {
+      depth++;
+    } else if (type == END || type == UNTIL || type == ENDCODE) {
+      if (depth == 0u) {
+        last = i;
+      } else {
+        depth--;
+      }
+    } else if (depth == 0u && type == THEN) {
+      thens[thens.len() - 1u] = i;
+    } else if (depth == 0u && (type == ELSEIF || type == ELSE)) {
+      keywords.append(i);
+      thens.append(type == ELSE ? i : tokens.len());
+    }
+  }
+  bool ok = last < tokens.len() && tokens[last]->type == END &&
+            keywords.len() == conds.len();
+  for (uint32 i = 0u; i < thens.len() && ok; i++) {
+    ok = thens[i] < tokens.len();
+  }
+
+  edit_t edit;
+  edit.branch = true;
+  bool changed = false;
+  bool closed = false;
+  for (uint32 i = 0u; i < keywords.len() && ok && !closed; i++) {
+    const_t value;
+    const bool is_else = !conds[i];
+    const bool known = is_else || eval(conds[i], value);
+    if (known && !is_else && !truthy(value)) {
+      changed = true;
+      eliminated_++;
+      continue;
+    }
+    span_t cond;
+    cond.valid = !known;
+    cond.start = offset(tokens[keywords[i]]) + tokens[keywords[i]]->raw.len();
+    cond.end = offset(tokens[thens[i]]);
+    span_t block;
+    block.valid = true;
+    block.start = offset(tokens[thens[i]]) + tokens[thens[i]]->raw.len();
+    block.end = offset(tokens[i + 1u < keywords.len() ? keywords[i + 1u]
+                                                      : last]);
+    edit.conds.append(cond);
+    edit.blocks.append(block);
+    if (known) {
+      // all the following branches are unreachable
+      closed = true;
+      changed = changed || !is_else;
+      eliminated_ += keywords.len() - i - 1u;
+    }
+  }
+  if (ok && changed) {
+    edit.span.start = offset(stat->tok);
+    edit.span.end = offset(tokens[last]) + tokens[last]->raw.len();
+    edit.span.valid = true;
+    edits.append(edit);
+  }
+  for (uint32 i = 0u; i < stat->sub_nodes.len(); i++) {
+    visit(stat->sub_nodes[i], STAT);
+  }
+}
+
+void LuaGAMOptimiser::render(const edit_t &edit, Str &out) {
+  Str text;
+  if (!edit.branch) {
+    text = edit.text;
+    folded_++;
+  } else if (edit.blocks.len() > 0u && !edit.conds[0].valid) {
+    // the first reachable branch is always taken
+    text = "do";
+    emit(edit.blocks[0].start, edit.blocks[0].end, text);
+    text = text + "end";
+  } else if (edit.blocks.len() > 0u) {
+    for (uint32 i = 0u; i < edit.blocks.len(); i++) {
+      if (edit.conds[i].valid) {
+        text = text + (i == 0u ? "if" : "elseif");
+        emit(edit.conds[i].start, edit.conds[i].end, text);
+        text = text + "then";
+      } else {
+        text = text + "else";
+      }
+      emit(edit.blocks[i].start, edit.blocks[i].end, text);
+    }
+    text = text + "end";
+  }
+  // keep the line numbers of the following code unchanged
+  uint32 removed = count_lines(source, edit.span.start, edit.span.end);
+  uint32 kept = count_lines(text, 0u, text.len());
+  for (uint32 i = kept; i < removed; i++) {
+    text += '\n';
+  }
+  out = out + text;
+}
+
+void LuaGAMOptimiser::emit(const uint32 start, const uint32 end, Str &out) {
+  uint32 pos = start;
+  for (uint32 i = 0u; i < edits.len(); i++) {
+    const edit_t &edit = edits[i];
+    if (edit.span.start >= pos && edit.span.end <= end) {
+      append(out, source, pos, edit.span.start);
+      render(edit, out);
+      pos = edit.span.end;
+    }
+  }
+  append(out, source, pos, end);
+}
+
+Str LuaGAMOptimiser::optimise() {
+  edits.clear();
+  folded_ = 0u;
+  eliminated_ = 0u;
+  // only the body of `GAM()` runs after the constants are initialised
+  for (uint32 i = 0u; i < ast.nodes.len(); i++) {
+    for (uint32 j = 0u; j < ast[i]->sub_nodes.len(); j++) {
+      Nodep stat = ast[i]->sub_nodes[j];
+      if (stat->type == STAT && stat->sub_nodes.len() == 2u &&
+          stat->sub_nodes[0]->type == FUNCNAME &&
+          stat->sub_nodes[0]->sub_nodes.len() == 0u &&
+          stat->sub_nodes[0]->tok->raw == GAM_FN) {
+        visit(stat->sub_nodes[1], FUNCBODY);
+      }
+    }
+  }
+  Str out;
+  emit(0u, source.len(), out);
+  return out;
+}
+
+} // namespace Optimiser
+} // namespace LUA
+} // namespace MARTe
@@ -0,0 +1,121 @@
+#ifndef _LUAGAM_OPTIMISER_H__
+#define _LUAGAM_OPTIMISER_H__
+
+#include "AST.h"
+#include "LuaParserBaseTypes.h"
+
+namespace MARTe {
+
+namespace LUA {
+namespace Optimiser {
+
+/**
+ * @brief Compile time value of a constant
+ **/
+struct const_t {
+  uint32 type;    //!< token type: NIL, TRUE, FALSE, NUM or STRING
+  float64 number; //!< numeric value (if `type == NUM`)
+  Str text;       //!< Lua source of the value
+};
+
+/**
+ * @brief Source span of a piece of code
+ **/
+struct span_t {
+  uint32 start; //!< offset of the first character
+  uint32 end;   //!< offset after the last character
+  bool valid;   //!< false if the span is missing (e.g. `else` condition)
+};
+
+/**
+ * @brief Rewrite of a portion of the source code
+ **/
+struct edit_t {
+  span_t span;        //!< replaced code
+  Str text;           //!< replacement text (constant substitution)
+  bool branch;        //!< true if the edit is a simplified `if` statement
+  Vec<span_t> conds;  //!< conditions of the kept branches
+  Vec<span_t> blocks; //!< blocks of the kept branches
+};
+
+/**
+ * @brief Constant folding and dead branch elimination of the `GAM()` code.
+ *
+ * Global variables that are never assigned in the loaded code (e.g.
+ * `InternalStates` used as configuration flags) are replaced by their
+ * literal value inside `GAM()`, and `if` branches whose condition becomes
+ * constant are removed. The simplified code is generated by rewriting the
+ * original source, so that formatting and line numbers are preserved.
+ **/
+class LuaGAMOptimiser {
+public:
+  /**
+   * @brief Parse the code to optimise.
+   * @param[in] code Lua code containing the `GAM()` function
+   * @param[out] ok false if the code cannot be parsed
+   **/
+  LuaGAMOptimiser(const char8 *code, bool &ok);
+
+  /**
+   * @brief Declare a global variable initialised once, before the first
+   * `GAM()` call.
+   * @param[in] name of the variable
+   * @param[in] value Lua code of the initial value
+   * @return true if the value is a literal and can be folded
+   **/
+  bool add_constant(const char8 *name, const char8 *value);
+
+  /**
+   * @brief Declare additional code loaded in the same Lua state (e.g.
+   * auxiliary functions): variables assigned there are not constants.
+   * @param[in] code Lua code
+   * @return true if the code can be parsed
+   **/
+  bool add_code(const char8 *code);
+
+  /**
+   * @brief Generate the simplified code.
+   * @return the optimised Lua code
+   **/
+  Str optimise();
+
+  /**
+   * @brief Number of constant references replaced by `optimise()` in the
+   * generated code.
+   **/
+  uint32 folded() const;
+
+  /**
+   * @brief Number of branches removed by `optimise()`.
+   **/
+  uint32 eliminated() const;
+
+private:
+  bool is_assigned(const Str &name) const;
+  bool constant(const Str &name, const_t &value) const;
+  bool eval(Nodep exp, const_t &value) const;
+  bool eval_operand(Nodep node, const_t &value) const;
+  uint32 token_index(const Tokenp &tok) const;
+  uint32 offset(const Tokenp &tok) const;
+  void visit(Nodep node, const LuaNode parent);
+  void visit_if(Nodep stat);
+  void emit(const uint32 start, const uint32 end, Str &out);
+  void render(const edit_t &edit, Str &out);
+
+  Str source;
+  tokens_t tokens;
+  ast_t ast;
+  Vec<uint32> lines;
+  strList assigned;
+  strList names;
+  Vec<const_t> values;
+  Vec<edit_t> edits;
+  uint32 folded_;
+  uint32 eliminated_;
+};
+
+} // namespace Optimiser
+} // namespace LUA
+} // namespace MARTe
+
+#endif
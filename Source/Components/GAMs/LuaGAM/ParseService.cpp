@@ -0,0 +1,153 @@
+#include "ParseService.h"
+#include "LuaParser.h"
+#include "Verifier.h"
+
+#include <unistd.h>
+
+#define MAX_PARSE_WORKERS 64u
+
+namespace MARTe {
+namespace LUA {
+
+parse_job_t::parse_job_t()
+    : code(NULL_PTR(const char8 *)), only_gam(false), cycle_budget(0u),
+      ok(false), started(false), done(false),
+      next(NULL_PTR(parse_job_t *)) {}
+
+ParseService::ParseService()
+    : threads(NULL_PTR(pthread_t *)), n_threads(0u),
+      head(NULL_PTR(parse_job_t *)), tail(NULL_PTR(parse_job_t *)),
+      stop(false) {
+  pthread_mutex_init(&mutex, NULL_PTR(const pthread_mutexattr_t *));
+  pthread_cond_init(&queued, NULL_PTR(const pthread_condattr_t *));
+  pthread_cond_init(&done, NULL_PTR(const pthread_condattr_t *));
+  long cores = sysconf(_SC_NPROCESSORS_ONLN);
+  uint32 n = cores > 0 ? static_cast<uint32>(cores) : 1u;
+  if (n > MAX_PARSE_WORKERS) {
+    n = MAX_PARSE_WORKERS;
+  }
+  threads = new pthread_t[n];
+  for (uint32 i = 0u; i < n; i++) {
+    // jobs are executed by the waiting thread if no worker can be started
+    if (pthread_create(&threads[n_threads], NULL_PTR(const pthread_attr_t *),
+                       worker, this) == 0) {
+      n_threads++;
+    }
+  }
+}
+
+ParseService::~ParseService() {
+  pthread_mutex_lock(&mutex);
+  stop = true;
+  pthread_cond_broadcast(&queued);
+  pthread_mutex_unlock(&mutex);
+  for (uint32 i = 0u; i < n_threads; i++) {
+    pthread_join(threads[i], NULL_PTR(void **));
+  }
+  delete[] threads;
+  pthread_cond_destroy(&done);
+  pthread_cond_destroy(&queued);
+  pthread_mutex_destroy(&mutex);
+}
+
+ParseService &ParseService::instance() {
+  static ParseService service;
+  return service;
+}
+
+void ParseService::submit(parse_job_t &job) {
+  job.ok = false;
+  job.started = false;
+  job.done = false;
+  job.next = NULL_PTR(parse_job_t *);
+  pthread_mutex_lock(&mutex);
+  if (tail == NULL_PTR(parse_job_t *)) {
+    head = &job;
+  } else {
+    tail->next = &job;
+  }
+  tail = &job;
+  pthread_cond_signal(&queued);
+  pthread_mutex_unlock(&mutex);
+}
+
+bool ParseService::wait(parse_job_t &job) {
+  pthread_mutex_lock(&mutex);
+  if (!job.started) {
+    // not taken by any worker yet: remove it from the queue and run it here
+    parse_job_t *prev = NULL_PTR(parse_job_t *);
+    parse_job_t *it = head;
+    while (it != NULL_PTR(parse_job_t *) && it != &job) {
+      prev = it;
+      it = it->next;
+    }
+    if (it != NULL_PTR(parse_job_t *)) {
+      if (prev == NULL_PTR(parse_job_t *)) {
+        head = job.next;
+      } else {
+        prev->next = job.next;
+      }
+      if (tail == &job) {
+        tail = prev;
+      }
+    }
+    job.started = true;
+    pthread_mutex_unlock(&mutex);
+    run(job);
+    pthread_mutex_lock(&mutex);
+    job.done = true;
+  }
+  while (!job.done) {
+    pthread_cond_wait(&done, &mutex);
+  }
+  pthread_mutex_unlock(&mutex);
+  return job.ok;
+}
+
+uint32 ParseService::workers() const { return n_threads; }
+
+void ParseService::run(parse_job_t &job) {
+  bool ok = job.code != NULL_PTR(const char8 *);
+  if (ok) {
+    job.ast = parse(job.code, ok);
+  }
+  if (ok) {
+    Verifier::LuaGAMValidator validator(job.ast);
+    ok &= validator.check_gam();
+    if (ok && job.only_gam) {
+      ok &= validator.check_only_gam();
+    }
+    if (ok && job.cycle_budget > 0u) {
+      ok &= validator.check_cycle_budget(job.cycle_budget);
+    }
+  }
+  job.ok = ok;
+}
+
+void *ParseService::worker(void *arg) {
+  ParseService *service = static_cast<ParseService *>(arg);
+  pthread_mutex_lock(&service->mutex);
+  while (!service->stop) {
+    parse_job_t *job = service->head;
+    if (job == NULL_PTR(parse_job_t *)) {
+      pthread_cond_wait(&service->queued, &service->mutex);
+    } else {
+      service->head = job->next;
+      if (service->head == NULL_PTR(parse_job_t *)) {
+        service->tail = NULL_PTR(parse_job_t *);
+      }
+      job->started = true;
+      pthread_mutex_unlock(&service->mutex);
+      run(*job);
+      pthread_mutex_lock(&service->mutex);
+      // the job belongs to the waiting thread from now on
+      job->done = true;
+      pthread_cond_broadcast(&service->done);
+    }
+  }
+  pthread_mutex_unlock(&service->mutex);
+  return NULL_PTR(void *);
+}
+
+} // namespace LUA
+} // namespace MARTe
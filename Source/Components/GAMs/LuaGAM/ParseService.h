@@ -0,0 +1,102 @@
+#ifndef _LUAGAM_PARSE_SERVICE_H__
+#define _LUAGAM_PARSE_SERVICE_H__
+
+#include "AST.h"
+#include "LuaParserBaseTypes.h"
+
+#include <pthread.h>
+
+namespace MARTe {
+
+namespace LUA {
+
+/**
+ * @brief Parsing and static verification of a `GAM()` script.
+ *
+ * The job is filled by the caller, executed by a worker of the ParseService
+ * and handed back by ParseService::wait. Until `wait` returns the job must
+ * not be accessed nor destroyed by the caller.
+ **/
+struct parse_job_t {
+  parse_job_t();
+
+  const char8 *code;   //!< Lua code (must outlive the job)
+  bool only_gam;       //!< check that the code contains only `GAM()`
+  uint64 cycle_budget; //!< maximum estimated cost of `GAM()` (0 = no limit)
+  ast_t ast;           //!< parsed code (valid after `wait`)
+  bool ok;             //!< result of parsing and verification
+  bool started;        //!< job taken by a worker
+  bool done;           //!< job completed
+  parse_job_t *next;   //!< next job in the queue
+};
+
+/**
+ * @brief Process wide pool of workers parsing and verifying Lua scripts.
+ *
+ * The `LuaGAM::Initialise` of every GAM submits its script, so that the
+ * scripts of a configuration are parsed concurrently while the remaining
+ * objects are initialised, and `LuaGAM::Setup` waits for its own result.
+ * The pool has one worker per online core. Jobs not yet started when
+ * waited for are executed by the waiting thread.
+ *
+ * Parsing and verification share no mutable state, every job works on its
+ * own tokens and AST. The AST is built by the worker and only accessed by
+ * the waiting thread once `wait` returns.
+ **/
+class ParseService {
+public:
+  /**
+   * @brief Get the service, starting the workers on first use.
+   **/
+  static ParseService &instance();
+
+  /**
+   * @brief Stop and join the workers.
+   **/
+  ~ParseService();
+
+  /**
+   * @brief Queue a job.
+   * @param[in] job to be executed
+   **/
+  void submit(parse_job_t &job);
+
+  /**
+   * @brief Wait for the completion of a submitted job.
+   * @param[in] job to wait for
+   * @return the job result
+   **/
+  bool wait(parse_job_t &job);
+
+  /**
+   * @brief Number of running workers.
+   **/
+  uint32 workers() const;
+
+  /**
+   * @brief Parse and verify the script of a job in the calling thread.
+   * @param[in,out] job to execute
+   **/
+  static void run(parse_job_t &job);
+
+private:
+  ParseService();
+  ParseService(const ParseService &);
+  ParseService &operator=(const ParseService &);
+
+  static void *worker(void *arg);
+
+  pthread_mutex_t mutex;  //!< protects the queue and the job states
+  pthread_cond_t queued;  //!< signalled when a job is queued or on stop
+  pthread_cond_t done;    //!< signalled when a job is completed
+  pthread_t *threads;     //!< worker threads
+  uint32 n_threads;       //!< number of running workers
+  parse_job_t *head;      //!< first queued job
+  parse_job_t *tail;      //!< last queued job
+  bool stop;              //!< workers must exit
+};
+
+} // namespace LUA
+} // namespace MARTe
+
+#endif
@@ -4,36 +4,83 @@
 #include "LuaParserBaseTypes.h"
 #include "Verifier.h"
 
+#include <stdlib.h>
+
 namespace MARTe {
 namespace LUA {
 namespace Verifier {
 
-bool check_(Nodep node, const char8 *name, LuaNode node_type, uint32 &row,
-            uint32 &col) {
-  bool found = false;
-  if (node->type == node_type) {
-    for (Rc<NodepList::iterator> it = node->sub_nodes.iterate(); it && !found;
-         it = it->next()) {
-      for (Rc<NodepList::iterator> jt = it->value()->sub_nodes.iterate();
-           jt && !found; jt = jt->next()) {
-        if ((!jt->value()->tok.isNull()) && (jt->value()->tok->raw == name)) {
-          found = true;
-          row = jt->value()->tok->row;
-          col = jt->value()->tok->col;
+/**
+ * @brief Resolve a name in the symbol table of the AST
+ * @param[in] ast AST
+ * @param[in] name name to resolve
+ * @param[out] sym symbol of the name (NO_SYMBOL if the AST has no table)
+ * @return false if the name is not an identifier of the AST
+ */
+bool resolve(const ast_t &ast, const char8 *name, uint32 &sym) {
+  sym = NO_SYMBOL;
+  return ast.symbols.isNull() || ast.symbols->find(name, sym);
+}
+
+/**
+ * @brief Check if a token is the given identifier
+ */
+bool same_name(const Tokenp &tok, const char8 *name, const uint32 sym) {
+  return (sym != NO_SYMBOL) ? (tok->sym == sym) : (tok->raw == name);
+}
+
+/**
+ * @brief Usage of a name of the given kind of node
+ */
+position_t &usage_of(usage_t &usage, const LuaNode type) {
+  return (type == EXP) ? usage.exp
+                       : ((type == VARLIST) ? usage.varlist : usage.localstat);
+}
+
+const position_t &usage_of(const usage_t &usage, const LuaNode type) {
+  return (type == EXP) ? usage.exp
+                       : ((type == VARLIST) ? usage.varlist : usage.localstat);
+}
+
+/**
+ * @brief Record the first usage of the names in `EXP`, `VARLIST` and
+ * `LOCALSTAT` nodes, visiting the nodes in the order of a full search
+ * (the names of a node are checked before its sub nodes).
+ * @param[in] node node to index
+ * @param[out] index first usage of each name
+ */
+void index_(Nodep node, usage_map_t &index) {
+  if (node->type == EXP || node->type == VARLIST ||
+      node->type == LOCALSTAT) {
+    for (NodepList::iterator it = node->sub_nodes.begin();
+         it != node->sub_nodes.end(); ++it) {
+      for (NodepList::iterator jt = it.value()->sub_nodes.begin();
+           jt != it.value()->sub_nodes.end(); ++jt) {
+        if (!jt.value()->tok.isNull()) {
+          const Tokenp &tok = jt.value()->tok;
+          position_t &pos = usage_of(index[tok->raw.view()], node->type);
+          if (!pos.found) {
+            pos.found = true;
+            pos.row = tok->row;
+            pos.col = tok->col;
+          }
         }
       }
     }
   }
-  if (!found) {
-    for (Rc<NodepList::iterator> it = node->sub_nodes.iterate(); it;
-         it = it->next()) {
-      if (check_(it->value(), name, node_type, row, col)) {
-        found = true;
-        break;
-      }
-    }
+  for (NodepList::iterator it = node->sub_nodes.begin();
+       it != node->sub_nodes.end(); ++it) {
+    index_(it.value(), index);
   }
-  return found;
+}
+
+usage_map_t IndexNames(const ast_t &ast) {
+  usage_map_t index;
+  for (NodepList::iterator it = ast.nodes.begin();
+       it != ast.nodes.end(); ++it) {
+    index_(it.value(), index);
+  }
+  return index;
 }
 
 /**
@@ -48,52 +95,59 @@ void get_(Nodep node, LuaNode type, NodepList &list) {
       (node->sub_nodes[0]->tok->raw != NULL_PTR(char8 *))) {
     list.append(node);
   }
-  for (Rc<NodepList::iterator> it = node->sub_nodes.iterate(); it;
-       it = it->next()) {
-    get_(it->value(), type, list);
+  for (NodepList::iterator it = node->sub_nodes.begin();
+       it != node->sub_nodes.end(); ++it) {
+    get_(it.value(), type, list);
   }
 }
 
 NodepList ExtractVariables(const ast_t &ast) {
   NodepList variables;
-  for (Rc<NodepList::iterator> it = ast.nodes.iterate(); it; it = it->next()) {
-    get_(it->value(), VAR, variables);
+  for (NodepList::iterator it = ast.nodes.begin();
+       it != ast.nodes.end(); ++it) {
+    get_(it.value(), VAR, variables);
   }
   return variables;
 }
 
-bool Check(const ast_t &ast, const char8 *id, LuaNode type, uint32 &row,
-           uint32 &col) {
+LuaGAMValidator::LuaGAMValidator(const ast_t &ast)
+    : ast(ast), variables(ExtractVariables(ast)), indexed(false) {}
 
-  bool found = false;
-  for (Rc<NodepList::iterator> it = ast.nodes.iterate(); it; it = it->next()) {
-    if (check_(it->value(), id, type, row, col)) {
-      found = true;
-      break;
-    }
+bool LuaGAMValidator::used(const char8 *name, LuaNode type, uint32 &row,
+                           uint32 &col) {
+  if (!indexed) {
+    // built once, on the first signal validated
+    names = IndexNames(ast);
+    indexed = true;
   }
-  return found;
+  const usage_t *usage = names.get(StrView(name));
+  if (usage == NULL_PTR(const usage_t *)) {
+    return false;
+  }
+  const position_t &pos = usage_of(*usage, type);
+  if (pos.found) {
+    row = pos.row;
+    col = pos.col;
+  }
+  return pos.found;
 }
 
-LuaGAMValidator::LuaGAMValidator(const ast_t &ast)
-    : ast(ast), variables(ExtractVariables(ast)) {}
-
 bool LuaGAMValidator::validate_input_signal(const char8 *name) {
   bool ok = true;
   uint32 var_line, var_col; // dummies
-  if (!Check(ast, name, EXP, var_line, var_col)) {
+  if (!used(name, EXP, var_line, var_col)) {
     REPORT_ERROR_STATIC(ErrorManagement::InitialisationError,
                         "Input signal `%s` is not used.", name);
     ok = false;
   }
-  if (Check(ast, name, VARLIST, var_line, var_col)) {
+  if (used(name, VARLIST, var_line, var_col)) {
     REPORT_ERROR_STATIC(
         ErrorManagement::InitialisationError,
         "[Line:%i, Col:%i] Input signal `%s` is being reassigned.", var_line,
         var_col, name);
     ok = false;
   }
-  if (Check(ast, name, LOCALSTAT, var_line, var_col)) {
+  if (used(name, LOCALSTAT, var_line, var_col)) {
     REPORT_ERROR_STATIC(
         ErrorManagement::Warning,
         "[Line:%i, Col:%i] Input signal `%s` is being reassigned as local.",
@@ -109,14 +163,14 @@ bool LuaGAMValidator::validate_output_signal(const char8 *name,
 
   uint32 var_assign_line = max_lines;
   uint32 var_assign_col = var_assign_line;
-  if (!Check(ast, name, VARLIST, var_assign_line, var_assign_col)) {
+  if (!used(name, VARLIST, var_assign_line, var_assign_col)) {
     REPORT_ERROR_STATIC(ErrorManagement::InitialisationError,
                         "Output signal `%s` is not assigned.", name);
     ok = false;
   }
   uint32 var_use_line;
   uint32 var_use_col;
-  if (Check(ast, name, EXP, var_use_line, var_use_col)) {
+  if (used(name, EXP, var_use_line, var_use_col)) {
     if ((var_use_line < var_assign_line) ||
         ((var_use_line == var_assign_line) && (var_use_col < var_assign_col))) {
       REPORT_ERROR_STATIC(ErrorManagement::Warning,
@@ -127,7 +181,7 @@ bool LuaGAMValidator::validate_output_signal(const char8 *name,
   }
   uint32 var_local_line;
   uint32 var_local_col;
-  if (Check(ast, name, LOCALSTAT, var_local_line, var_local_col)) {
+  if (used(name, LOCALSTAT, var_local_line, var_local_col)) {
     REPORT_ERROR_STATIC(
         ErrorManagement::InitialisationError,
         "[Line:%i, Col:%i] Output signal `%s` is being reassigned "
@@ -138,21 +192,20 @@ bool LuaGAMValidator::validate_output_signal(const char8 *name,
   return ok;
 }
 
-const Str &var_name(Rc<NodepList::iterator> it) {
-  return it->value()->sub_nodes[0]->tok->raw;
+const Str &var_name(NodepList::iterator it) {
+  return it.value()->sub_nodes[0]->tok->raw;
 }
 
 bool LuaGAMValidator::check_variables_initialisation(const char8 **names,
                                                      const uint32 len) {
   bool ok = true;
-  for (Rc<NodepList::iterator> it = variables.iterate(); it; it = it->next()) {
-    ok = false;
-    for (uint32 i = 0; i < len; i++) {
-      if (var_name(it) == names[i]) {
-        ok = true;
-        break;
-      }
-    }
+  HashMap<StrView, bool> initialised(len);
+  for (uint32 i = 0; i < len; i++) {
+    initialised.set(StrView(names[i]), true);
+  }
+  for (NodepList::iterator it = variables.begin();
+       it != variables.end(); ++it) {
+    ok = initialised.contains(var_name(it).view());
     if (!ok) {
       REPORT_ERROR_STATIC(ErrorManagement::InitialisationError,
                           "Variable `%s` is not initialized.",
@@ -172,11 +225,13 @@ bool LuaGAMValidator::check_gam() {
         ast.nodes.len());
     return false;
   }
-  for (Rc<NodepList::iterator> it = ast[0]->sub_nodes.iterate(); it;
-       it = it->next()) {
-    if (it->value()->type == STAT &&
-        it->value()->sub_nodes[0]->type == FUNCNAME &&
-        it->value()->sub_nodes[0]->tok->raw == GAM_FN) {
+  uint32 gam_sym;
+  const bool declared = resolve(ast, GAM_FN, gam_sym);
+  for (NodepList::iterator it = ast[0]->sub_nodes.begin();
+       declared && it != ast[0]->sub_nodes.end(); ++it) {
+    if (it.value()->type == STAT && it.value()->sub_nodes.len() > 0u &&
+        it.value()->sub_nodes[0]->type == FUNCNAME &&
+        same_name(it.value()->sub_nodes[0]->tok, GAM_FN, gam_sym)) {
       ok = true;
       break;
     }
@@ -188,7 +243,7 @@ bool LuaGAMValidator::check_gam() {
   return ok;
 }
 bool LuaGAMValidator::check_only_gam() {
-  bool ok = ast[0]->sub_nodes.len() == 1;
+  bool ok = ast.nodes.len() == 1 && ast[0]->sub_nodes.len() == 1;
   if (!ok) {
     REPORT_ERROR_STATIC(ErrorManagement::InitialisationError,
                         "External code found outside `" GAM_FN "` function");
@@ -196,6 +251,253 @@ bool LuaGAMValidator::check_only_gam() {
   return ok;
 }
 
+/**
+ * @brief Saturating addition of operation counts
+ */
+uint64 add_ops(const uint64 a, const uint64 b) {
+  const uint64 max = ~static_cast<uint64>(0u);
+  return (a > max - b) ? max : a + b;
+}
+
+/**
+ * @brief Saturating multiplication of operation counts
+ */
+uint64 mul_ops(const uint64 a, const uint64 b) {
+  const uint64 max = ~static_cast<uint64>(0u);
+  return (b != 0u && a > max / b) ? max : a * b;
+}
+
+/**
+ * @brief Evaluate a term of a static expression: an (optionally negated)
+ * numeral or the length of a signal (`#name`).
+ * @param[in] nodes nodes of the expression
+ * @param[in,out] i index of the first node of the term, then of the next
+ * node
+ * @param[in] sizes number of elements of the signals (if any)
+ * @param[out] value numeric value of the term
+ * @return true if the term is a numeric constant
+ */
+bool const_term(const NodepList &nodes, uint32 &i, const sizes_map_t *sizes,
+                float64 &value) {
+  const uint32 n = nodes.len();
+  bool negate = false;
+  if (i < n && nodes[i]->type == UNOP && nodes[i]->tok->type == MINUS) {
+    negate = true;
+    i++;
+  }
+  bool ok = i < n;
+  if (ok && nodes[i]->type == NUMERAL) {
+    char8 *end = NULL_PTR(char8 *);
+    value = strtod(nodes[i]->tok->raw.cstr(), &end);
+    ok = end != NULL_PTR(char8 *) && *end == '\0';
+    i++;
+  } else if (ok) {
+    ok = sizes != NULL_PTR(const sizes_map_t *) && i + 1u < n &&
+         nodes[i]->type == UNOP && nodes[i]->tok->type == LENGTH &&
+         nodes[i + 1u]->type == VAR && nodes[i + 1u]->sub_nodes.len() == 1u &&
+         nodes[i + 1u]->sub_nodes[0]->type == NAME;
+    const uint32 *elements = NULL_PTR(const uint32 *);
+    if (ok) {
+      const Str &name = nodes[i + 1u]->sub_nodes[0]->tok->raw;
+      elements = sizes->get(StrView(name.cstr(), name.len()));
+      ok = elements != NULL_PTR(const uint32 *);
+    }
+    if (ok) {
+      value = static_cast<float64>(*elements);
+      i += 2u;
+    }
+  }
+  if (ok && negate) {
+    value = -value;
+  }
+  return ok;
+}
+
+/**
+ * @brief Evaluate a static expression: sums and differences of numerals
+ * and lengths of signals (e.g. `#x - 1`).
+ * @param[in] exp expression node
+ * @param[in] sizes number of elements of the signals (if any)
+ * @param[out] value numeric value of the expression
+ * @return true if the expression is a numeric constant
+ */
+bool const_number(Nodep exp, const sizes_map_t *sizes, float64 &value) {
+  bool ok = exp && exp->type == EXP;
+  uint32 i = 0u;
+  ok = ok && const_term(exp->sub_nodes, i, sizes, value);
+  while (ok && i < exp->sub_nodes.len()) {
+    Nodep op = exp->sub_nodes[i++];
+    float64 term = 0.0;
+    ok = op->type == BINOP &&
+         (op->tok->type == ADD || op->tok->type == MINUS) &&
+         const_term(exp->sub_nodes, i, sizes, term);
+    if (ok) {
+      value = op->tok->type == ADD ? value + term : value - term;
+    }
+  }
+  return ok;
+}
+
+void mark_unbounded(Nodep node, cost_t &cost) {
+  if (cost.bounded) {
+    cost.bounded = false;
+    if (!node->tok.isNull()) {
+      cost.row = node->tok->row;
+      cost.col = node->tok->col;
+    }
+  }
+}
+
+uint64 cost_(Nodep node, const sizes_map_t *sizes, cost_t &cost);
+
+uint64 children_cost(Nodep node, const sizes_map_t *sizes, cost_t &cost) {
+  uint64 ops = 0u;
+  for (uint32 i = 0u; i < node->sub_nodes.len(); i++) {
+    ops = add_ops(ops, cost_(node->sub_nodes[i], sizes, cost));
+  }
+  return ops;
+}
+
+/**
+ * @brief Trip count of a numeric `for` loop with static bounds
+ * @param[in] stat `for` statement node (NAME, EXP, EXP, [EXP], BLOCK)
+ * @param[in] sizes number of elements of the signals (if any)
+ * @param[out] trips number of iterations
+ * @return true if the trip count is statically known
+ */
+bool for_trips(Nodep stat, const sizes_map_t *sizes, uint64 &trips) {
+  const uint32 n = stat->sub_nodes.len();
+  float64 start = 0.0;
+  float64 limit = 0.0;
+  float64 step = 1.0;
+  bool ok = (n == 4u || n == 5u) && stat->sub_nodes[0]->type == NAME;
+  ok = ok && const_number(stat->sub_nodes[1], sizes, start);
+  ok = ok && const_number(stat->sub_nodes[2], sizes, limit);
+  if (ok && n == 5u) {
+    ok = const_number(stat->sub_nodes[3], sizes, step) && step != 0.0;
+  }
+  if (ok) {
+    const float64 count = (limit - start) / step;
+    ok = count < 1.8e19; // also rejects NaN
+    if (ok) {
+      trips = (count < 0.0) ? 0u : static_cast<uint64>(count) + 1u;
+    }
+  }
+  return ok;
+}
+
+uint64 cost_(Nodep node, const sizes_map_t *sizes, cost_t &cost) {
+  uint64 ops = 0u;
+  if (!node) {
+    return ops;
+  }
+  const uint32 n = node->sub_nodes.len();
+  const uint32 tok = node->tok.isNull() ? static_cast<uint32>(ID)
+                                        : node->tok->type;
+  if (node->type == STAT && (tok == WHILE || tok == REPEAT)) {
+    mark_unbounded(node, cost);
+    ops = add_ops(1u, children_cost(node, sizes, cost));
+  } else if (node->type == STAT && tok == FOR) {
+    uint64 trips = 0u;
+    if (for_trips(node, sizes, trips)) {
+      uint64 bounds = 0u;
+      for (uint32 i = 1u; i < n - 1u; i++) {
+        bounds = add_ops(bounds, cost_(node->sub_nodes[i], sizes, cost));
+      }
+      // one extra operation per iteration for the loop test
+      uint64 body = add_ops(cost_(node->sub_nodes[n - 1u], sizes, cost), 1u);
+      ops = add_ops(bounds, mul_ops(trips, body));
+    } else {
+      mark_unbounded(node, cost);
+      ops = add_ops(1u, children_cost(node, sizes, cost));
+    }
+  } else if (node->type == STAT && tok == IF) {
+    // every condition may be evaluated, only one branch is executed
+    uint64 conditions = 0u;
+    uint64 branch = 0u;
+    for (uint32 i = 0u; i < n; i++) {
+      Nodep sub = node->sub_nodes[i];
+      if (sub->type == EXP) {
+        conditions = add_ops(conditions, cost_(sub, sizes, cost));
+      } else if (sub->type == BLOCK) {
+        uint64 c = cost_(sub, sizes, cost);
+        branch = c > branch ? c : branch;
+      } else {
+        for (uint32 j = 0u; j < sub->sub_nodes.len(); j++) {
+          Nodep part = sub->sub_nodes[j];
+          uint64 c = cost_(part, sizes, cost);
+          if (part->type == EXP) {
+            conditions = add_ops(conditions, c);
+          } else {
+            branch = c > branch ? c : branch;
+          }
+        }
+      }
+    }
+    ops = add_ops(conditions, branch);
+  } else if (node->type == LOCALSTAT && n > 0u &&
+             node->sub_nodes[0]->type == LOCALFUNCTION) {
+    // the body is executed only when called
+    ops = 1u;
+  } else if (node->type == COMMENT) {
+    ops = 0u;
+  } else {
+    // tokens are loads or operators, untagged statements are stores or calls
+    const bool counted = !node->tok.isNull() || node->type == STAT;
+    ops = add_ops(counted ? 1u : 0u, children_cost(node, sizes, cost));
+  }
+  return ops;
+}
+
+/**
+ * @brief Retrieve the body of the main `GAM()` function
+ */
+Nodep gam_body(const ast_t &ast) {
+  Nodep body;
+  uint32 gam_sym;
+  if (ast.nodes.len() > 0u && resolve(ast, GAM_FN, gam_sym)) {
+    for (uint32 i = 0u; i < ast[0]->sub_nodes.len() && !body; i++) {
+      Nodep stat = ast[0]->sub_nodes[i];
+      if (stat->type == STAT && stat->sub_nodes.len() == 2u &&
+          stat->sub_nodes[0]->type == FUNCNAME &&
+          same_name(stat->sub_nodes[0]->tok, GAM_FN, gam_sym) &&
+          stat->sub_nodes[1]->sub_nodes.len() > 0u) {
+        body = stat->sub_nodes[1]->sub_nodes[-1];
+      }
+    }
+  }
+  return body;
+}
+
+cost_t LuaGAMValidator::estimate_cost(const sizes_map_t *sizes) {
+  cost_t cost;
+  cost.ops = 0u;
+  cost.bounded = true;
+  cost.row = 0u;
+  cost.col = 0u;
+  cost.ops = cost_(gam_body(ast), sizes, cost);
+  return cost;
+}
+
+bool LuaGAMValidator::check_cycle_budget(const uint64 budget,
+                                         const sizes_map_t *sizes) {
+  cost_t cost = estimate_cost(sizes);
+  bool ok = cost.bounded;
+  if (!ok) {
+    REPORT_ERROR_STATIC(ErrorManagement::InitialisationError,
+                        "[Line:%i, Col:%i] Loop without static bound, the "
+                        "cost of `" GAM_FN "` cannot be estimated.",
+                        cost.row, cost.col);
+  } else if (cost.ops > budget) {
+    REPORT_ERROR_STATIC(ErrorManagement::InitialisationError,
+                        "Estimated cost of `" GAM_FN "` (%u operations) "
+                        "exceeds the budget (%u operations).",
+                        cost.ops, budget);
+    ok = false;
+  }
+  return ok;
+}
+
 } // namespace Verifier
 } // namespace LUA
 } // namespace MARTe
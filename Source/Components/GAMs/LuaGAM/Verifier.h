@@ -2,6 +2,7 @@
 #define _LUAGAM_VERIFIER_H__
 
 #include "AST.h"
+#include "HashMap.h"
 #include "LuaParserBaseTypes.h"
 
 #define GAM_FN "GAM"
@@ -10,6 +11,50 @@ namespace MARTe {
 namespace LUA {
 namespace Verifier {
 
+/**
+ * @brief Static estimation of the work done by a single `GAM()` call.
+ *
+ * The cost is expressed in abstract operations (variable loads, operators,
+ * calls and statements), not in CPU cycles: it is meant to be compared
+ * against a budget calibrated on the target machine.
+ **/
+struct cost_t {
+  uint64 ops;   //!< upper bound of operations executed per `GAM()` call
+  bool bounded; //!< false if at least one loop has no static trip count
+  uint32 row;   //!< line of the first unbounded loop (if any)
+  uint32 col;   //!< column of the first unbounded loop (if any)
+};
+
+/**
+ * @brief Position of the first usage of a name.
+ **/
+struct position_t {
+  bool found;
+  uint32 row;
+  uint32 col;
+};
+
+/**
+ * @brief First usage of a name as expression, assigned variable and local
+ * declaration.
+ **/
+struct usage_t {
+  position_t exp;       //!< in an `EXP` node
+  position_t varlist;   //!< in a `VARLIST` node
+  position_t localstat; //!< in a `LOCALSTAT` node
+};
+
+/**
+ * @brief Usage of the names of an AST (the keys are views of the tokens).
+ **/
+typedef HashMap<StrView, usage_t> usage_map_t;
+
+/**
+ * @brief Number of elements of the GAM signals (the keys are views of the
+ * signal names).
+ **/
+typedef HashMap<StrView, uint32> sizes_map_t;
+
 class LuaGAMValidator {
 public:
   LuaGAMValidator(const ast_t &ast);
@@ -20,9 +65,44 @@ public:
   bool check_gam();
   bool check_only_gam();
 
+  /**
+   * @brief Compute the worst case cost of the `GAM()` function.
+   *
+   * Numeric `for` loops with static bounds multiply the cost of their body
+   * by the trip count, `if` statements take the most expensive branch.
+   * The bounds are sums and differences of literals and lengths of signals
+   * (e.g. `#x - 1`). `while`, `repeat` and generic `for` loops have no
+   * static bound and mark the estimation as unbounded. Calls are counted as
+   * a single operation plus their arguments.
+   * @param[in] sizes number of elements of the signals (if any)
+   * @return the estimated cost
+   **/
+  cost_t estimate_cost(const sizes_map_t *sizes = NULL_PTR(sizes_map_t *));
+
+  /**
+   * @brief Verify that the `GAM()` function fits the given budget.
+   * @param[in] budget maximum number of operations allowed per call
+   * @param[in] sizes number of elements of the signals (if any)
+   * @return true if the estimation is bounded and within the budget
+   **/
+  bool check_cycle_budget(const uint64 budget,
+                          const sizes_map_t *sizes = NULL_PTR(sizes_map_t *));
+
 private:
+  /**
+   * @brief Look for the first usage of a name in a kind of node.
+   * @param[in] name name to look for
+   * @param[in] type `EXP`, `VARLIST` or `LOCALSTAT`
+   * @param[out] row line of the first usage (unchanged if not found)
+   * @param[out] col column of the first usage (unchanged if not found)
+   * @return true if the name is used
+   **/
+  bool used(const char8 *name, LuaNode type, uint32 &row, uint32 &col);
+
   const ast_t &ast;
   const NodepList variables;
+  usage_map_t names;
+  bool indexed;
 };
 
 } // namespace Verifier
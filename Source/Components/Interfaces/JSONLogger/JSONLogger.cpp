@@ -32,14 +32,24 @@
 #include "ErrorInformation.h"
 #include "ErrorManagement.h"
 #include "Logger.h"
+#include "HashMap.h"
+#include "StrBuilder.h"
 #include "StreamString.h"
 #include "StringHelper.h"
 #include <cstdio>
+#include <errno.h>
+#include <glob.h>
 #include <pthread.h>
+#include <sched.h>
 #include <stdlib.h>
+#include <string.h>
 #include <sys/stat.h>
 #include <sys/time.h>
+#include <time.h>
 #include <unistd.h>
+#if defined(JSONLOGGER_ZLIB)
+#include <zlib.h>
+#endif
 /*---------------------------------------------------------------------------*/
 /*                           Static definitions                              */
 /*---------------------------------------------------------------------------*/
@@ -47,132 +57,648 @@
 #define MAX_LEN 512
 #define MAX_TRIES 10
 #define KEY(str) "\"" str "\":"
-#define STRFMT "\"%s\""
-#define ESCAPE_CHR '\\'
 
 namespace MARTe {
 
-static const uint32 num_non_valid_char = 3;
-static const char non_valid_char[num_non_valid_char] = {'\n', '\t', '"'};
-static const char valid_char[num_non_valid_char] = {'n', 't', '"'};
+/**
+ @brief append a MARTe::TimeStamp as a YYYY-MM-DDThh:mm:ss string
+ **/
+void date_time(StrBuilder &str, const TimeStamp &ts) {
+  str.append(static_cast<uint32>(ts.GetYear())).append('-');
+  str.append_padded(1u + ts.GetMonth(), 2u).append('-');
+  str.append_padded(ts.GetDay() + 1u, 2u).append('T');
+  str.append_padded(ts.GetHour(), 2u).append(':');
+  str.append_padded(ts.GetMinutes(), 2u).append(':');
+  str.append_padded(ts.GetSeconds(), 2u);
+}
+
+/**
+ @brief state of `format` reused from line to line: date and time of the
+ last second formatted by `time_stamp`, names of the error types
+ **/
+struct format_cache_t {
+  uint64 seconds;    // epoch of `date_time`
+  StrBuilder prefix; // YYYY-MM-DDThh:mm:ss (empty if not yet formatted)
+  HashMap<ErrorManagement::ErrorIntegerFormat, Str> error_names;
+};
 
 /**
- @brief check if a char is a non-valid json string character
+ @brief append an epoch timestamp as a YYYY-MM-DDThh:mm:ss.uuuuuu string,
+ or as the number of nanoseconds since the epoch if `epoch_ns`.
+
+ The date and time are converted only when the second changes, otherwise
+ the cached prefix is copied and only the microseconds are formatted.
  **/
-bool is_non_valid(const char c) {
-  for (uint32 i = 0; i < num_non_valid_char; i++) {
-    if (c == non_valid_char[i]) {
-      return true;
+void time_stamp(StrBuilder &str, format_cache_t &cache, const uint64 seconds,
+                const uint32 microseconds, const bool epoch_ns) {
+  if (epoch_ns) {
+    str.append(seconds * 1000000000u +
+               static_cast<uint64>(microseconds) * 1000u);
+  } else {
+    if (cache.prefix.len() == 0u || cache.seconds != seconds) {
+      TimeStamp ts;
+      ts.ConvertFromEpoch(seconds);
+      cache.prefix.clear();
+      date_time(cache.prefix, ts);
+      cache.seconds = seconds;
     }
+    str.append('"').append(cache.prefix.view()).append('.');
+    str.append_padded(microseconds, 6u).append('"');
+  }
+}
+
+/**
+ @brief append the name of an error type, converted by `ErrorCodeToStream`
+ only the first time each value is met
+ **/
+void error_name(StrBuilder &str, format_cache_t &cache,
+                const ErrorManagement::ErrorType &type) {
+  const ErrorManagement::ErrorIntegerFormat code =
+      static_cast<ErrorManagement::ErrorIntegerFormat>(type);
+  const Str *name = cache.error_names.get(code);
+  if (name == NULL_PTR(const Str *)) {
+    StreamString errstr;
+    ErrorManagement::ErrorCodeToStream(type, errstr);
+    cache.error_names.set(code, Str(errstr.Buffer()));
+    name = cache.error_names.get(code);
+  }
+  str.append(*name);
+}
+
+/**
+ @brief CLOCK_MONOTONIC time in microseconds
+ **/
+uint64 now_us() {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return static_cast<uint64>(ts.tv_sec) * 1000000u +
+         static_cast<uint64>(ts.tv_nsec) / 1000u;
+}
+
+/**
+ @brief append a queued message as a json line
+ **/
+void format(StrBuilder &line, const JSONLogger::flusher_t &info,
+            format_cache_t &cache, const JSONLogger::entry_t &entry) {
+  const char8 *file_name = entry.info.fileName;
+  line.append("{" KEY("session_id") "\"").append(info.session_id);
+  line.append("\", " KEY("timestamp"));
+  time_stamp(line, cache, static_cast<uint64>(entry.info.timeSeconds),
+             static_cast<uint32>(entry.info.timeMicroseconds), info.epoch_ns);
+  line.append(", " KEY("hr_time"));
+  line.append(static_cast<uint64>(entry.info.hrtTime));
+  line.append(", " KEY("error_type") "\"");
+  error_name(line, cache, entry.info.header.errorType);
+  line.append("\", " KEY("file_name") "\"");
+  if (file_name != NULL_PTR(const char8 *)) {
+    line.append_json_escaped(file_name,
+                             static_cast<uint32>(strlen(file_name)));
+  }
+  line.append("\", " KEY("line_number"));
+  line.append(static_cast<int32>(entry.info.header.lineNumber));
+  line.append(", " KEY("message") "\"");
+  line.append_json_escaped(entry.message, entry.length);
+  line.append("\"}\n");
+}
+
+/**
+ @brief append a warning line with the number of dropped messages
+ **/
+void format_dropped(StrBuilder &line, const JSONLogger::flusher_t &info,
+                    format_cache_t &cache, const uint32 dropped) {
+  struct timeval now;
+  gettimeofday(&now, NULL);
+  line.append("{" KEY("session_id") "\"").append(info.session_id);
+  line.append("\", " KEY("timestamp"));
+  time_stamp(line, cache, static_cast<uint64>(now.tv_sec),
+             static_cast<uint32>(now.tv_usec), info.epoch_ns);
+  line.append(", " KEY("hr_time") "0, " KEY("error_type") "\"Warning\", ");
+  line.append(KEY("file_name") "\"" __FILE__ "\", " KEY("line_number"));
+  line.append(static_cast<uint32>(__LINE__));
+  line.append(", " KEY("message") "\"JSONLogger queue full, ");
+  line.append(dropped).append(" messages dropped\"}\n");
+}
+
+/**
+ @brief layout of the binary log (`Format = "Binary"`)
+
+ The file is a sequence of chunks, each one made of a 4 chars tag, the size
+ of its payload (uint32) and the payload. Numbers are in the byte order of
+ the host. A file (or a session appended to it) starts with a header chunk,
+ the strings (session id and file names) are written once in dictionary
+ chunks and the messages are written in record chunks, one per flush.
+ **/
+const char8 binary_header[4] = {'M', 'J', 'L', 'B'};
+const char8 binary_dictionary[4] = {'D', 'I', 'C', 'T'};
+const char8 binary_records[4] = {'R', 'E', 'C', 'S'};
+const uint32 binary_version = 1u;
+
+// larger chunks are considered corrupted by the converter
+const uint32 binary_max_chunk = 1u << 30u;
+
+/**
+ @brief header payload: version, dictionary id of the session id
+ **/
+struct binary_header_t {
+  uint32 version;
+  uint32 session_id;
+};
+
+/**
+ @brief fixed size record of a message. A record chunk contains the number of
+ records (uint32), the records and the messages they point to.
+ **/
+struct binary_record_t {
+  uint64 hrt_time;
+  uint32 time_seconds;
+  uint32 time_microseconds;
+  uint32 error_type;
+  uint32 line_number;
+  uint32 file_name;      // dictionary id
+  uint32 message_offset; // from the first message of the chunk
+  uint32 message_length;
+  uint32 reserved;
+};
+
+/**
+ @brief dictionary entry (followed by `length` chars)
+ **/
+struct binary_string_t {
+  uint32 id;
+  uint32 length;
+};
+
+/**
+ @brief binary log of the writer thread: messages and new strings not yet
+ written
+ **/
+struct binary_log_t {
+  HashMap<Str, uint32> ids; // interned strings
+  Str key;                  // lookup buffer, reused
+  StrBuilder dictionary;    // entries of all the interned strings
+  uint32 written;           // dictionary bytes already in the file
+  uint32 generation;        // file containing the written entries
+  bool started;             // header written at least once
+  uint32 session_id;
+  StrBuilder records;
+  StrBuilder messages;
+  uint32 count;
+};
+
+/**
+ @brief append the tag and size of a chunk
+ **/
+void chunk(StrBuilder &out, const char8 *tag, const uint32 size) {
+  out.append(tag, 4u);
+  out.append(reinterpret_cast<const char8 *>(&size), sizeof(size));
+}
+
+/**
+ @brief dictionary id of a string, added to the dictionary if new
+ **/
+uint32 intern(binary_log_t &log, const char8 *str) {
+  log.key.clear();
+  if (str != NULL_PTR(const char8 *)) {
+    log.key.append(str, static_cast<uint32>(strlen(str)));
+  }
+  const uint32 *found = log.ids.get(log.key);
+  if (found != NULL_PTR(const uint32 *)) {
+    return *found;
   }
-  return false;
+  binary_string_t entry;
+  entry.id = log.ids.len();
+  entry.length = log.key.len();
+  log.ids.set(log.key, entry.id);
+  log.dictionary.append(reinterpret_cast<const char8 *>(&entry),
+                        sizeof(entry));
+  log.dictionary.append(log.key.cstr(), entry.length);
+  return entry.id;
 }
 
 /**
- @brief count the number of non-valid json string characters inside a string
+ @brief append a message to the pending record chunk
  **/
-uint32 count_non_valid(const char *str, const uint32 len) {
-  uint32 counter = 0;
-  for (uint32 i = 0; i < len; i++) {
-    if (is_non_valid(str[i]) && (i == 0 || str[i - 1] != ESCAPE_CHR)) {
-      counter++;
+void encode(binary_log_t &log, const ErrorManagement::ErrorInformation &info,
+            const char8 *message, const uint32 length) {
+  binary_record_t record;
+  record.hrt_time = static_cast<uint64>(info.hrtTime);
+  record.time_seconds = static_cast<uint32>(info.timeSeconds);
+  record.time_microseconds = static_cast<uint32>(info.timeMicroseconds);
+  record.error_type =
+      static_cast<ErrorManagement::ErrorIntegerFormat>(info.header.errorType);
+  record.line_number = static_cast<uint32>(info.header.lineNumber);
+  // by content: the address of a file name can be reused by another one
+  // once the library defining it is unloaded
+  record.file_name = intern(log, info.fileName);
+  record.message_offset = log.messages.len();
+  record.message_length = length;
+  record.reserved = 0u;
+  log.records.append(reinterpret_cast<const char8 *>(&record),
+                     sizeof(record));
+  log.messages.append(message, length);
+  log.count++;
+}
+
+/**
+ @brief append a warning record with the number of dropped messages
+ **/
+void encode_dropped(binary_log_t &log, const uint32 dropped) {
+  struct timeval now;
+  gettimeofday(&now, NULL);
+  ErrorManagement::ErrorInformation info;
+  info.header.errorType = ErrorManagement::Warning;
+  info.header.lineNumber = __LINE__;
+  info.timeSeconds = now.tv_sec;
+  info.timeMicroseconds = now.tv_usec;
+  info.hrtTime = 0u;
+  info.fileName = __FILE__;
+  StrBuilder message;
+  message.append("JSONLogger queue full, ").append(dropped);
+  message.append(" messages dropped");
+  encode(log, info, message.cstr(), message.len());
+}
+
+/**
+ @brief bytes of the binary log not yet moved to `out`
+ **/
+uint32 pending(const binary_log_t &log) {
+  return log.dictionary.len() - log.written + log.records.len() +
+         log.messages.len();
+}
+
+/**
+ @brief move the new dictionary entries and the pending records to `out`.
+ A new file gets the header and the whole dictionary, so that each file
+ (rotated or re-created) can be read alone.
+ **/
+void finish(StrBuilder &out, binary_log_t &log,
+            const JSONLogger::flusher_t &info) {
+  if (!log.started || log.generation != info.generation) {
+    binary_header_t header;
+    header.version = binary_version;
+    header.session_id = log.session_id;
+    chunk(out, binary_header, sizeof(header));
+    out.append(reinterpret_cast<const char8 *>(&header), sizeof(header));
+    log.written = 0u;
+    log.generation = info.generation;
+    log.started = true;
+  }
+  if (log.written < log.dictionary.len()) {
+    chunk(out, binary_dictionary, log.dictionary.len() - log.written);
+    out.append(log.dictionary.cstr() + log.written,
+               log.dictionary.len() - log.written);
+    log.written = log.dictionary.len();
+  }
+  if (log.count > 0u) {
+    chunk(out, binary_records,
+          sizeof(log.count) + log.records.len() + log.messages.len());
+    out.append(reinterpret_cast<const char8 *>(&log.count), sizeof(log.count));
+    out.append(log.records.cstr(), log.records.len());
+    out.append(log.messages.cstr(), log.messages.len());
+    log.records.clear();
+    log.messages.clear();
+    log.count = 0u;
+  }
+}
+
+/**
+ @brief read the entries of a dictionary chunk
+ @return false if the chunk is corrupted
+ **/
+bool read_dictionary(Vec<Str> &strings, const char8 *payload,
+                     const uint32 size) {
+  uint32 i = 0u;
+  bool ok = true;
+  while (ok && i < size) {
+    binary_string_t entry;
+    ok = size - i >= sizeof(entry);
+    if (ok) {
+      memcpy(&entry, payload + i, sizeof(entry));
+      i += sizeof(entry);
+      ok = entry.id == strings.len() && size - i >= entry.length;
+    }
+    if (ok) {
+      strings.append(Str(payload + i, entry.length));
+      i += entry.length;
     }
   }
-  return counter;
+  return ok;
 }
 
 /**
- @brief sanitize a string by replacing non-valid json string characters with
- their escape sequences (e.g. EOL -> '\n')
+ @brief append the messages of a record chunk as json lines
+ @return false if the chunk is corrupted
  **/
-char *sanitize(const char *msg) {
-  uint32 len = StringHelper::Length(msg);
-  uint32 num_nvc = count_non_valid(msg, len);
-  char *str = new char[len + num_nvc + 1];
-  uint32 str_ind = 0;
-  for (uint32 i = 0; i < len; i++) {
-    if ((i == 0 || msg[i - 1] != ESCAPE_CHR)) {
-      bool wrote = false;
-      for (uint32 j = 0; j < num_non_valid_char; j++) {
-        if (msg[i] == non_valid_char[j]) {
-          str[str_ind++] = ESCAPE_CHR;
-          str[str_ind++] = valid_char[j];
-          wrote = true;
-          break;
-        }
-      }
-      if (!wrote) {
-        str[str_ind++] = msg[i];
-      }
-    } else {
-      str[str_ind++] = msg[i];
+bool read_records(StrBuilder &line, const JSONLogger::flusher_t &info,
+                  format_cache_t &cache, const Vec<Str> &strings,
+                  const char8 *payload, const uint32 size) {
+  uint32 count = 0u;
+  bool ok = size >= sizeof(count);
+  if (ok) {
+    memcpy(&count, payload, sizeof(count));
+    ok = (size - sizeof(count)) / sizeof(binary_record_t) >= count;
+  }
+  const char8 *records = payload + sizeof(count);
+  const char8 *messages = records + count * sizeof(binary_record_t);
+  const uint32 messages_size =
+      ok ? size - sizeof(count) - count * sizeof(binary_record_t) : 0u;
+  JSONLogger::entry_t entry;
+  for (uint32 i = 0u; ok && i < count; i++) {
+    binary_record_t record;
+    memcpy(&record, records + i * sizeof(record), sizeof(record));
+    ok = record.file_name < strings.len() &&
+         record.message_offset <= messages_size &&
+         record.message_length <= messages_size - record.message_offset;
+    if (ok) {
+      entry.info.header.errorType =
+          ErrorManagement::ErrorType(record.error_type);
+      entry.info.header.lineNumber = record.line_number;
+      entry.info.timeSeconds = record.time_seconds;
+      entry.info.timeMicroseconds = record.time_microseconds;
+      entry.info.hrtTime = record.hrt_time;
+      entry.info.fileName = strings[record.file_name].cstr();
+      entry.length = record.message_length < JSONLogger::message_size
+                         ? record.message_length
+                         : JSONLogger::message_size;
+      memcpy(entry.message, messages + record.message_offset, entry.length);
+      format(line, info, cache, entry);
     }
   }
-  str[str_ind] = 0;
-  return str;
+  return ok;
 }
 
 /**
- @brief convert a MARTe::TimeStamp to a YYYY-MM-DDThh:mm:ss string
+ @brief open the log file (appending), falling back to `stdout`
  **/
-void time_stamp(StreamString &str, const TimeStamp &ts) {
-  str.Printf("%d-%02d-%02dT%02d:%02d:%02d.%06d\0", ts.GetYear(),
-             1 + ts.GetMonth(), ts.GetDay() + 1, ts.GetHour(), ts.GetMinutes(),
-             ts.GetSeconds(), ts.GetMicroseconds());
+void reopen(JSONLogger::flusher_t &info) {
+  struct stat buff;
+  info.file = fopen(info.logpath, "a");
+  if (info.file == NULL_PTR(FILE *)) {
+    fprintf(stderr, "  \e[31m[ERROR]\e[0m Impossible to open logfile: %s\n",
+            info.logpath);
+    info.file = stdout;
+  }
+  info.file_size = 0u;
+  if (info.file != stdout && fstat(fileno(info.file), &buff) == 0) {
+    info.file_size = static_cast<uint64>(buff.st_size);
+  }
+  info.rotate_at = static_cast<uint64>(time(NULL)) + info.rotate_every;
+  info.generation++;
 }
 
 /**
- @brief convert an epoch timestamp to a YYYY-MM-DDThh:mm:ss string
+ @brief true if the `i`-th globbed path is the compressed copy of the
+ previous one (`<previous>.gz`)
  **/
-void time_stamp(StreamString &str, uint64 epoch) {
-  TimeStamp ts;
-  ts.ConvertFromEpoch(epoch);
-  time_stamp(str, ts);
+bool same_rotation(const glob_t &found, const size_t i) {
+  bool same = false;
+  if (i > 0u) {
+    const size_t len = strlen(found.gl_pathv[i - 1u]);
+    same = strncmp(found.gl_pathv[i - 1u], found.gl_pathv[i], len) == 0 &&
+           strcmp(found.gl_pathv[i] + len, ".gz") == 0;
+  }
+  return same;
 }
 
 /**
- @brief Flusher async rutine
- @details The flusher wait a defined amount of time and after try to flush the
- given file.
+ @brief flush the file, then check that it is still valid and if not try to
+ open it again.
 
- After it checks if the file is still valid and if not try to open it again.
  This is done after the flushing because the content not flushed will be lost
  anyway.
  **/
-void *flush(void *payload) {
-  JSONLogger::flusher_t &info = *(JSONLogger::flusher_t *)payload;
-  usleep(info.flush_delay_us);
-  pthread_mutex_lock(&info.mutex);
+void flush(JSONLogger::flusher_t &info) {
   struct stat buff;
   fflush(info.file);
-  if (info.file == NULL_PTR(FILE *)) {
-    // if file not opened
-    info.file = fopen(info.logpath, "a");
-  } else if (info.file != stdout && info.file != stderr &&
-             stat(info.logpath, &buff) != 0) {
+  if (info.file != stdout && info.file != stderr &&
+      stat(info.logpath, &buff) != 0) {
     // if file has been removed or renamed
     fclose(info.file);
-    info.file = fopen(info.logpath, "a");
+    reopen(info);
   }
+}
 
-  if (info.file == NULL_PTR(FILE *)) {
-    fprintf(stderr, "  \e[31m[ERROR]\e[0m Impossible to open logfile: %s\n",
+/**
+ @brief true if the log file must be rotated (size or age limit reached)
+ **/
+bool must_rotate(const JSONLogger::flusher_t &info) {
+  bool rotate = false;
+  if (info.file != stdout && info.file != stderr && info.file_size > 0u) {
+    rotate = info.max_file_size > 0u && info.file_size >= info.max_file_size;
+    rotate = rotate || (info.rotate_every > 0u &&
+                        static_cast<uint64>(time(NULL)) >= info.rotate_at);
+  }
+  return rotate;
+}
+
+/**
+ @brief delete the oldest rotated files, keeping the last `keep_files`
+
+ The rotated files (`<logpath>.YYYYMMDD-hhmmss-uuuuuu`, with `.gz` once
+ compressed) are sorted by name, hence by age.
+ **/
+void prune(const JSONLogger::flusher_t &info) {
+  StrBuilder pattern;
+  pattern.append(info.logpath).append(".[0-9]*");
+  glob_t found;
+  if (glob(pattern.cstr(), 0, NULL, &found) == 0) {
+    // a file being compressed is listed twice (with and without `.gz`)
+    uint32 rotated = 0u;
+    for (size_t i = 0u; i < found.gl_pathc; i++) {
+      rotated += same_rotation(found, i) ? 0u : 1u;
+    }
+    for (size_t i = 0u; i < found.gl_pathc && rotated > info.keep_files;
+         i++) {
+      (void)unlink(found.gl_pathv[i]);
+      rotated -= same_rotation(found, i) ? 0u : 1u;
+    }
+    globfree(&found);
+  }
+}
+
+/**
+ @brief close the log file, rename it with the current UTC time and open a
+ new one. The renamed file is queued for compression (left uncompressed if
+ the compressor is too far behind).
+ **/
+void rotate(JSONLogger::flusher_t &info) {
+  struct timeval now;
+  gettimeofday(&now, NULL);
+  // UTC (TimeStamp is in local time): the names sort by age even across a
+  // change of daylight saving time, as `prune` assumes
+  struct tm utc;
+  const time_t seconds = now.tv_sec;
+  gmtime_r(&seconds, &utc);
+  StrBuilder path;
+  path.append(info.logpath).append('.');
+  path.append(static_cast<uint32>(utc.tm_year + 1900));
+  path.append_padded(static_cast<uint32>(utc.tm_mon + 1), 2u);
+  path.append_padded(static_cast<uint32>(utc.tm_mday), 2u).append('-');
+  path.append_padded(static_cast<uint32>(utc.tm_hour), 2u);
+  path.append_padded(static_cast<uint32>(utc.tm_min), 2u);
+  path.append_padded(static_cast<uint32>(utc.tm_sec), 2u).append('-');
+  path.append_padded(static_cast<uint32>(now.tv_usec), 6u);
+  fclose(info.file);
+  if (rename(info.logpath, path.cstr()) != 0) {
+    fprintf(stderr, "  \e[31m[ERROR]\e[0m Impossible to rotate logfile: %s\n",
             info.logpath);
-    info.file = stdout;
+  } else if (info.rotated != NULL_PTR(JSONLogger::rotated_t *)) {
+    char8 *rotated = new char8[path.len() + 1u];
+    memcpy(rotated, path.cstr(), path.len() + 1u);
+    if (!info.rotated->push(rotated)) {
+      delete[] rotated;
+    }
+  }
+  reopen(info);
+  if (info.keep_files > 0u) {
+    prune(info);
+  }
+}
+
+#if defined(JSONLOGGER_ZLIB)
+/**
+ @brief compress a file in `<path>.gz` and delete it (the partial `.gz` is
+ deleted instead if the compression fails)
+ **/
+bool compress(const char8 *path) {
+  StrBuilder gz_path;
+  gz_path.append(path).append(".gz", 3u);
+  FILE *in = fopen(path, "rb");
+  // a file already deleted by `prune` is not an error
+  bool ok = in != NULL_PTR(FILE *) || errno == ENOENT;
+  if (in != NULL_PTR(FILE *)) {
+    gzFile out = gzopen(gz_path.cstr(), "wb");
+    ok = out != NULL_PTR(gzFile);
+    if (ok) {
+      char8 buff[65536];
+      size_t n;
+      while (ok && (n = fread(buff, 1u, sizeof(buff), in)) > 0u) {
+        ok = gzwrite(out, buff, static_cast<unsigned>(n)) ==
+             static_cast<int>(n);
+      }
+      ok = ok && ferror(in) == 0;
+      ok = (gzclose(out) == Z_OK) && ok;
+    }
+    fclose(in);
+    // if `prune` deleted the file meanwhile the copy is deleted too
+    if (!ok || (unlink(path) != 0 && errno == ENOENT)) {
+      (void)unlink(gz_path.cstr());
+    }
+  }
+  return ok;
+}
+
+/**
+ @brief Compressor thread rutine
+ @details Compresses the rotated files queued by the writer, at the lowest
+ priority so that it runs only when the CPUs are otherwise idle. It exits on
+ a null path, after the files queued before it.
+ **/
+void *compressor(void *payload) {
+  JSONLogger::rotated_t &rotated = *(JSONLogger::rotated_t *)payload;
+#if defined(__linux__)
+  struct sched_param param;
+  param.sched_priority = 0;
+  (void)pthread_setschedparam(pthread_self(), SCHED_IDLE, &param);
+#endif
+  bool stop = false;
+  while (!stop) {
+    char8 *path = NULL_PTR(char8 *);
+    if (rotated.pop_wait(path, 1000000u)) {
+      if (path == NULL_PTR(char8 *)) {
+        stop = true;
+      } else {
+        if (!compress(path)) {
+          fprintf(stderr, "  \e[31m[ERROR]\e[0m Impossible to compress: %s\n",
+                  path);
+        }
+        delete[] path;
+      }
+    }
   }
-  info.idle = true;
-  pthread_mutex_unlock(&info.mutex);
   return 0;
 }
+#endif
 
 /**
- @brief start the flusher thread
+ @brief Writer thread rutine
+ @details The writer sleeps until a message is queued, then formats the
+ messages in batches until `flush_delay_us` elapsed (or `flush_size` bytes are
+ formatted), so that a burst of lines is written with a single `fwrite` and
+ flushed at once. In binary format the messages are only copied in a record
+ chunk, the file names are written once in the dictionary. The number of
+ messages dropped by the loggers since the last batch is reported with a
+ warning line. After writing (or at least every second) it rotates the log
+ file if it is too large or too old.
+
+ It exits after writing the messages queued before the `last` entry.
  **/
-void flush_after(JSONLogger::flusher_t &info) {
-  pthread_t thread;
-  info.idle = false;
-  pthread_create(&thread, NULL_PTR(const pthread_attr_t *), flush,
-                 (void *)&info);
+void *writer(void *payload) {
+  static const uint32 batch_size = 16u;
+  static const uint32 idle_timeout_us = 1000000u;
+  JSONLogger::flusher_t &info = *(JSONLogger::flusher_t *)payload;
+  JSONLogger::entry_t *batch = new JSONLogger::entry_t[batch_size];
+  StrBuilder out(info.flush_size);
+  format_cache_t cache;
+  cache.seconds = 0u;
+  binary_log_t log;
+  log.written = 0u;
+  log.generation = 0u;
+  log.started = false;
+  log.count = 0u;
+  if (info.binary) {
+    log.session_id = intern(log, info.session_id);
+  }
+  uint32 reported = 0u;
+  uint64 deadline = 0u;
+  bool stop = false;
+  while (!stop) {
+    uint32 timeout = idle_timeout_us;
+    uint32 len = out.len() + pending(log);
+    if (len > 0u) {
+      const uint64 now = now_us();
+      timeout = now < deadline ? static_cast<uint32>(deadline - now) : 0u;
+    }
+    const uint32 n = info.queue->pop_wait(batch, batch_size, timeout);
+    if (n > 0u && len == 0u) {
+      // first message of a burst: start the flush timer
+      deadline = now_us() + info.flush_delay_us;
+    }
+    for (uint32 i = 0u; i < n; i++) {
+      if (batch[i].last) {
+        stop = true;
+      } else if (info.binary) {
+        encode(log, batch[i].info, batch[i].message, batch[i].length);
+      } else {
+        format(out, info, cache, batch[i]);
+      }
+    }
+    const uint32 dropped = RingAtomic::load_acquire(info.dropped);
+    if (dropped != reported) {
+      if (info.binary) {
+        encode_dropped(log, dropped - reported);
+      } else {
+        format_dropped(out, info, cache, dropped - reported);
+      }
+      reported = dropped;
+    }
+    len = out.len() + pending(log);
+    if (len > 0u &&
+        (stop || len >= info.flush_size || now_us() >= deadline)) {
+      if (info.binary) {
+        finish(out, log, info);
+      }
+      fwrite(out.cstr(), 1u, out.len(), info.file);
+      info.file_size += out.len();
+      out.clear();
+      flush(info);
+    }
+    if (must_rotate(info)) {
+      rotate(info);
+    }
+  }
+  delete[] batch;
+  return 0;
 }
 } // namespace MARTe
 /*---------------------------------------------------------------------------*/
@@ -184,57 +710,77 @@ JSONLogger::JSONLogger() : Object(), LoggerConsumerI() {
   session_id = NULL_PTR(char *);
   unique_file = false;
   info.file = NULL_PTR(FILE *);
-  info.idle = true;
-  pthread_mutex_init(&info.mutex, NULL_PTR(pthread_mutexattr_t *));
+  info.session_id = NULL_PTR(const char8 *);
+  info.flush_delay_us = 1000u;
+  info.flush_size = 65536u;
+  info.queue_size = 1024u;
+  info.epoch_ns = false;
+  info.binary = false;
+  info.generation = 0u;
+  info.max_file_size = 0u;
+  info.rotate_every = 0u;
+  info.keep_files = 10u;
+  info.file_size = 0u;
+  info.rotate_at = 0u;
+  info.rotated = NULL_PTR(rotated_t *);
+  info.queue = NULL_PTR(MpscRing<entry_t> *);
+  info.dropped = 0u;
+  info.running = false;
 }
 
 JSONLogger::~JSONLogger() {
-  pthread_mutex_lock(&info.mutex);
-  if (info.file != NULL_PTR(FILE *) && info.file != stdout) {
+  if (info.running) {
+    // the writer thread writes the queued messages before exiting
+    entry_t *last = new entry_t();
+    last->last = true;
+    while (!info.queue->push(*last)) {
+      sched_yield();
+    }
+    delete last;
+    pthread_join(info.thread, NULL_PTR(void **));
+  }
+  if (info.rotated != NULL_PTR(rotated_t *)) {
+    // the compressor thread compresses the queued files before exiting
+    while (!info.rotated->push(NULL_PTR(char8 *))) {
+      sched_yield();
+    }
+    pthread_join(info.compressor, NULL_PTR(void **));
+    delete info.rotated;
+  }
+  if (info.queue != NULL_PTR(MpscRing<entry_t> *)) {
+    delete info.queue;
+  }
+  if (info.file != NULL_PTR(FILE *) && info.file != stdout &&
+      info.file != stderr) {
     fclose(info.file);
   }
-  pthread_mutex_unlock(&info.mutex);
   if (info.logpath != NULL_PTR(char *)) {
     delete[] info.logpath;
   }
   if (session_id != NULL_PTR(char *)) {
     delete[] session_id;
   }
-  pthread_mutex_destroy(&info.mutex);
 }
 
 void JSONLogger::ConsumeLogMessage(LoggerPage *const logPage) {
-  if (logPage != NULL_PTR(LoggerPage *)) {
-
-    StreamString tsstr;
-    time_stamp(tsstr, logPage->errorInfo.timeSeconds);
-    StreamString errstr;
-    ErrorManagement::ErrorCodeToStream(logPage->errorInfo.header.errorType,
-                                       errstr);
-
-    pthread_mutex_lock(&info.mutex);
-    char *msg = sanitize(logPage->errorStrBuffer);
-    fprintf(info.file,
-            "{" KEY("session_id") STRFMT ", " KEY("timestamp") STRFMT
-            ", " KEY("hr_time") "%llu"
-                                ", " KEY("error_type") STRFMT
-            ", " KEY("file_name") STRFMT
-            ", " KEY("line_number") "%d"
-                                    ", " KEY("message") STRFMT "}\n",
-            session_id, tsstr.Buffer(), logPage->errorInfo.hrtTime,
-            errstr.Buffer(), logPage->errorInfo.fileName,
-            logPage->errorInfo.header.lineNumber, msg);
-    delete[] msg;
-
-    if (info.idle) {
-      pthread_mutex_unlock(&info.mutex);
-      flush_after(info);
-    } else {
-      pthread_mutex_unlock(&info.mutex);
+  if (logPage != NULL_PTR(LoggerPage *) && info.running) {
+    // only the raw information is copied, the writer thread formats it
+    entry_t entry;
+    entry.info = logPage->errorInfo;
+    entry.last = false;
+    entry.length = static_cast<uint32>(
+        strnlen(logPage->errorStrBuffer, message_size - 1u));
+    memcpy(entry.message, logPage->errorStrBuffer, entry.length);
+    if (!info.queue->push(entry)) {
+      // never block the loggers: the writer reports the dropped messages
+      (void)RingAtomic::fetch_add(info.dropped, 1u);
     }
   }
 }
 
+uint32 JSONLogger::GetDroppedMessages() const {
+  return RingAtomic::load_acquire(info.dropped);
+}
 bool JSONLogger::Initialise(StructuredDataI &data) {
   bool ok = Object::Initialise(data);
   session_id = new char[60];
@@ -247,8 +793,18 @@ bool JSONLogger::Initialise(StructuredDataI &data) {
   }
 
   StreamString str;
+  if (data.Read("Format", str)) {
+    info.binary = StringHelper::Compare(str.Buffer(), "Binary") == 0;
+    if (!info.binary && StringHelper::Compare(str.Buffer(), "JSON") != 0) {
+      ok = false;
+      fprintf(stderr, "  \e[31m[ERROR]\e[0m Unknown format `%s`\n",
+              str.Buffer());
+    }
+    str = "";
+  }
 
-  if (!(ok = data.Read("LogPath", str))) {
+  if (!(data.Read("LogPath", str))) {
+    ok = false;
     fprintf(stderr, "  \e[31m[ERROR]\e[0m Missing mandatory field `LogPath`\n");
   } else if (StringHelper::Compare(str.Buffer(), "stdout") == 0) {
     fprintf(stderr, "  \e[34m[INFO]\e[0m Logging to `stdout`\n");
@@ -261,7 +817,7 @@ bool JSONLogger::Initialise(StructuredDataI &data) {
       str += "_";
       str += session_id;
     }
-    str += ".log";
+    str += info.binary ? ".bin" : ".log";
     info.logpath = new char[str.Size() + 1];
     StringHelper::Copy(info.logpath, str.Buffer());
     info.logpath[str.Size()] = 0;
@@ -273,14 +829,123 @@ bool JSONLogger::Initialise(StructuredDataI &data) {
               info.logpath);
     }
   }
+  uint32 max_file_size_mb;
+  if (!data.Read("MaxFileSizeMB", max_file_size_mb)) {
+    max_file_size_mb = 0u;
+  }
+  info.max_file_size = static_cast<uint64>(max_file_size_mb) * 1024u * 1024u;
+  if (!data.Read("RotateEvery", info.rotate_every)) {
+    info.rotate_every = 0u;
+  }
+  if (!data.Read("KeepFiles", info.keep_files)) {
+    info.keep_files = 10u;
+  }
+  if (info.file != NULL_PTR(FILE *) && info.file != stdout &&
+      info.file != stderr) {
+    struct stat buff;
+    if (fstat(fileno(info.file), &buff) == 0) {
+      info.file_size = static_cast<uint64>(buff.st_size);
+    }
+    info.rotate_at = static_cast<uint64>(epoch) + info.rotate_every;
+#if defined(JSONLOGGER_ZLIB)
+    if (ok && (info.max_file_size > 0u || info.rotate_every > 0u)) {
+      info.rotated = new rotated_t(true);
+      if (pthread_create(&info.compressor,
+                         NULL_PTR(const pthread_attr_t *), compressor,
+                         (void *)info.rotated) != 0) {
+        // the rotated files are left uncompressed
+        delete info.rotated;
+        info.rotated = NULL_PTR(rotated_t *);
+      }
+    }
+#endif
+  }
   if (!data.Read("FlushDelay", info.flush_delay_us)) {
     info.flush_delay_us = 1000;
     fprintf(stderr, "  \e[34m[INFO]\e[0m Flush delay: 1ms\n");
   }
+  if (!data.Read("FlushSize", info.flush_size)) {
+    info.flush_size = 65536u;
+  }
+  if (!data.Read("QueueSize", info.queue_size)) {
+    info.queue_size = 1024u;
+  }
+  if (!data.Read("EpochTimestamp", info.epoch_ns)) {
+    info.epoch_ns = false;
+  }
+  if (ok) {
+    info.session_id = session_id;
+    info.queue = new MpscRing<entry_t>(info.queue_size, true);
+    info.running =
+        pthread_create(&info.thread, NULL_PTR(const pthread_attr_t *), writer,
+                       (void *)&info) == 0;
+    if (!info.running) {
+      ok = false;
+      fprintf(stderr, "  \e[31m[ERROR]\e[0m Impossible to start the writer\n");
+    }
+  }
 
   return ok;
 }
 
+bool JSONLogger::ConvertBinaryLog(FILE *in, FILE *out, const bool epoch_ns) {
+  flusher_t info;
+  info.epoch_ns = epoch_ns;
+  format_cache_t cache;
+  cache.seconds = 0u;
+  StrBuilder line(65536u);
+  Vec<Str> strings;
+  uint32 session = 0u;
+  char8 *payload = NULL_PTR(char8 *);
+  uint32 capacity = 0u;
+  bool ok = true;
+  bool end = false;
+  while (ok && !end) {
+    char8 tag[4];
+    uint32 size = 0u;
+    const size_t n = fread(tag, 1u, sizeof(tag), in);
+    end = n == 0u;
+    if (!end) {
+      ok = n == sizeof(tag) && fread(&size, sizeof(size), 1u, in) == 1u &&
+           size <= binary_max_chunk;
+      if (ok && size > capacity) {
+        delete[] payload;
+        payload = new char8[size];
+        capacity = size;
+      }
+      ok = ok && fread(payload, 1u, size, in) == size;
+    }
+    if (ok && !end) {
+      if (memcmp(tag, binary_header, sizeof(tag)) == 0) {
+        // a new file or session: new dictionary
+        binary_header_t header;
+        ok = size >= sizeof(header);
+        if (ok) {
+          memcpy(&header, payload, sizeof(header));
+          ok = header.version == binary_version;
+          session = header.session_id;
+          strings.clear();
+        }
+      } else if (memcmp(tag, binary_dictionary, sizeof(tag)) == 0) {
+        ok = read_dictionary(strings, payload, size);
+      } else if (memcmp(tag, binary_records, sizeof(tag)) == 0) {
+        ok = session < strings.len();
+        if (ok) {
+          info.session_id = strings[session].cstr();
+          ok = read_records(line, info, cache, strings, payload, size);
+        }
+      }
+      // chunks of later versions are skipped
+    }
+    if (line.len() > 0u) {
+      fwrite(line.cstr(), 1u, line.len(), out);
+      line.clear();
+    }
+  }
+  delete[] payload;
+  return ok;
+}
+
 CLASS_REGISTER(JSONLogger, "1.0")
 
 } // namespace MARTe
@@ -31,9 +31,13 @@
 /*---------------------------------------------------------------------------*/
 /*                        Project header includes                            */
 /*---------------------------------------------------------------------------*/
+#include "ErrorInformation.h"
 #include "LoggerConsumerI.h"
+#include "MpscRing.h"
+#include "SpscRing.h"
 #include "Object.h"
 #include <pthread.h>
+#include <stdio.h>
 
 /*---------------------------------------------------------------------------*/
 /*                           Class declaration                               */
@@ -48,9 +52,26 @@ namespace MARTe {
  a jsonl format. In the output the log information (timestamp, high resolution timer, 
  error tpe, filepath, line and message) are stored as a simple json object.
 
- To avoid performance bottlenecks an async flusher takes care of flushing the file 
- and in case that the output file has been deleted or moved it also ensure to create
- a new one. 
+ To avoid performance bottlenecks the loggers only copy the raw log information in
+ a preallocated lock-free queue of `QueueSize` entries, a background writer thread
+ (started by `Initialise`, joined by the destructor) formats them in batches and
+ writes them every `FlushDelay` microseconds or as soon as `FlushSize` bytes are
+ ready. After each flush it ensures to create a new output file in case the
+ current one has been deleted or moved. The loggers never block: when the queue is
+ full the messages are dropped and counted, the writer reports the number of
+ dropped messages with a warning line. Messages still queued at destruction are
+ written before the thread exits.
+
+ With `Format = "Binary"` the writer only copies the messages in fixed size
+ records and writes each file name once, the `JSONLoggerConvert` tool (or
+ `ConvertBinaryLog`) converts the binary log in json lines.
+
+ The writer thread also rotates the log file when it reaches `MaxFileSizeMB` or
+ every `RotateEvery` seconds: the file is renamed with the rotation time
+ (`<path>.YYYYMMDD-hhmmss-uuuuuu`) and only the last `KeepFiles` rotated files
+ are kept. When built with zlib
+ (`JSONLOGGER_ZLIB`) the rotated files are compressed in `.gz` files by a
+ background thread with the lowest priority.
  
  The `JSONLogger` configuration require only the following parameters:
  ```cue
@@ -59,6 +80,13 @@ namespace MARTe {
     LogPath: string | "stdout" | "stderr" // log destination path or stdout or stderr
     UniqueFile?: bool | *false // use unique file name
     FlushDelay?: uint32 | *1000 // flush delay in microseconds
+    FlushSize?: uint32 | *65536 // pending bytes that trigger a flush
+    QueueSize?: uint32 | *1024 // queued messages before dropping
+    EpochTimestamp?: bool | *false // timestamp as epoch nanoseconds
+    Format?: *"JSON" | "Binary" // json lines or binary records (`.bin`)
+    MaxFileSizeMB?: uint32 | *0 // rotate the log file at this size (0: never)
+    RotateEvery?: uint32 | *0 // rotate the log file every N seconds (0: never)
+    KeepFiles?: uint32 | *10 // rotated files kept (0: all)
  }
  ``` 
  
@@ -94,14 +122,65 @@ public:
   virtual bool Initialise(StructuredDataI &data);
 
   /**
-   * @brief struct to be shared with flusher thread.
+   * @brief Number of messages dropped because the queue was full.
+   */
+  uint32 GetDroppedMessages() const;
+
+  /**
+   * @brief Converts a binary log (`Format = "Binary"`) in json lines, the
+   * same written by the logger with `Format = "JSON"`.
+   * @param[in] in binary log.
+   * @param[out] out json lines.
+   * @param[in] epoch_ns time stamps as nanoseconds since the epoch.
+   * @return false if the log is truncated or corrupted (the messages before
+   * are converted anyway).
+   */
+  static bool ConvertBinaryLog(FILE *in, FILE *out, const bool epoch_ns);
+
+  /**
+   * @brief Maximum length of a queued message (longer ones are truncated).
+   */
+  static const uint32 message_size = 256u;
+
+  /**
+   * @brief raw log information queued by the loggers.
+   **/
+  struct entry_t {
+    ErrorManagement::ErrorInformation info;
+    char8 message[message_size]; // not null terminated
+    uint32 length;
+    bool last; // asks the writer thread to exit
+  };
+
+  /**
+   * @brief rotated files to be compressed (null path to stop).
+   **/
+  typedef SpscRing<char8 *, 16u> rotated_t;
+
+  /**
+   * @brief struct to be shared with the writer thread.
    **/
   struct flusher_t {
     char *logpath;
-    FILE *file;
-    bool idle;
+    FILE *file; // used only by the writer thread once started
+    const char8 *session_id;
     uint32 flush_delay_us;
-    pthread_mutex_t mutex;
+    uint32 flush_size;
+    uint32 queue_size;
+    bool epoch_ns; // time stamps as nanoseconds since the epoch
+    bool binary;       // binary records instead of json lines
+    uint32 generation; // incremented at each (re)opening of the file
+    MpscRing<entry_t> *queue;
+    uint64 max_file_size; // rotation size in bytes (0: never)
+    uint32 rotate_every;  // rotation period in seconds (0: never)
+    uint32 keep_files;    // rotated files kept (0: all)
+    uint64 file_size;     // bytes in the current file
+    uint64 rotate_at;     // epoch of the next periodic rotation
+    rotated_t *rotated;   // files to compress (null without compressor)
+    pthread_t compressor;
+    volatile uint32 dropped; // messages lost because the queue was full
+    bool running;            // writer thread started
+    pthread_t thread;
   };
 
 private:
@@ -0,0 +1,79 @@
+/**
+ * @file JSONLoggerConvert.cpp
+ * @brief Converter of the binary logs of the JSONLogger in json lines
+ * @date 18/10/2026
+ *
+ * @copyright Copyright 2015 F4E | European Joint Undertaking for ITER and
+ * the Development of Fusion Energy ('Fusion for Energy').
+ * Licensed under the EUPL, Version 1.1 or - as soon they will be approved
+ * by the European Commission - subsequent versions of the EUPL (the "Licence")
+ * You may not use this work except in compliance with the Licence.
+ * You may obtain a copy of the Licence at: http://ec.europa.eu/idabc/eupl
+ *
+ * @warning Unless required by applicable law or agreed to in writing,
+ * software distributed under the Licence is distributed on an "AS IS"
+ * basis, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+ * or implied. See the Licence permissions and limitations under the Licence.
+
+ * @details Writes the json lines of a log written with `Format = "Binary"`,
+ * the same that the logger writes with `Format = "JSON"`.
+ *
+ * Usage:
+ * ```
+ * JSONLoggerConvert.ex [-n] LOG.bin [OUTPUT.log]
+ * ```
+ * `-n` writes the time stamps as nanoseconds since the epoch, the output is
+ * `stdout` if not given, the input `stdin` if `-`.
+ */
+
+/*---------------------------------------------------------------------------*/
+/*                         Standard header includes                          */
+/*---------------------------------------------------------------------------*/
+#include <stdio.h>
+#include <string.h>
+
+/*---------------------------------------------------------------------------*/
+/*                         Project header includes                           */
+/*---------------------------------------------------------------------------*/
+#include "JSONLogger.h"
+
+/*---------------------------------------------------------------------------*/
+/*                           Static definitions                              */
+/*---------------------------------------------------------------------------*/
+
+int main(int argc, char **argv) {
+  bool epoch_ns = false;
+  int arg = 1;
+  if (arg < argc && strcmp(argv[arg], "-n") == 0) {
+    epoch_ns = true;
+    arg++;
+  }
+  if (arg >= argc || argc - arg > 2) {
+    fprintf(stderr, "Usage: %s [-n] LOG.bin [OUTPUT.log]\n", argv[0]);
+    return 2;
+  }
+  FILE *in = strcmp(argv[arg], "-") == 0 ? stdin : fopen(argv[arg], "rb");
+  if (in == NULL) {
+    fprintf(stderr, "  \e[31m[ERROR]\e[0m Impossible to open `%s`\n",
+            argv[arg]);
+    return 1;
+  }
+  FILE *out = arg + 1 < argc ? fopen(argv[arg + 1], "w") : stdout;
+  if (out == NULL) {
+    fprintf(stderr, "  \e[31m[ERROR]\e[0m Impossible to open `%s`\n",
+            argv[arg + 1]);
+    return 1;
+  }
+  const bool ok = MARTe::JSONLogger::ConvertBinaryLog(in, out, epoch_ns);
+  if (!ok) {
+    fprintf(stderr, "  \e[31m[ERROR]\e[0m Truncated or corrupted log `%s`\n",
+            argv[arg]);
+  }
+  if (in != stdin) {
+    fclose(in);
+  }
+  if (out != stdout) {
+    fclose(out);
+  }
+  return ok ? 0 : 1;
+}
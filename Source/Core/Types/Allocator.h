@@ -0,0 +1,63 @@
+#ifndef _ALLOCATOR_H__
+#define _ALLOCATOR_H__
+
+#include "CompilerTypes.h"
+
+#include <new>
+
+namespace MARTe {
+
+/**
+  @brief source of raw memory for the containers (`Vec`, `Str`, `Pool`).
+
+  Containers take an optional `Allocator *`: when it is null (default) the
+  memory comes from the global `operator new`. The allocator must outlive
+  every container using it.
+
+  An allocator may be exhausted (e.g. an `Arena` over an external buffer):
+  the containers are then left unchanged and report the failure (`false`
+  or null from the growing methods).
+**/
+class Allocator {
+public:
+  virtual ~Allocator() {}
+
+  /**
+    @brief allocate `size` bytes, aligned for any type
+    @return the memory, null if the allocator is exhausted
+  **/
+  virtual void *allocate(const uint32 size) = 0;
+
+  /**
+    @brief give back the memory of a previous `allocate`
+    @param ptr memory returned by `allocate`
+    @param size size passed to `allocate`
+  **/
+  virtual void deallocate(void *ptr, const uint32 size) = 0;
+};
+
+/**
+  @brief allocate `size` bytes from an allocator (or the heap if null)
+  @return the memory, null if the allocator is exhausted
+**/
+inline void *allocate(Allocator *allocator, const uint32 size) {
+  if (allocator == NULL_PTR(Allocator *)) {
+    return ::operator new(size);
+  }
+  return allocator->allocate(size);
+}
+
+/**
+  @brief give back memory obtained by `allocate(allocator, size)`
+**/
+inline void deallocate(Allocator *allocator, void *ptr, const uint32 size) {
+  if (allocator == NULL_PTR(Allocator *)) {
+    ::operator delete(ptr);
+  } else if (ptr != NULL_PTR(void *)) {
+    allocator->deallocate(ptr, size);
+  }
+}
+
+} // namespace MARTe
+
+#endif
@@ -0,0 +1,445 @@
+#ifndef _EC_ARC_H__
+#define _EC_ARC_H__
+#include "CompilerTypes.h"
+#include <assert.h>
+#include <new>
+
+namespace MARTe {
+
+/**
+ @brief atomic operations on the counters of `Arc`.
+
+ Uses the `__atomic` builtins when available (acquire/release ordering),
+ the full barrier `__sync` builtins otherwise.
+**/
+namespace ArcAtomic {
+
+inline uint32 load(const volatile uint32 &counter) {
+#if defined(__ATOMIC_ACQUIRE)
+  return __atomic_load_n(&counter, __ATOMIC_ACQUIRE);
+#else
+  return __sync_fetch_and_add(const_cast<volatile uint32 *>(&counter), 0u);
+#endif
+}
+
+/**
+ @brief increment a counter already owned by the caller (no ordering
+ needed: the new reference is published by other means).
+**/
+inline void increment(volatile uint32 &counter) {
+#if defined(__ATOMIC_RELAXED)
+  (void)__atomic_fetch_add(&counter, 1u, __ATOMIC_RELAXED);
+#else
+  (void)__sync_fetch_and_add(&counter, 1u);
+#endif
+}
+
+/**
+ @brief decrement a counter.
+ @return true if the counter reached 0, in that case all the writes done
+ by the other owners are visible to the caller.
+**/
+inline bool decrement(volatile uint32 &counter) {
+#if defined(__ATOMIC_ACQ_REL)
+  return __atomic_fetch_sub(&counter, 1u, __ATOMIC_ACQ_REL) == 1u;
+#else
+  return __sync_fetch_and_sub(&counter, 1u) == 1u;
+#endif
+}
+
+/**
+ @brief increment a counter only if it is not 0.
+ @return true if the counter has been incremented.
+**/
+inline bool increment_not_zero(volatile uint32 &counter) {
+  uint32 value = load(counter);
+  while (value != 0u) {
+#if defined(__ATOMIC_ACQ_REL)
+    if (__atomic_compare_exchange_n(&counter, &value, value + 1u, true,
+                                    __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE)) {
+      return true;
+    }
+#else
+    const uint32 prev =
+        __sync_val_compare_and_swap(&counter, value, value + 1u);
+    if (prev == value) {
+      return true;
+    }
+    value = prev;
+#endif
+  }
+  return false;
+}
+
+} // namespace ArcAtomic
+
+/**
+ @brief atomic reference counters shared by all the `Arc` of an object.
+
+ All the hard references together own one weak reference, so that the
+ control block is freed by whoever drops the weak counter to 0. The block
+ type provides the functions to destroy the object and to free itself.
+**/
+struct ArcCounts {
+  volatile uint32 strong; //!< number of hard references
+  volatile uint32 weak;   //!< number of weak references (+1 if not null)
+  void (*dispose)(ArcCounts *counts); //!< destroy the object
+  void (*release)(ArcCounts *counts); //!< free the control block
+
+  inline ArcCounts(void (*dispose_)(ArcCounts *),
+                   void (*release_)(ArcCounts *))
+      : strong(1u), weak(1u), dispose(dispose_), release(release_) {}
+};
+
+/**
+ @brief control block holding the atomic counters and the object storage.
+**/
+template <typename T> struct ArcBlock : public ArcCounts {
+  inline ArcBlock() : ArcCounts(&destroy_value, &free_block) {}
+
+  inline T *get() { return reinterpret_cast<T *>(storage_.bytes); }
+
+private:
+  static void destroy_value(ArcCounts *counts) {
+    static_cast<ArcBlock *>(counts)->get()->~T();
+  }
+
+  static void free_block(ArcCounts *counts) {
+    delete static_cast<ArcBlock *>(counts);
+  }
+
+  union {
+    char bytes[sizeof(T)];
+    double align_double_;
+    uint64 align_uint64_;
+    void *align_ptr_;
+  } storage_;
+};
+
+/**
+ @brief control block of an object allocated by the user.
+**/
+template <typename T> struct ArcPtrBlock : public ArcCounts {
+  inline ArcPtrBlock(T *p) : ArcCounts(&delete_ptr, &free_block), ptr(p) {}
+
+private:
+  static void delete_ptr(ArcCounts *counts) {
+    delete static_cast<ArcPtrBlock *>(counts)->ptr;
+  }
+
+  static void free_block(ArcCounts *counts) {
+    delete static_cast<ArcPtrBlock *>(counts);
+  }
+
+  T *ptr;
+};
+
+/**
+ @brief a thread safe smart pointer.
+
+ Same as `Rc` but the reference counters are updated atomically, so that
+ copies of the same pointer can be created and destroyed concurrently by
+ different threads (e.g. to share an immutable parsed script or a
+ configuration snapshot).
+
+ Only the counters are thread safe: a single `Arc` instance must not be
+ modified by a thread while it is accessed by another one, and the pointed
+ object is not protected.
+
+ A weak pointer (`~`) does not keep the object alive, it can be upgraded to
+ an hard pointer (`+`) as long as at least an hard pointer exists.
+**/
+template <typename T> class Arc {
+private:
+  T *pointer_;
+  ArcCounts *counts_;
+  bool isWeak_;
+
+  /**
+   * @brief free the control block once the last weak reference is gone.
+   **/
+  inline static void release_weak(ArcCounts *counts) {
+    if (ArcAtomic::decrement(counts->weak)) {
+      counts->release(counts);
+    }
+  }
+
+  /**
+   * @brief dereferanciate the current pointer.
+   *
+   * The last hard reference destroys the object and releases the weak
+   * reference owned by the hard references.
+   **/
+  inline void dereferenciate() {
+    ArcCounts *counts = counts_;
+    pointer_ = NULL_PTR(T *);
+    counts_ = NULL_PTR(ArcCounts *);
+    if (counts == NULL_PTR(ArcCounts *)) {
+      return;
+    }
+    if (!isWeak_) {
+      if (!ArcAtomic::decrement(counts->strong)) {
+        return;
+      }
+      counts->dispose(counts);
+    }
+    release_weak(counts);
+  }
+
+  /**
+   * @brief exchange the content of two pointers (no counter is changed).
+   **/
+  inline void swap(Arc &other) {
+    T *pointer = pointer_;
+    ArcCounts *counts = counts_;
+    const bool weak = isWeak_;
+    pointer_ = other.pointer_;
+    counts_ = other.counts_;
+    isWeak_ = other.isWeak_;
+    other.pointer_ = pointer;
+    other.counts_ = counts;
+    other.isWeak_ = weak;
+  }
+
+public:
+  /**
+   * @brief Create a null pointer.
+   **/
+  inline Arc()
+      : pointer_(NULL_PTR(T *)), counts_(NULL_PTR(ArcCounts *)),
+        isWeak_(false) {}
+  /**
+   * @brief Create a smart pointer from a regular pointer.
+   *
+   * The owenership of the pointer will be moved to the smart pointer.
+   **/
+  inline Arc(T *p)
+      : pointer_(p),
+        counts_(p == NULL_PTR(T *) ? NULL_PTR(ArcCounts *)
+                                   : new ArcPtrBlock<T>(p)),
+        isWeak_(false) {}
+  /**
+   * @brief Create a smart pointer owning a control block built by
+   *`make_arc` (the object must be already constructed).
+   **/
+  inline explicit Arc(ArcBlock<T> *block)
+      : pointer_(block->get()), counts_(block), isWeak_(false) {}
+  /**
+   * @brief Create a smart pointer from a value.
+   **/
+  inline Arc(const T &v) : isWeak_(false) {
+    ArcBlock<T> *block = new ArcBlock<T>();
+    pointer_ = new (block->get()) T(v);
+    counts_ = block;
+  }
+  /**
+   * @brief Copy constructor, if not null will increase the counter.
+   **/
+  inline Arc(const Arc &other)
+      : pointer_(other.pointer_), counts_(other.counts_),
+        isWeak_(other.isWeak_) {
+    if (counts_ != NULL_PTR(ArcCounts *)) {
+      ArcAtomic::increment(isWeak_ ? counts_->weak : counts_->strong);
+    }
+  }
+  /**
+   * @brief dereferenciate pointer.
+   **/
+  inline ~Arc() { dereferenciate(); }
+
+  /**
+   * @brief check if pointer is null (for a weak pointer the result may
+   *change at any time, use `+` to get a stable hard pointer).
+   **/
+  inline bool isNull() const {
+    return counts_ == NULL_PTR(ArcCounts *) ||
+           ArcAtomic::load(counts_->strong) == 0u;
+  }
+  /**
+   * @brief check if pointer is weak.
+   **/
+  inline bool isWeak() const { return isWeak_; }
+
+  /**
+   * @brief bool operator returns if the pointer is not null.
+   **/
+  inline operator bool() const { return !isNull(); }
+
+  inline bool operator!() const { return isNull(); }
+
+  /**
+   * @brief assign operator with another smart pointer will dereferenciate the
+   *current ptr and referenciate the other.
+   **/
+  inline Arc &operator=(const Arc &other) {
+    if (other.counts_ != counts_ || other.isWeak_ != isWeak_) {
+      Arc tmp(other);
+      swap(tmp);
+    }
+    return *this;
+  }
+
+  /**
+   * @brief weak assign operator with another smart pointer will dereferenciate
+   *the current ptr and create a weak reference to the other.
+   **/
+  inline Arc &operator%=(const Arc &other) {
+    Arc tmp = ~other;
+    swap(tmp);
+    return *this;
+  }
+
+  /**
+   * @brief check if the internal pointer is the same of the other pointer
+   **/
+  inline bool same(const Arc &other) const {
+    return other.pointer_ == pointer_;
+  }
+
+  /**
+   * @brief Pointer equality operator
+   **/
+  inline bool operator==(const Arc &other) const {
+    return other.pointer_ == pointer_;
+  }
+  /**
+   * @brief Pointer disequality operator
+   **/
+  inline bool operator!=(const Arc &other) const {
+    return other.pointer_ != pointer_;
+  }
+
+  /**
+   * @brief Create a weak pointer from an hard (or weak) pointer.
+   **/
+  inline Arc<T> operator~() const {
+    Arc<T> res;
+    res.isWeak_ = true;
+    if (counts_ != NULL_PTR(ArcCounts *)) {
+      ArcAtomic::increment(counts_->weak);
+      res.pointer_ = pointer_;
+      res.counts_ = counts_;
+    }
+    return res;
+  }
+
+  /**
+   * @brief Create a hard pointer from an hard (or weak) pointer, the result
+   *is null if the object has already been destroyed.
+   **/
+  inline Arc<T> operator+() const {
+    Arc<T> res;
+    if (counts_ != NULL_PTR(ArcCounts *) &&
+        ArcAtomic::increment_not_zero(counts_->strong)) {
+      res.pointer_ = pointer_;
+      res.counts_ = counts_;
+    }
+    return res;
+  }
+
+  /**
+   * @brief access internal methods/field of the pointer.
+   **/
+  inline T *operator->() const {
+    assert(!isNull());
+    return pointer_;
+  }
+  /**
+   * @brief access pointer value.
+   **/
+  inline T &operator*() const {
+    assert(!isNull());
+    return *pointer_;
+  }
+
+  /**
+   * @brief access pointer value.
+   **/
+  inline T &val() const {
+    assert(!isNull());
+    return *pointer_;
+  }
+
+  /**
+   * @brief Manually nullify pointer.
+   **/
+  inline void del() { dereferenciate(); }
+
+  /**
+   * @brief get reference count (a snapshot, it may be already changed).
+   **/
+  inline uint32 referencesCount() const {
+    if (counts_ == NULL_PTR(ArcCounts *)) {
+      return 0u;
+    }
+    return ArcAtomic::load(counts_->strong);
+  }
+
+  /**
+   * @brief get number of weak references (a snapshot, it may be already
+   *changed).
+   **/
+  inline uint32 weakReferencesCount() const {
+    if (counts_ == NULL_PTR(ArcCounts *)) {
+      return 0u;
+    }
+    const uint32 weak = ArcAtomic::load(counts_->weak);
+    return ArcAtomic::load(counts_->strong) > 0u ? weak - 1u : weak;
+  }
+};
+
+#if __cplusplus >= 201103L
+/**
+ * @brief Create an object and its atomic reference counters with a single
+ *allocation.
+ * @param args arguments forwarded to the constructor of T
+ **/
+template <typename T, typename... Args>
+inline Arc<T> make_arc(Args &&...args) {
+  ArcBlock<T> *block = new ArcBlock<T>();
+  new (block->get()) T(static_cast<Args &&>(args)...);
+  return Arc<T>(block);
+}
+#else
+/**
+ * @brief Create an object and its atomic reference counters with a single
+ *allocation.
+ **/
+template <typename T> inline Arc<T> make_arc() {
+  ArcBlock<T> *block = new ArcBlock<T>();
+  new (block->get()) T();
+  return Arc<T>(block);
+}
+
+template <typename T, typename A1> inline Arc<T> make_arc(const A1 &a1) {
+  ArcBlock<T> *block = new ArcBlock<T>();
+  new (block->get()) T(a1);
+  return Arc<T>(block);
+}
+
+template <typename T, typename A1, typename A2>
+inline Arc<T> make_arc(const A1 &a1, const A2 &a2) {
+  ArcBlock<T> *block = new ArcBlock<T>();
+  new (block->get()) T(a1, a2);
+  return Arc<T>(block);
+}
+
+template <typename T, typename A1, typename A2, typename A3>
+inline Arc<T> make_arc(const A1 &a1, const A2 &a2, const A3 &a3) {
+  ArcBlock<T> *block = new ArcBlock<T>();
+  new (block->get()) T(a1, a2, a3);
+  return Arc<T>(block);
+}
+
+template <typename T, typename A1, typename A2, typename A3, typename A4>
+inline Arc<T> make_arc(const A1 &a1, const A2 &a2, const A3 &a3,
+                       const A4 &a4) {
+  ArcBlock<T> *block = new ArcBlock<T>();
+  new (block->get()) T(a1, a2, a3, a4);
+  return Arc<T>(block);
+}
+#endif
+
+} // namespace MARTe
+
+#endif
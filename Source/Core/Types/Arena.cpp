@@ -0,0 +1,150 @@
+#include "Arena.h"
+
+#include <stdint.h>
+
+namespace MARTe {
+
+namespace {
+inline char *align_up(char *ptr) {
+  const uintptr_t mask = static_cast<uintptr_t>(Arena::alignment - 1u);
+  return reinterpret_cast<char *>((reinterpret_cast<uintptr_t>(ptr) + mask) &
+                                  ~mask);
+}
+} // namespace
+
+Arena::Arena(const uint32 chunk_size)
+    : first_(NULL_PTR(chunk_t *)), current_(NULL_PTR(chunk_t *)),
+      top_(NULL_PTR(char *)), end_(NULL_PTR(char *)),
+      chunk_size_(chunk_size > 0u ? chunk_size : default_chunk_size),
+      growable_(true) {}
+
+Arena::Arena(void *buffer, const uint32 size)
+    : first_(NULL_PTR(chunk_t *)), current_(NULL_PTR(chunk_t *)),
+      top_(NULL_PTR(char *)), end_(NULL_PTR(char *)), chunk_size_(size),
+      growable_(false) {
+  char *begin = align_up(static_cast<char *>(buffer));
+  char *end = static_cast<char *>(buffer) + size;
+  if (begin + sizeof(chunk_t) <= end) {
+    first_ = reinterpret_cast<chunk_t *>(begin);
+    first_->next = NULL_PTR(chunk_t *);
+    first_->owned = false;
+    const char *first_data = data(first_);
+    first_->size =
+        first_data < end ? static_cast<uint32>(end - first_data) : 0u;
+  }
+}
+
+Arena::~Arena() {
+  chunk_t *chunk = first_;
+  while (chunk != NULL_PTR(chunk_t *)) {
+    chunk_t *next = chunk->next;
+    if (chunk->owned) {
+      ::operator delete(chunk);
+    }
+    chunk = next;
+  }
+}
+
+char *Arena::data(chunk_t *chunk) {
+  return align_up(reinterpret_cast<char *>(chunk) + sizeof(chunk_t));
+}
+
+void *Arena::allocate(const uint32 size) {
+  char *ptr = align_up(top_);
+  if (top_ == NULL_PTR(char *) || ptr > end_ ||
+      static_cast<uint32>(end_ - ptr) < size) {
+    if (!next_chunk(size)) {
+      return NULL_PTR(void *);
+    }
+    ptr = top_;
+  }
+  top_ = ptr + size;
+  return ptr;
+}
+
+void Arena::deallocate(void *ptr, const uint32 size) {
+  // only the last allocation can be given back
+  if (static_cast<char *>(ptr) + size == top_) {
+    top_ = static_cast<char *>(ptr);
+  }
+}
+
+void Arena::reserve(const uint32 size) {
+  char *ptr = align_up(top_);
+  if (top_ == NULL_PTR(char *) || ptr > end_ ||
+      static_cast<uint32>(end_ - ptr) < size) {
+    (void)next_chunk(size);
+  }
+}
+
+bool Arena::next_chunk(const uint32 size) {
+  chunk_t *prev = current_;
+  chunk_t *next = (prev == NULL_PTR(chunk_t *)) ? first_ : prev->next;
+  // skip the chunks kept by `rewind` that are too small
+  while (next != NULL_PTR(chunk_t *) && next->size < size) {
+    prev = next;
+    next = next->next;
+  }
+  if (next == NULL_PTR(chunk_t *)) {
+    if (!growable_) {
+      return false;
+    }
+    const uint32 chunk_size = size > chunk_size_ ? size : chunk_size_;
+    next = static_cast<chunk_t *>(
+        ::operator new(sizeof(chunk_t) + alignment + chunk_size));
+    next->next = NULL_PTR(chunk_t *);
+    next->size = chunk_size;
+    next->owned = true;
+    if (prev == NULL_PTR(chunk_t *)) {
+      first_ = next;
+    } else {
+      prev->next = next;
+    }
+  }
+  current_ = next;
+  top_ = data(next);
+  end_ = top_ + next->size;
+  return true;
+}
+
+Arena::mark_t Arena::mark() const {
+  mark_t m;
+  m.chunk = current_;
+  m.top = top_;
+  return m;
+}
+
+void Arena::rewind(const mark_t &m) {
+  current_ = m.chunk;
+  top_ = m.top;
+  end_ = (current_ == NULL_PTR(chunk_t *)) ? NULL_PTR(char *)
+                                           : data(current_) + current_->size;
+}
+
+void Arena::reset() {
+  current_ = NULL_PTR(chunk_t *);
+  top_ = NULL_PTR(char *);
+  end_ = NULL_PTR(char *);
+}
+
+uint32 Arena::used() const {
+  uint32 total = 0u;
+  if (current_ != NULL_PTR(chunk_t *)) {
+    for (chunk_t *chunk = first_; chunk != current_; chunk = chunk->next) {
+      total += chunk->size;
+    }
+    total += static_cast<uint32>(top_ - data(current_));
+  }
+  return total;
+}
+
+uint32 Arena::capacity() const {
+  uint32 total = 0u;
+  for (chunk_t *chunk = first_; chunk != NULL_PTR(chunk_t *);
+       chunk = chunk->next) {
+    total += chunk->size;
+  }
+  return total;
+}
+
+} // namespace MARTe
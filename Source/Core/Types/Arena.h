@@ -0,0 +1,137 @@
+#ifndef _ARENA_H__
+#define _ARENA_H__
+
+#include "Allocator.h"
+
+namespace MARTe {
+
+/**
+  @brief bump allocator releasing all its memory at once.
+
+  Memory is carved sequentially from chunks of `chunk_size` bytes (bigger
+  chunks are created for bigger requests), `deallocate` only gives back the
+  last allocation. Everything allocated after a `mark` is released in O(1)
+  by `rewind` (or by `reset` for the whole arena): the chunks are kept and
+  reused by the next allocations, so an arena that already reached its peak
+  usage never touches the heap again.
+
+  An arena created over an external buffer never grows: `allocate` returns
+  null once the buffer is exhausted.
+
+  The destructors of the objects stored in the arena are not called by
+  `rewind`/`reset`, which only release the memory.
+**/
+class Arena : public Allocator {
+  struct chunk_t;
+
+public:
+  /**
+    @brief position in the arena (see `mark` and `rewind`)
+  **/
+  struct mark_t {
+    chunk_t *chunk;
+    char *top;
+  };
+
+  /**
+    @brief empty arena, the first chunk is allocated on the first use
+    @param chunk_size size of the chunks
+  **/
+  explicit Arena(const uint32 chunk_size = default_chunk_size);
+
+  /**
+    @brief fixed size arena over an external buffer
+    @param buffer buffer (never freed by the arena, must outlive it)
+    @param size size of the buffer
+  **/
+  Arena(void *buffer, const uint32 size);
+
+  /**
+    @brief free all the chunks
+  **/
+  virtual ~Arena();
+
+  virtual void *allocate(const uint32 size);
+  virtual void deallocate(void *ptr, const uint32 size);
+
+  /**
+    @brief make sure that `size` bytes can be allocated without growing
+  **/
+  void reserve(const uint32 size);
+
+  /**
+    @brief current position, everything allocated later is released by
+    `rewind`
+  **/
+  mark_t mark() const;
+
+  /**
+    @brief release everything allocated after `m`
+  **/
+  void rewind(const mark_t &m);
+
+  /**
+    @brief release everything, keeping the chunks for reuse
+  **/
+  void reset();
+
+  /**
+    @brief number of bytes in use (padding and skipped chunk tails included)
+  **/
+  uint32 used() const;
+
+  /**
+    @brief number of bytes owned by the arena
+  **/
+  uint32 capacity() const;
+
+  /**
+    @brief alignment of the allocations
+  **/
+  static const uint32 alignment = 16u;
+  static const uint32 default_chunk_size = 4096u;
+
+private:
+  Arena(const Arena &);
+  Arena &operator=(const Arena &);
+
+  struct chunk_t {
+    chunk_t *next;
+    uint32 size;
+    bool owned;
+  };
+
+  static char *data(chunk_t *chunk);
+  bool next_chunk(const uint32 size);
+
+  chunk_t *first_;
+  chunk_t *current_;
+  char *top_;
+  char *end_;
+  uint32 chunk_size_;
+  bool growable_;
+};
+
+/**
+  @brief release the memory allocated in a scope.
+
+  Marks the arena when created and rewinds it when destroyed, e.g. to
+  reuse the same memory at each cycle of a real time thread.
+**/
+class ArenaScope {
+public:
+  inline explicit ArenaScope(Arena &arena)
+      : arena_(arena), mark_(arena.mark()) {}
+  inline ~ArenaScope() { arena_.rewind(mark_); }
+
+private:
+  ArenaScope(const ArenaScope &);
+  ArenaScope &operator=(const ArenaScope &);
+
+  Arena &arena_;
+  Arena::mark_t mark_;
+};
+
+} // namespace MARTe
+
+#endif
@@ -0,0 +1,512 @@
+#ifndef _HASH_MAP_H__
+#define _HASH_MAP_H__
+
+#include "Vec.h"
+
+#include <assert.h>
+#include <new>
+#include <stdint.h>
+
+namespace MARTe {
+
+/**
+  @brief hash function used by `HashMap`.
+
+  By default the key `hash()` method is used (e.g. `Str`, `StrView`),
+  integer and pointer types are hashed by value.
+**/
+template <typename K> struct Hash {
+  static inline uint32 of(const K &key) { return key.hash(); }
+};
+
+/**
+  @brief finaliser of MurmurHash3, mixes all the bits of an integer.
+**/
+inline uint32 hash_mix(uint64 x) {
+  x ^= x >> 33;
+  x *= 0xff51afd7ed558ccdull;
+  x ^= x >> 33;
+  x *= 0xc4ceb9fe1a85ec53ull;
+  x ^= x >> 33;
+  return static_cast<uint32>(x);
+}
+
+#define HASH_INTEGER(type)                                                     \
+  template <> struct Hash<type> {                                              \
+    static inline uint32 of(const type &key) {                                 \
+      return hash_mix(static_cast<uint64>(key));                               \
+    }                                                                          \
+  };
+
+HASH_INTEGER(char8)
+HASH_INTEGER(uint8)
+HASH_INTEGER(int8)
+HASH_INTEGER(uint16)
+HASH_INTEGER(int16)
+HASH_INTEGER(uint32)
+HASH_INTEGER(int32)
+HASH_INTEGER(uint64)
+HASH_INTEGER(int64)
+
+#undef HASH_INTEGER
+
+template <typename T> struct Hash<T *> {
+  static inline uint32 of(T *const &key) {
+    return hash_mix(static_cast<uint64>(reinterpret_cast<uintptr_t>(key)));
+  }
+};
+
+/**
+  @brief associative container with open addressing.
+
+  Robin hood hashing with linear probing: the entries are stored in a
+  single array and, along a probe sequence, sorted by distance from their
+  home slot, so a lookup stops as soon as it meets an entry closer to its
+  home than the searched key would be. Removals shift the following
+  entries back (no tombstones).
+
+  A parallel array stores the (non zero) hash of each slot: empty slots
+  are recognised without touching the entries and keys are compared only
+  if the hashes match. Lookups never allocate; the table is rehashed to
+  double its size when the load factor exceeds 7/8.
+
+  Pointers and references to the values are invalidated by any insertion
+  or removal.
+
+  @param K type of the key (must be comparable with `==`)
+  @param V type of the value
+  @param H hash function (see `Hash`)
+**/
+template <typename K, typename V, typename H = Hash<K> > class HashMap {
+public:
+  /**
+    @brief key-value pair stored in the table
+  **/
+  struct entry_t {
+    K key;
+    V value;
+
+    inline entry_t(const K &k, const V &v) : key(k), value(v) {}
+  };
+
+  /**
+    @brief position in the table.
+
+    Value type (no allocation), invalid once the table is modified.
+  **/
+  class iterator {
+  public:
+    inline iterator() : parent(NULL_PTR(const HashMap *)), pos(0u) {}
+
+    /**
+      @brief key of the current entry
+    **/
+    inline const K &key() const { return entry().key; }
+    /**
+      @brief value of the current entry
+    **/
+    inline V &value() const { return entry().value; }
+    /**
+      @brief current entry
+    **/
+    inline entry_t &operator*() const { return entry(); }
+
+    /**
+      @brief advance to the next entry
+    **/
+    inline iterator &operator++() {
+      pos = parent->next_used(pos + 1u);
+      return *this;
+    }
+
+    inline bool operator==(const iterator &other) const {
+      return parent == other.parent && pos == other.pos;
+    }
+    inline bool operator!=(const iterator &other) const {
+      return !(*this == other);
+    }
+    /**
+      @brief true if the iterator points to an entry
+    **/
+    inline operator bool() const {
+      return parent != NULL_PTR(const HashMap *) && pos < parent->slots_;
+    }
+
+  private:
+    friend class HashMap;
+
+    inline iterator(const HashMap *parent_, const uint32 pos_)
+        : parent(parent_), pos(pos_) {}
+
+    inline entry_t &entry() const {
+      assert(*this);
+      return parent->entries_[pos];
+    }
+
+    const HashMap *parent;
+    uint32 pos;
+  };
+
+  /**
+    @brief empty table (no allocation until the first insertion)
+  **/
+  inline HashMap()
+      : hashes_(NULL_PTR(uint32 *)), entries_(NULL_PTR(entry_t *)),
+        slots_(0u), len_(0u) {}
+
+  /**
+    @brief empty table with room for `size` entries
+  **/
+  inline explicit HashMap(const uint32 size)
+      : hashes_(NULL_PTR(uint32 *)), entries_(NULL_PTR(entry_t *)),
+        slots_(0u), len_(0u) {
+    reserve(size);
+  }
+
+  /**
+    @brief copy constructor
+  **/
+  inline HashMap(const HashMap &other)
+      : hashes_(NULL_PTR(uint32 *)), entries_(NULL_PTR(entry_t *)),
+        slots_(0u), len_(0u) {
+    copy_from(other);
+  }
+
+#if __cplusplus >= 201103L
+  /**
+    @brief move constructor, the other table is left empty
+  **/
+  inline HashMap(HashMap &&other) noexcept
+      : hashes_(other.hashes_), entries_(other.entries_),
+        slots_(other.slots_), len_(other.len_) {
+    other.hashes_ = NULL_PTR(uint32 *);
+    other.entries_ = NULL_PTR(entry_t *);
+    other.slots_ = 0u;
+    other.len_ = 0u;
+  }
+
+  /**
+    @brief move assignment, the other table is left empty
+  **/
+  inline HashMap &operator=(HashMap &&other) noexcept {
+    if (this != &other) {
+      release();
+      hashes_ = other.hashes_;
+      entries_ = other.entries_;
+      slots_ = other.slots_;
+      len_ = other.len_;
+      other.hashes_ = NULL_PTR(uint32 *);
+      other.entries_ = NULL_PTR(entry_t *);
+      other.slots_ = 0u;
+      other.len_ = 0u;
+    }
+    return *this;
+  }
+#endif
+
+  inline ~HashMap() { release(); }
+
+  /**
+    @brief assignment operator
+  **/
+  inline HashMap &operator=(const HashMap &other) {
+    if (this != &other) {
+      release();
+      copy_from(other);
+    }
+    return *this;
+  }
+
+  /**
+    @brief number of entries
+  **/
+  inline uint32 len() const { return len_; }
+  /**
+    @brief true if there are no entries
+  **/
+  inline bool empty() const { return len_ == 0u; }
+  /**
+    @brief number of slots of the table
+  **/
+  inline uint32 capacity() const { return slots_; }
+
+  /**
+    @brief look for a key (no allocation)
+    @return pointer to the value or NULL if the key is not present
+  **/
+  inline V *get(const K &key) {
+    const uint32 i = lookup(key, hash_of(key));
+    return i < slots_ ? &entries_[i].value : NULL_PTR(V *);
+  }
+  inline const V *get(const K &key) const {
+    const uint32 i = lookup(key, hash_of(key));
+    return i < slots_ ? &entries_[i].value : NULL_PTR(const V *);
+  }
+
+  /**
+    @brief look for a key
+    @return copy of the value if the key is present
+  **/
+  inline Option<V> find(const K &key) const {
+    const V *value = get(key);
+    return value == NULL_PTR(const V *) ? Option<V>() : Option<V>(*value);
+  }
+
+  /**
+    @brief check if a key is present
+  **/
+  inline bool contains(const K &key) const {
+    return lookup(key, hash_of(key)) < slots_;
+  }
+
+  /**
+    @brief insert a key or update its value
+    @return true if the key was not present
+  **/
+  inline bool set(const K &key, const V &value) {
+    const uint32 hash = hash_of(key);
+    const uint32 i = lookup(key, hash);
+    if (i < slots_) {
+      entries_[i].value = value;
+      return false;
+    }
+    insert(key, value, hash);
+    return true;
+  }
+
+  /**
+    @brief access the value of a key, inserting a default value if the key
+    is not present
+  **/
+  inline V &operator[](const K &key) {
+    const uint32 hash = hash_of(key);
+    const uint32 i = lookup(key, hash);
+    if (i < slots_) {
+      return entries_[i].value;
+    }
+    const uint32 j = insert(key, V(), hash);
+    return entries_[j].value;
+  }
+
+  /**
+    @brief remove a key
+    @return true if the key was present
+  **/
+  inline bool remove(const K &key) {
+    uint32 i = lookup(key, hash_of(key));
+    if (i >= slots_) {
+      return false;
+    }
+    entries_[i].~entry_t();
+    // shift back the following entries of the probe sequence
+    uint32 j = (i + 1u) & mask();
+    while (hashes_[j] != 0u && distance(j) > 0u) {
+      Ops::relocate(&entries_[i], &entries_[j], 1u);
+      hashes_[i] = hashes_[j];
+      i = j;
+      j = (j + 1u) & mask();
+    }
+    hashes_[i] = 0u;
+    len_--;
+    return true;
+  }
+
+  /**
+    @brief remove all the entries (the table is kept)
+  **/
+  inline void clear() {
+    for (uint32 i = 0u; i < slots_; i++) {
+      if (hashes_[i] != 0u) {
+        entries_[i].~entry_t();
+        hashes_[i] = 0u;
+      }
+    }
+    len_ = 0u;
+  }
+
+  /**
+    @brief make room for `size` entries without rehashing
+  **/
+  inline void reserve(const uint32 size) {
+    uint32 slots = slots_ > 0u ? slots_ : min_slots;
+    while (!fits(size, slots)) {
+      slots *= 2u;
+    }
+    if (slots != slots_) {
+      rehash(slots);
+    }
+  }
+
+  /**
+    @brief rebuild the table with (at least) the given number of slots
+    @param slots number of slots, rounded up to a power of 2 big enough to
+    contain the current entries
+  **/
+  inline void rehash(const uint32 slots) {
+    uint32 n = min_slots;
+    while (n < slots || !fits(len_, n)) {
+      n *= 2u;
+    }
+    uint32 *old_hashes = hashes_;
+    entry_t *old_entries = entries_;
+    const uint32 old_slots = slots_;
+    hashes_ = new uint32[n];
+    memset(hashes_, 0, n * sizeof(uint32));
+    entries_ = static_cast<entry_t *>(::operator new(n * sizeof(entry_t)));
+    slots_ = n;
+    for (uint32 i = 0u; i < old_slots; i++) {
+      if (old_hashes[i] != 0u) {
+        Ops::relocate(&entries_[place(old_hashes[i])], &old_entries[i], 1u);
+      }
+    }
+    delete[] old_hashes;
+    ::operator delete(old_entries);
+  }
+
+  /**
+    @brief iterator to the first entry (in table order)
+  **/
+  inline iterator begin() const { return iterator(this, next_used(0u)); }
+  /**
+    @brief iterator past the last entry
+  **/
+  inline iterator end() const { return iterator(this, slots_); }
+
+private:
+  typedef ArrayOps<entry_t> Ops;
+
+  static const uint32 min_slots = 8u;
+
+  uint32 *hashes_;   // hash of each slot, 0 if empty
+  entry_t *entries_; // only slots with a non zero hash are constructed
+  uint32 slots_;     // power of 2 (or 0)
+  uint32 len_;
+
+  inline uint32 mask() const { return slots_ - 1u; }
+
+  static inline bool fits(const uint32 size, const uint32 slots) {
+    return static_cast<uint64>(size) * 8u <= static_cast<uint64>(slots) * 7u;
+  }
+
+  /**
+    @brief stored hash: the top bit is set so that 0 marks empty slots
+  **/
+  static inline uint32 hash_of(const K &key) {
+    return H::of(key) | 0x80000000u;
+  }
+
+  /**
+    @brief distance of the entry in slot `i` from its home slot
+  **/
+  inline uint32 distance(const uint32 i) const {
+    return (i - hashes_[i]) & mask();
+  }
+
+  /**
+    @brief slot of a key or `slots_` if not present
+  **/
+  inline uint32 lookup(const K &key, const uint32 hash) const {
+    if (len_ == 0u) {
+      return slots_;
+    }
+    uint32 i = hash & mask();
+    for (uint32 dist = 0u; hashes_[i] != 0u && distance(i) >= dist; dist++) {
+      if (hashes_[i] == hash && entries_[i].key == key) {
+        return i;
+      }
+      i = (i + 1u) & mask();
+    }
+    return slots_;
+  }
+
+  /**
+    @brief find the slot of a new entry, shifting forward the entries of
+    the probe sequence closer to their home slot (the slot is returned not
+    constructed)
+  **/
+  inline uint32 place(const uint32 hash) {
+    uint32 i = hash & mask();
+    for (uint32 dist = 0u; hashes_[i] != 0u && distance(i) >= dist; dist++) {
+      i = (i + 1u) & mask();
+    }
+    uint32 j = i;
+    while (hashes_[j] != 0u) {
+      j = (j + 1u) & mask();
+    }
+    while (j != i) {
+      const uint32 k = (j - 1u) & mask();
+      Ops::relocate(&entries_[j], &entries_[k], 1u);
+      hashes_[j] = hashes_[k];
+      j = k;
+    }
+    hashes_[i] = hash;
+    return i;
+  }
+
+  /**
+    @brief insert a key known not to be present
+  **/
+  inline uint32 insert(const K &key, const V &value, const uint32 hash) {
+    const bool grow = slots_ == 0u || !fits(len_ + 1u, slots_);
+    if (grow || owned(&key) || owned(&value)) {
+      // copy first: key and value may be moved by the rehash or the shift
+      entry_t entry(key, value);
+      if (grow) {
+        rehash(slots_ > 0u ? slots_ * 2u : min_slots);
+      }
+      const uint32 i = place(hash);
+      Ops::copy(&entries_[i], &entry, 1u);
+      len_++;
+      return i;
+    }
+    const uint32 i = place(hash);
+    new (&entries_[i]) entry_t(key, value);
+    len_++;
+    return i;
+  }
+
+  /**
+    @brief check if an object is stored in the entries of the table
+  **/
+  inline bool owned(const void *ptr) const {
+    const char8 *p = static_cast<const char8 *>(ptr);
+    const char8 *first = reinterpret_cast<const char8 *>(entries_);
+    return p >= first && p < first + slots_ * sizeof(entry_t);
+  }
+
+  inline uint32 next_used(uint32 i) const {
+    while (i < slots_ && hashes_[i] == 0u) {
+      i++;
+    }
+    return i;
+  }
+
+  inline void copy_from(const HashMap &other) {
+    if (other.slots_ > 0u) {
+      slots_ = other.slots_;
+      hashes_ = new uint32[slots_];
+      memcpy(hashes_, other.hashes_, slots_ * sizeof(uint32));
+      entries_ =
+          static_cast<entry_t *>(::operator new(slots_ * sizeof(entry_t)));
+      for (uint32 i = 0u; i < slots_; i++) {
+        if (hashes_[i] != 0u) {
+          Ops::copy(&entries_[i], &other.entries_[i], 1u);
+        }
+      }
+      len_ = other.len_;
+    }
+  }
+
+  inline void release() {
+    clear();
+    delete[] hashes_;
+    ::operator delete(entries_);
+    hashes_ = NULL_PTR(uint32 *);
+    entries_ = NULL_PTR(entry_t *);
+    slots_ = 0u;
+  }
+};
+
+} // namespace MARTe
+
+#endif
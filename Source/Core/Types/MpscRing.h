@@ -0,0 +1,216 @@
+#ifndef _MPSC_RING_H__
+#define _MPSC_RING_H__
+
+#include "Allocator.h"
+#include "RingSignal.h"
+
+#include <assert.h>
+#include <new>
+
+namespace MARTe {
+
+/**
+  @brief bounded multiple producers, single consumer queue.
+
+  Lock-free: producers reserve their slots with a compare and swap on the
+  tail index (retried only if another producer won the race), write them
+  and mark each slot as ready with its sequence number, so that a producer
+  preempted while writing never blocks the others. The consumer reads the
+  slots in order and frees them by publishing its head index. A batch of
+  elements pushed by `push(items, count)` is reserved with a single compare
+  and swap and stays contiguous in the ring.
+
+  A blocking ring (constructor flag) lets the consumer sleep in `pop_wait`
+  until an element is pushed, at the cost of a memory barrier per push.
+
+  @param T type of the elements (copied in and out of the ring)
+**/
+template <typename T> class MpscRing {
+public:
+  /**
+    @brief empty ring
+    @param capacity number of elements (rounded up to a power of 2)
+    @param blocking if true the consumer can wait with `pop_wait`
+    @param allocator source of the slots (heap if null), the capacity is 0
+    if it is exhausted
+  **/
+  inline explicit MpscRing(const uint32 capacity, const bool blocking = false,
+                           Allocator *allocator = NULL_PTR(Allocator *))
+      : tail_(0u), head_(0u), mask_(round_up(capacity) - 1u),
+        blocking_(blocking), allocator_(allocator),
+        slots_(static_cast<slot_t *>(
+            allocate(allocator, (mask_ + 1u) * sizeof(slot_t)))),
+        size_(slots_ != NULL_PTR(slot_t *) ? mask_ + 1u : 0u) {
+    for (uint32 i = 0u; i < size_; i++) {
+      // not ready for the first round (ready when seq == index + 1)
+      slots_[i].seq = i;
+    }
+  }
+
+  /**
+    @brief destroy the elements still in the ring
+  **/
+  inline ~MpscRing() {
+    for (uint32 i = head_; i != tail_; i++) {
+      slot_t &s = slots_[i & mask_];
+      if (s.seq == i + 1u) {
+        s.get()->~T();
+      }
+    }
+    deallocate(allocator_, slots_, (mask_ + 1u) * sizeof(slot_t));
+  }
+
+  /**
+    @brief add an element (any thread)
+    @return false if the ring is full
+  **/
+  inline bool push(const T &item) { return push(&item, 1u) == 1u; }
+
+  /**
+    @brief add up to `count` contiguous elements (any thread)
+    @return number of elements added
+  **/
+  inline uint32 push(const T *items, const uint32 count) {
+    uint32 tail = RingAtomic::load_relaxed(tail_);
+    uint32 n;
+    do {
+      const uint32 used = tail - RingAtomic::load_acquire(head_);
+      n = size_ - used;
+      n = n < count ? n : count;
+      if (n == 0u) {
+        return 0u;
+      }
+    } while (!RingAtomic::compare_exchange(tail_, tail, tail + n));
+    for (uint32 i = 0u; i < n; i++) {
+      slot_t &s = slots_[(tail + i) & mask_];
+      new (s.get()) T(items[i]);
+      RingAtomic::store_release(s.seq, tail + i + 1u);
+    }
+    if (blocking_) {
+      signal_.notify();
+    }
+    return n;
+  }
+
+  /**
+    @brief remove the oldest element (single consumer)
+    @return false if the ring is empty (or the oldest element is still
+    being written)
+  **/
+  inline bool pop(T &item) { return pop(&item, 1u) == 1u; }
+
+  /**
+    @brief remove up to `max` elements (single consumer)
+    @return number of elements removed
+  **/
+  inline uint32 pop(T *items, const uint32 max) {
+    const uint32 head = head_;
+    uint32 n = 0u;
+    while (n < max && size_ > 0u) {
+      slot_t &s = slots_[(head + n) & mask_];
+      if (RingAtomic::load_acquire(s.seq) != head + n + 1u) {
+        break;
+      }
+      T *value = s.get();
+      items[n] = *value;
+      value->~T();
+      n++;
+    }
+    if (n > 0u) {
+      RingAtomic::store_release(head_, head + n);
+    }
+    return n;
+  }
+
+  /**
+    @brief remove the oldest element, waiting for it if the ring is empty
+    (single consumer, blocking rings only)
+    @param timeout_us maximum waiting time in microseconds
+    @return false if the ring is still empty after the timeout
+  **/
+  inline bool pop_wait(T &item, const uint32 timeout_us) {
+    return pop_wait(&item, 1u, timeout_us) == 1u;
+  }
+
+  /**
+    @brief remove up to `max` elements, waiting for at least one if the
+    ring is empty (single consumer, blocking rings only)
+    @param timeout_us maximum waiting time in microseconds
+    @return number of elements removed (0 after the timeout, or if woken
+    up while the oldest element is still being written)
+  **/
+  inline uint32 pop_wait(T *items, const uint32 max,
+                         const uint32 timeout_us) {
+    assert(blocking_);
+    uint32 n = pop(items, max);
+    if (n == 0u) {
+      const uint32 seq = signal_.prepare();
+      n = pop(items, max);
+      if (n == 0u && signal_.wait(seq, timeout_us)) {
+        n = pop(items, max);
+      }
+      signal_.done();
+    }
+    return n;
+  }
+
+  /**
+    @brief number of elements reserved by the producers (approximated
+    while the ring is in use)
+  **/
+  inline uint32 len() const {
+    return RingAtomic::load_acquire(tail_) - RingAtomic::load_acquire(head_);
+  }
+
+  /**
+    @brief true if the ring has no element
+  **/
+  inline bool empty() const { return len() == 0u; }
+
+  /**
+    @brief maximum number of elements
+  **/
+  inline uint32 capacity() const { return size_; }
+
+private:
+  MpscRing(const MpscRing &);
+  MpscRing &operator=(const MpscRing &);
+
+  struct slot_t {
+    volatile uint32 seq; // index + 1 of the element once written
+    union {
+      char bytes[sizeof(T)];
+      double align_double_;
+      uint64 align_uint64_;
+      void *align_ptr_;
+    } storage;
+
+    inline T *get() { return reinterpret_cast<T *>(storage.bytes); }
+  };
+
+  static inline uint32 round_up(const uint32 capacity) {
+    uint32 size = 2u;
+    while (size < capacity) {
+      size *= 2u;
+    }
+    return size;
+  }
+
+  char pad0_[RING_CACHE_LINE_SIZE];
+  // producers side
+  volatile uint32 tail_;
+  char pad1_[RING_CACHE_LINE_SIZE];
+  // consumer side
+  volatile uint32 head_;
+  char pad2_[RING_CACHE_LINE_SIZE];
+  const uint32 mask_;
+  const bool blocking_;
+  Allocator *allocator_;
+  slot_t *slots_;
+  const uint32 size_; // number of slots (0 without slots)
+  RingSignal signal_;
+};
+
+} // namespace MARTe
+
+#endif
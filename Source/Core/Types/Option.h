@@ -2,6 +2,7 @@
 #define OPTION_H__
 #include "CompilerTypes.h"
 #include <assert.h>
+#include <new>
 
 namespace MARTe {
 
@@ -19,11 +20,12 @@ namespace MARTe {
   value stored inside it is possible to use the method `val()` or casting it to
   `T`.
 
+  The value is stored inside the container: creating an Option never
+  allocates.
+
 */
 
 template <typename T> class Option {
-  T *mem;
-
 public:
   static inline Option<T> maybe(T (*fn)(T), const Option<T> &x) {
     if (x.empty()) {
@@ -37,28 +39,21 @@ public:
 
     @param val the value to be stored.
   */
-  inline Option(const T &val) : mem(new T(val)) {}
+  inline Option(const T &val) : full_(true) { new (get()) T(val); }
   /**
     @brief Constructor of an empty Optional.
   */
-  inline Option() : mem(NULL_PTR(T *)) {}
+  inline Option() : full_(false) {}
   /**
     @brief Copy constructor.
     **/
-  inline Option(const Option &other) {
-    if (other.mem == NULL_PTR(T *)) {
-      mem = NULL_PTR(T *);
-    } else {
-      mem = new T(*other.mem);
+  inline Option(const Option &other) : full_(other.full_) {
+    if (full_) {
+      new (get()) T(*other.get());
     }
   }
 
-  inline ~Option() {
-    if (mem != NULL_PTR(T *)) {
-      delete mem;
-      mem = NULL_PTR(T *);
-    }
-  }
+  inline ~Option() { clear(); }
 
   /**
     @brief Checks if the Optional container is
@@ -66,7 +61,7 @@ public:
     @return true if it is empty.
     @return false if it is full.
   */
-  inline bool empty() const { return mem == NULL_PTR(T *); }
+  inline bool empty() const { return !full_; }
 
   /**
     @brief Retrives the value contained in the
@@ -74,12 +69,12 @@ public:
     @return the value stored.
   */
   inline T &val() {
-    assert(mem != NULL_PTR(T *));
-    return *mem;
+    assert(full_);
+    return *get();
   }
   inline const T const_val() const {
-    assert(mem != NULL_PTR(T *));
-    return *mem;
+    assert(full_);
+    return *get();
   }
   /**
     @brief Checks if the optional container is full
@@ -87,7 +82,7 @@ public:
     @return false if full
     @return true if empty
   */
-  inline bool operator!() const { return mem == NULL_PTR(T *); }
+  inline bool operator!() const { return !full_; }
 
   /**
     @brief Retrieves the value contained.
@@ -101,10 +96,11 @@ public:
     @return updated optional value
   **/
   inline Option &operator=(const T &other) {
-    if (mem == NULL_PTR(T *)) {
-      mem = new T(other);
+    if (full_) {
+      *get() = other;
     } else {
-      *mem = other;
+      new (get()) T(other);
+      full_ = true;
     }
     return *this;
   }
@@ -113,7 +109,7 @@ public:
     @brief convert optional to bool, by checking if it is assigned or not.
     @return true if is not empty.
   **/
-  inline operator bool() const { return mem != NULL_PTR(T *); }
+  inline operator bool() const { return full_; }
 
   /**
     @brief assign operator
@@ -121,15 +117,37 @@ public:
     @return updated optional value
   **/
   inline Option &operator=(const Option &other) {
-    if (mem != NULL_PTR(T *)) {
-      delete mem;
-      mem = NULL_PTR(T *);
-    }
-    if (other.mem != NULL_PTR(T *)) {
-      mem = new T(*other.mem);
+    if (&other != this) {
+      if (other.full_) {
+        *this = *other.get();
+      } else {
+        clear();
+      }
     }
     return *this;
   }
+
+private:
+  inline T *get() { return reinterpret_cast<T *>(storage_.bytes); }
+  inline const T *get() const {
+    return reinterpret_cast<const T *>(storage_.bytes);
+  }
+
+  inline void clear() {
+    if (full_) {
+      get()->~T();
+      full_ = false;
+    }
+  }
+
+  // the value is stored inline, no heap allocation
+  union {
+    char bytes[sizeof(T)];
+    double align_double_;
+    uint64 align_uint64_;
+    void *align_ptr_;
+  } storage_;
+  bool full_;
 };
 
 } // namespace MARTe
@@ -0,0 +1,198 @@
+#ifndef _POOL_H__
+#define _POOL_H__
+
+#include "Allocator.h"
+
+namespace MARTe {
+
+/**
+  @brief fixed size allocator of objects of type T.
+
+  Slots are allocated in blocks of `block_len` elements and recycled through
+  a free list, so that `alloc`/`free` are O(1) and never touch the heap as
+  long as the number of live objects stays within the reserved capacity
+  (e.g. `reserve` in `Setup`, `create`/`destroy` in `Execute`).
+
+  The blocks are freed with the pool: objects still alive are not
+  destroyed. If the allocator is exhausted `alloc` and `create` return null.
+
+  @param T type of the objects
+**/
+template <typename T> class Pool {
+public:
+  /**
+    @brief empty pool
+    @param block_len number of slots allocated at once
+    @param allocator source of the blocks (heap if null)
+  **/
+  inline explicit Pool(const uint32 block_len = 32u,
+                       Allocator *allocator = NULL_PTR(Allocator *))
+      : blocks_(NULL_PTR(block_t *)), free_(NULL_PTR(slot_t *)),
+        block_len_(block_len > 0u ? block_len : 1u), available_(0u),
+        capacity_(0u), allocator_(allocator) {}
+
+  /**
+    @brief free all the blocks
+  **/
+  inline ~Pool() {
+    while (blocks_ != NULL_PTR(block_t *)) {
+      block_t *next = blocks_->next;
+      deallocate(allocator_, blocks_, block_size(blocks_->len));
+      blocks_ = next;
+    }
+  }
+
+  /**
+    @brief uninitialised memory for an object
+    @return the memory, null if the allocator is exhausted
+  **/
+  inline T *alloc() {
+    if (free_ == NULL_PTR(slot_t *) && !grow(block_len_)) {
+      return NULL_PTR(T *);
+    }
+    slot_t *slot = free_;
+    free_ = slot->next;
+    available_--;
+    return reinterpret_cast<T *>(slot->bytes);
+  }
+
+  /**
+    @brief give back the memory of an object (already destroyed)
+  **/
+  inline void free(T *ptr) {
+    if (ptr != NULL_PTR(T *)) {
+      slot_t *slot = reinterpret_cast<slot_t *>(ptr);
+      slot->next = free_;
+      free_ = slot;
+      available_++;
+    }
+  }
+
+#if __cplusplus >= 201103L
+  /**
+    @brief create an object in the pool
+    @param args arguments forwarded to the constructor of T
+    @return the object, null if the allocator is exhausted
+  **/
+  template <typename... Args> inline T *create(Args &&...args) {
+    T *ptr = alloc();
+    return ptr != NULL_PTR(T *) ? new (ptr) T(static_cast<Args &&>(args)...)
+                                : ptr;
+  }
+#else
+  /**
+    @brief create an object in the pool
+    @return the object, null if the allocator is exhausted
+  **/
+  inline T *create() {
+    T *ptr = alloc();
+    return ptr != NULL_PTR(T *) ? new (ptr) T() : ptr;
+  }
+
+  template <typename A1> inline T *create(const A1 &a1) {
+    T *ptr = alloc();
+    return ptr != NULL_PTR(T *) ? new (ptr) T(a1) : ptr;
+  }
+
+  template <typename A1, typename A2>
+  inline T *create(const A1 &a1, const A2 &a2) {
+    T *ptr = alloc();
+    return ptr != NULL_PTR(T *) ? new (ptr) T(a1, a2) : ptr;
+  }
+
+  template <typename A1, typename A2, typename A3>
+  inline T *create(const A1 &a1, const A2 &a2, const A3 &a3) {
+    T *ptr = alloc();
+    return ptr != NULL_PTR(T *) ? new (ptr) T(a1, a2, a3) : ptr;
+  }
+
+  template <typename A1, typename A2, typename A3, typename A4>
+  inline T *create(const A1 &a1, const A2 &a2, const A3 &a3, const A4 &a4) {
+    T *ptr = alloc();
+    return ptr != NULL_PTR(T *) ? new (ptr) T(a1, a2, a3, a4) : ptr;
+  }
+#endif
+
+  /**
+    @brief destroy an object created by `create` and free its slot
+  **/
+  inline void destroy(T *ptr) {
+    if (ptr != NULL_PTR(T *)) {
+      ptr->~T();
+      free(ptr);
+    }
+  }
+
+  /**
+    @brief make sure that `count` objects can be allocated without growing
+    @return false if the allocator is exhausted
+  **/
+  inline bool reserve(const uint32 count) {
+    return count <= available_ || grow(count - available_);
+  }
+
+  /**
+    @brief number of slots that can be allocated without growing
+  **/
+  inline uint32 available() const { return available_; }
+
+  /**
+    @brief total number of slots
+  **/
+  inline uint32 capacity() const { return capacity_; }
+
+private:
+  Pool(const Pool &);
+  Pool &operator=(const Pool &);
+
+  union slot_t {
+    slot_t *next;
+    char bytes[sizeof(T)];
+    double align_double_;
+    uint64 align_uint64_;
+    void *align_ptr_;
+  };
+
+  struct block_t {
+    block_t *next;
+    uint32 len;
+    slot_t slots[1];
+  };
+
+  static inline uint32 block_size(const uint32 len) {
+    return sizeof(block_t) + (len - 1u) * sizeof(slot_t);
+  }
+
+  /**
+    @brief allocate a block of `len` slots and add them to the free list
+    @return false if the allocator is exhausted
+  **/
+  inline bool grow(const uint32 len) {
+    block_t *block =
+        static_cast<block_t *>(allocate(allocator_, block_size(len)));
+    if (block == NULL_PTR(block_t *)) {
+      return false;
+    }
+    block->next = blocks_;
+    block->len = len;
+    blocks_ = block;
+    for (uint32 i = len; i > 0u; i--) {
+      block->slots[i - 1u].next = free_;
+      free_ = &block->slots[i - 1u];
+    }
+    available_ += len;
+    capacity_ += len;
+    return true;
+  }
+
+  block_t *blocks_;
+  slot_t *free_;
+  uint32 block_len_;
+  uint32 available_;
+  uint32 capacity_;
+  Allocator *allocator_;
+};
+
+} // namespace MARTe
+
+#endif
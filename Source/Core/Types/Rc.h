@@ -2,9 +2,72 @@
 #define _EC_PTR_H__
 #include "CompilerTypes.h"
 #include <assert.h>
+#include <new>
 
 namespace MARTe {
 
+/**
+ @brief reference counters shared by all the smart pointers of an object.
+
+ The object is destroyed when `strong` reaches 0, the control block when
+ both `strong` and `weak` reach 0.
+**/
+struct RcCounts {
+  uint32 strong; //!< number of hard references
+  uint32 weak;   //!< number of weak references
+  void (*dispose)(RcCounts *counts); //!< destroy the object
+  void (*release)(RcCounts *counts); //!< free the control block
+
+  inline RcCounts(void (*dispose_)(RcCounts *), void (*release_)(RcCounts *))
+      : strong(1u), weak(0u), dispose(dispose_), release(release_) {}
+};
+
+/**
+ @brief control block holding the counters and the object storage.
+
+ Allocated by `make_rc` so that the object and its counters are created with
+ a single allocation (and share the same cache lines).
+**/
+template <typename T> struct RcBlock : public RcCounts {
+  inline RcBlock() : RcCounts(&destroy_value, &free_block) {}
+
+  inline T *get() { return reinterpret_cast<T *>(storage_.bytes); }
+
+private:
+  static void destroy_value(RcCounts *counts) {
+    static_cast<RcBlock *>(counts)->get()->~T();
+  }
+
+  static void free_block(RcCounts *counts) {
+    delete static_cast<RcBlock *>(counts);
+  }
+
+  union {
+    char bytes[sizeof(T)];
+    double align_double_;
+    uint64 align_uint64_;
+    void *align_ptr_;
+  } storage_;
+};
+
+/**
+ @brief control block of an object allocated by the user.
+**/
+template <typename T> struct RcPtrBlock : public RcCounts {
+  inline RcPtrBlock(T *p) : RcCounts(&delete_ptr, &free_block), ptr(p) {}
+
+private:
+  static void delete_ptr(RcCounts *counts) {
+    delete static_cast<RcPtrBlock *>(counts)->ptr;
+  }
+
+  static void free_block(RcCounts *counts) {
+    delete static_cast<RcPtrBlock *>(counts);
+  }
+
+  T *ptr;
+};
+
 /**
  @brief a simple smart pointer.
 
@@ -18,45 +81,39 @@ namespace MARTe {
  When weak the reference counter is not increased but
  instead a weak counter is increased.
 
- An additional boolean pointer shared between hard and weak
- pointer is used to verify if the pointer has been
- nullified or not.
+ Both counters live in a single control block shared between hard and weak
+ pointers: the pointer is null once the hard counter reaches 0, while the
+ block is freed once the last weak pointer is gone. Use `make_rc` to
+ allocate the object inside the control block.
 **/
 template <typename T> class Rc {
 protected:
   inline uint32 &GetRefCounter() {
-    assert(refCounter_ != NULL_PTR(uint32 *));
-    return *refCounter_;
+    assert(counts_ != NULL_PTR(RcCounts *));
+    return counts_->strong;
   }
 
   inline uint32 &GetWeakCounter() {
-    assert(weakCounter_ != NULL_PTR(uint32 *));
-    return *weakCounter_;
+    assert(counts_ != NULL_PTR(RcCounts *));
+    return counts_->weak;
   }
 
 private:
   T *pointer_;
-  uint32 *refCounter_;
-  uint32 *weakCounter_;
-  bool *isNull_;
+  RcCounts *counts_;
   bool isWeak_;
 
   /**
-   * @brief free weak memory
-   *
-   * free the additional weak pointer information once are not needed
-   * any more.
-   *
-   * The fileds to delete are:
-   *  - `isNull_`
-   *  - `weakCounter_`
-   **/
-  inline void free_weak() {
-    delete weakCounter_;
-    delete isNull_;
-    weakCounter_ = NULL_PTR(uint32 *);
-    isNull_ = NULL_PTR(bool *);
-    pointer_ = NULL_PTR(T *);
+   * @brief take one more reference (hard or weak) on the control block.
+   **/
+  inline void referenciate() {
+    if (counts_ != NULL_PTR(RcCounts *)) {
+      if (isWeak_) {
+        counts_->weak++;
+      } else {
+        counts_->strong++;
+      }
+    }
   }
 
   /**
@@ -64,35 +121,71 @@ private:
    *
    * This method will automatically called when the smart pointer is out of
    *scope, if it is an hard link it will automatically decount the reference
-   *counter and if it reaches 0 it will free the memory.
+   *counter and if it reaches 0 it will free the memory. The control block is
+   *freed when no hard nor weak reference is left.
    **/
   inline void dereferenciate() {
-    if (!isWeak_ && refCounter_ != NULL_PTR(uint32 *)) {
-      *refCounter_ = *refCounter_ - 1;
-      if (*refCounter_ <= 0) {
-        delete refCounter_;
-        delete pointer_;
-        pointer_ = NULL_PTR(T *);
-        refCounter_ = NULL_PTR(uint32 *);
-        *isNull_ = true;
-      }
-    } else if (isWeak_ && weakCounter_ != NULL_PTR(uint32 *)) {
-      *weakCounter_ = *weakCounter_ - 1;
+    RcCounts *counts = counts_;
+    pointer_ = NULL_PTR(T *);
+    counts_ = NULL_PTR(RcCounts *);
+    if (counts == NULL_PTR(RcCounts *)) {
+      return;
     }
-
-    if (weakCounter_ != NULL_PTR(uint32 *) && *weakCounter_ <= 0 &&
-        (isNull_ == NULL_PTR(bool *) || *isNull_)) {
-      free_weak();
+    if (isWeak_) {
+      counts->weak--;
+    } else if (--counts->strong == 0u) {
+      // the object may own weak references to itself: keep the block alive
+      counts->weak++;
+      counts->dispose(counts);
+      counts->weak--;
+    }
+    if (counts->strong == 0u && counts->weak == 0u) {
+      counts->release(counts);
     }
   }
 
+  /**
+   * @brief share the control block of the other pointer.
+   **/
+  inline void share(const Rc &other, const bool weak) {
+    pointer_ = other.pointer_;
+    counts_ = other.counts_;
+    isWeak_ = weak;
+    referenciate();
+  }
+
+  /**
+   * @brief exchange the content of two pointers (no counter is changed).
+   **/
+  inline void swap(Rc &other) {
+    T *pointer = pointer_;
+    RcCounts *counts = counts_;
+    const bool weak = isWeak_;
+    pointer_ = other.pointer_;
+    counts_ = other.counts_;
+    isWeak_ = other.isWeak_;
+    other.pointer_ = pointer;
+    other.counts_ = counts;
+    other.isWeak_ = weak;
+  }
+
+  /**
+   * @brief initialise the pointer with a new object stored in the control
+   *block.
+   **/
+  inline void create(const T &v) {
+    RcBlock<T> *block = new RcBlock<T>();
+    pointer_ = new (block->get()) T(v);
+    counts_ = block;
+    isWeak_ = false;
+  }
+
 public:
   /**
    * @brief Create a null pointer.
    **/
   inline Rc()
-      : pointer_(NULL_PTR(T *)), refCounter_(NULL_PTR(uint32 *)),
-        weakCounter_(NULL_PTR(uint32 *)), isNull_(NULL_PTR(bool *)),
+      : pointer_(NULL_PTR(T *)), counts_(NULL_PTR(RcCounts *)),
         isWeak_(false) {}
   /**
    * @brief Create a smart pointer from a regular pointer.
@@ -101,33 +194,26 @@ public:
    **/
   inline Rc(T *p)
       : pointer_(p),
-        refCounter_(p == NULL_PTR(T *) ? NULL_PTR(uint32 *) : new uint32(1)),
-        weakCounter_(p == NULL_PTR(T *) ? NULL_PTR(uint32 *) : new uint32(0)),
-        isNull_(p == NULL_PTR(T *) ? NULL_PTR(bool *) : new bool(false)),
+        counts_(p == NULL_PTR(T *) ? NULL_PTR(RcCounts *)
+                                   : new RcPtrBlock<T>(p)),
         isWeak_(false) {}
+  /**
+   * @brief Create a smart pointer owning a control block built by
+   *`make_rc` (the object must be already constructed).
+   **/
+  inline explicit Rc(RcBlock<T> *block)
+      : pointer_(block->get()), counts_(block), isWeak_(false) {}
   /**
    * @brief Create a smart pointer from a value.
    **/
-  inline Rc(const T &v) {
-    pointer_ = new T(v);
-    refCounter_ = new uint32(1);
-    isWeak_ = false;
-    weakCounter_ = new uint32(0);
-    isNull_ = new bool(false);
-  }
+  inline Rc(const T &v) { create(v); }
   /**
    * @brief Copy constructor, if not null will increase the counter.
    **/
   inline Rc(const Rc &other)
-      : pointer_(other.pointer_), refCounter_(other.refCounter_),
-        weakCounter_(other.weakCounter_), isNull_(other.isNull_),
+      : pointer_(other.pointer_), counts_(other.counts_),
         isWeak_(other.isWeak_) {
-    if (other.refCounter_ != NULL_PTR(uint32 *) && !other.isWeak_ &&
-        this != &other) {
-      *other.refCounter_ = *other.refCounter_ + 1;
-    } else if (other.isWeak_ && !other.isNull()) {
-      *other.weakCounter_ = *other.weakCounter_ + 1;
-    }
+    referenciate();
   }
   /**
    * @brief dereferenciate pointer.
@@ -137,7 +223,9 @@ public:
   /**
    * @brief check if pointer is null.
    **/
-  inline bool isNull() const { return isNull_ == NULL_PTR(bool *) || *isNull_; }
+  inline bool isNull() const {
+    return counts_ == NULL_PTR(RcCounts *) || counts_->strong == 0u;
+  }
   /**
    * @brief check if pointer is weak.
    **/
@@ -157,11 +245,7 @@ public:
       *pointer_ = other;
     } else {
       dereferenciate();
-      pointer_ = new T(other);
-      refCounter_ = new uint32(1);
-      isWeak_ = false;
-      weakCounter_ = new uint32(0);
-      isNull_ = new bool(false);
+      create(other);
     }
     return *this;
   }
@@ -174,24 +258,12 @@ public:
     if (other.pointer_ == pointer_) {
       return *this;
     }
-    dereferenciate();
-    if (other.isNull()) {
-      pointer_ = NULL_PTR(T *);
-      refCounter_ = NULL_PTR(uint32 *);
-      weakCounter_ = NULL_PTR(uint32 *);
-      isNull_ = NULL_PTR(bool *);
-    } else {
-      pointer_ = other.pointer_;
-      refCounter_ = other.refCounter_;
-      weakCounter_ = other.weakCounter_;
-      isNull_ = other.isNull_;
-      isWeak_ = other.isWeak_;
-      if (other.isWeak_) {
-        *weakCounter_ = *weakCounter_ + 1;
-      } else {
-        *refCounter_ = *refCounter_ + 1;
-      }
+    // referenciate first: `other` may be owned by the current object
+    Rc tmp;
+    if (!other.isNull()) {
+      tmp.share(other, other.isWeak_);
     }
+    swap(tmp);
     return *this;
   }
 
@@ -203,15 +275,12 @@ public:
     if (other.pointer_ == pointer_) {
       return *this;
     }
-    dereferenciate();
-    pointer_ = other.pointer_;
-    refCounter_ = other.refCounter_;
-    isNull_ = other.isNull_;
-    weakCounter_ = other.weakCounter_;
-    isWeak_ = true;
+    Rc tmp;
+    tmp.isWeak_ = true;
     if (!other.isNull()) {
-      *weakCounter_ = *weakCounter_ + 1;
+      tmp.share(other, true);
     }
+    swap(tmp);
     return *this;
   }
 
@@ -271,16 +340,10 @@ public:
    * @brief Create a weak pointer from an hard (or weak) pointer.
    **/
   inline Rc<T> operator~() const {
-    if (isNull()) {
-      return Rc<T>();
-    }
     Rc<T> res;
-    res.pointer_ = pointer_;
-    res.refCounter_ = refCounter_;
-    res.isWeak_ = true;
-    res.weakCounter_ = weakCounter_;
-    res.isNull_ = isNull_;
-    *weakCounter_ = *weakCounter_ + 1;
+    if (!isNull()) {
+      res.share(*this, true);
+    }
     return res;
   }
 
@@ -288,16 +351,10 @@ public:
    * @brief Create a hard pointer from an hard (or weak) pointer.
    **/
   inline Rc<T> operator+() const {
-    if (isNull()) {
-      return Rc<T>();
-    }
     Rc<T> res;
-    res.pointer_ = pointer_;
-    res.refCounter_ = refCounter_;
-    res.isWeak_ = false;
-    res.weakCounter_ = weakCounter_;
-    res.isNull_ = isNull_;
-    *refCounter_ = *refCounter_ + 1;
+    if (!isNull()) {
+      res.share(*this, false);
+    }
     return res;
   }
 
@@ -319,15 +376,7 @@ public:
   /**
    * @brief Manually nullify pointer.
    **/
-  inline void del() {
-    if (!isNull()) {
-      dereferenciate();
-      pointer_ = NULL_PTR(T *);
-      refCounter_ = NULL_PTR(uint32 *);
-      weakCounter_ = NULL_PTR(uint32 *);
-      isNull_ = NULL_PTR(bool *);
-    }
-  }
+  inline void del() { dereferenciate(); }
 
   /**
    * @brief access pointer value.
@@ -344,7 +393,7 @@ public:
     if (isNull()) {
       return 0u;
     }
-    return *refCounter_;
+    return counts_->strong;
   }
 
   /**
@@ -354,10 +403,61 @@ public:
     if (isNull()) {
       return 0u;
     }
-    return *weakCounter_;
+    return counts_->weak;
   }
 };
 
+#if __cplusplus >= 201103L
+/**
+ * @brief Create an object and its reference counters with a single
+ *allocation.
+ * @param args arguments forwarded to the constructor of T
+ **/
+template <typename T, typename... Args> inline Rc<T> make_rc(Args &&...args) {
+  RcBlock<T> *block = new RcBlock<T>();
+  new (block->get()) T(static_cast<Args &&>(args)...);
+  return Rc<T>(block);
+}
+#else
+/**
+ * @brief Create an object and its reference counters with a single
+ *allocation.
+ **/
+template <typename T> inline Rc<T> make_rc() {
+  RcBlock<T> *block = new RcBlock<T>();
+  new (block->get()) T();
+  return Rc<T>(block);
+}
+
+template <typename T, typename A1> inline Rc<T> make_rc(const A1 &a1) {
+  RcBlock<T> *block = new RcBlock<T>();
+  new (block->get()) T(a1);
+  return Rc<T>(block);
+}
+
+template <typename T, typename A1, typename A2>
+inline Rc<T> make_rc(const A1 &a1, const A2 &a2) {
+  RcBlock<T> *block = new RcBlock<T>();
+  new (block->get()) T(a1, a2);
+  return Rc<T>(block);
+}
+
+template <typename T, typename A1, typename A2, typename A3>
+inline Rc<T> make_rc(const A1 &a1, const A2 &a2, const A3 &a3) {
+  RcBlock<T> *block = new RcBlock<T>();
+  new (block->get()) T(a1, a2, a3);
+  return Rc<T>(block);
+}
+
+template <typename T, typename A1, typename A2, typename A3, typename A4>
+inline Rc<T> make_rc(const A1 &a1, const A2 &a2, const A3 &a3,
+                     const A4 &a4) {
+  RcBlock<T> *block = new RcBlock<T>();
+  new (block->get()) T(a1, a2, a3, a4);
+  return Rc<T>(block);
+}
+#endif
+
 } // namespace MARTe
 
 #endif
@@ -2,6 +2,7 @@
 #define RESULT_H__
 #include "ErrorType.h"
 #include <assert.h>
+#include <new>
 
 namespace MARTe {
 
@@ -37,33 +38,19 @@ namespace MARTe {
 */
 template <typename T, typename E = ErrorManagement::ErrorType> class Result {
 public:
-  inline static Result<T, E> Succ(const T &value) {
-    Result r;
-    r.ok_ = true;
-    r.res_ = new T(value);
-    return r;
-  }
+  inline static Result<T, E> Succ(const T &value) { return Result(value); }
   inline static Result<T, E> Fail(const E &error) {
     Result r;
-    r.ok_ = false;
-    r.res_ = new E(error);
+    new (r.error()) E(error);
     return r;
   }
   /**
     @brief copy constructor
     @param other result to be copied
   **/
-  inline Result(const Result &other) : ok_(other.ok_), res_(NULL_PTR(void *)) {
-    if (other.res_ != NULL_PTR(void *)) {
-      if (ok_) {
-        res_ = new T(*(T *)other.res_);
-      } else {
-        res_ = new E(*(E *)other.res_);
-      }
-    }
-  }
+  inline Result(const Result &other) : ok_(other.ok_) { copy_res(other); }
 
-  inline Result(const T &value) : ok_(true) { res_ = new T(value); }
+  inline Result(const T &value) : ok_(true) { new (value_ptr()) T(value); }
   /**
     @brief destructor
   **/
@@ -76,7 +63,7 @@ public:
     */
   inline T val() const {
     assert(ok_);
-    return *(T *)res_;
+    return *value_ptr();
   }
 
   /**
@@ -86,7 +73,7 @@ public:
     */
   inline const E err() const {
     assert(!ok_);
-    return *(E *)res_;
+    return *error();
   }
 
   /**
@@ -119,7 +106,7 @@ public:
   **/
   inline T operator+() const {
     assert(ok_);
-    return *(T *)res_;
+    return *value_ptr();
   }
 
   /**
@@ -129,7 +116,7 @@ public:
   **/
   inline const E operator-() const {
     assert(!ok_);
-    return *(E *)res_;
+    return *error();
   }
 
   /**
@@ -139,36 +126,52 @@ public:
   **/
   inline Result &operator=(const Result &other) {
     if (&other != this) {
-      ok_ = other.ok_;
+      // destroy the current content before changing `ok_`
       clear_res();
-      if (other.res_ != NULL_PTR(void *)) {
-        if (ok_) {
-          res_ = new T(*(T *)other.res_);
-        } else {
-          res_ = new E(*(E *)other.res_);
-        }
-      }
+      ok_ = other.ok_;
+      copy_res(other);
     }
 
     return *this;
   }
 
 private:
-  bool ok_;
-  void *res_;
-  inline void clear_res() {
+  inline T *value_ptr() { return reinterpret_cast<T *>(storage_.bytes); }
+  inline const T *value_ptr() const {
+    return reinterpret_cast<const T *>(storage_.bytes);
+  }
+  inline E *error() { return reinterpret_cast<E *>(storage_.bytes); }
+  inline const E *error() const {
+    return reinterpret_cast<const E *>(storage_.bytes);
+  }
 
-    if (res_ != NULL_PTR(void *)) {
-      if (ok_) {
-        delete (T *)res_;
-      } else {
-        delete (E *)res_;
-      }
+  inline void copy_res(const Result &other) {
+    if (ok_) {
+      new (value_ptr()) T(*other.value_ptr());
+    } else {
+      new (error()) E(*other.error());
     }
-    res_ = NULL_PTR(void *);
   }
 
-  inline Result() : ok_(false), res_(NULL_PTR(void *)) {}
+  inline void clear_res() {
+    if (ok_) {
+      value_ptr()->~T();
+    } else {
+      error()->~E();
+    }
+  }
+
+  // only used by `Fail`, which constructs the error
+  inline Result() : ok_(false) {}
+
+  bool ok_;
+  // the value or the error, stored inline (no heap allocation)
+  union {
+    char bytes[sizeof(T) > sizeof(E) ? sizeof(T) : sizeof(E)];
+    double align_double_;
+    uint64 align_uint64_;
+    void *align_ptr_;
+  } storage_;
 };
 } // namespace MARTe
 #endif
@@ -0,0 +1,63 @@
+#include "RingSignal.h"
+
+#include <time.h>
+#if defined(__linux__)
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+namespace MARTe {
+
+namespace {
+uint64 now_us() {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return static_cast<uint64>(ts.tv_sec) * 1000000u +
+         static_cast<uint64>(ts.tv_nsec) / 1000u;
+}
+
+/**
+ @brief sleep while `*addr == value`, at most `us` microseconds.
+**/
+void sleep_on(volatile uint32 *addr, const uint32 value, const uint64 us) {
+  struct timespec ts;
+#if defined(__linux__)
+  ts.tv_sec = static_cast<time_t>(us / 1000000u);
+  ts.tv_nsec = static_cast<long>((us % 1000000u) * 1000u);
+  (void)syscall(SYS_futex, addr, FUTEX_WAIT_PRIVATE, value, &ts, NULL, 0);
+#else
+  // no futex: poll the sequence number
+  (void)addr;
+  (void)value;
+  const uint64 slice = us < 100u ? us : 100u;
+  ts.tv_sec = 0;
+  ts.tv_nsec = static_cast<long>(slice * 1000u);
+  (void)nanosleep(&ts, NULL);
+#endif
+}
+} // namespace
+
+RingSignal::RingSignal() : seq_(0u), waiters_(0u) {}
+
+bool RingSignal::wait(const uint32 seq, const uint32 timeout_us) {
+  const uint64 deadline = now_us() + timeout_us;
+  while (RingAtomic::load_acquire(seq_) == seq) {
+    const uint64 now = now_us();
+    if (now >= deadline) {
+      return false;
+    }
+    // returns on wake up, timeout, interrupts or if seq_ already changed
+    sleep_on(&seq_, seq, deadline - now);
+  }
+  return true;
+}
+
+void RingSignal::wake() {
+  (void)RingAtomic::fetch_add(seq_, 1u);
+#if defined(__linux__)
+  (void)syscall(SYS_futex, &seq_, FUTEX_WAKE_PRIVATE, 1, NULL, NULL, 0);
+#endif
+}
+
+} // namespace MARTe
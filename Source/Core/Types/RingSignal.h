@@ -0,0 +1,152 @@
+#ifndef _RING_SIGNAL_H__
+#define _RING_SIGNAL_H__
+
+#include "CompilerTypes.h"
+
+namespace MARTe {
+
+/**
+  @brief size of a cache line, used to keep the producer and consumer
+  indexes of the rings on different cache lines.
+**/
+#define RING_CACHE_LINE_SIZE 64u
+
+/**
+ @brief atomic operations on the indexes of `SpscRing` and `MpscRing`.
+
+ Uses the `__atomic` builtins when available, the full barrier `__sync`
+ builtins otherwise.
+**/
+namespace RingAtomic {
+
+inline uint32 load_relaxed(const volatile uint32 &value) {
+#if defined(__ATOMIC_RELAXED)
+  return __atomic_load_n(&value, __ATOMIC_RELAXED);
+#else
+  return value;
+#endif
+}
+
+inline uint32 load_acquire(const volatile uint32 &value) {
+#if defined(__ATOMIC_ACQUIRE)
+  return __atomic_load_n(&value, __ATOMIC_ACQUIRE);
+#else
+  return __sync_fetch_and_add(const_cast<volatile uint32 *>(&value), 0u);
+#endif
+}
+
+inline void store_release(volatile uint32 &value, const uint32 v) {
+#if defined(__ATOMIC_RELEASE)
+  __atomic_store_n(&value, v, __ATOMIC_RELEASE);
+#else
+  __sync_synchronize();
+  value = v;
+#endif
+}
+
+/**
+ @brief replace `expected` with `desired` if the value is still `expected`.
+ @param[in,out] expected expected value, updated with the current value on
+ failure
+ @return true if the value has been replaced
+**/
+inline bool compare_exchange(volatile uint32 &value, uint32 &expected,
+                             const uint32 desired) {
+#if defined(__ATOMIC_ACQ_REL)
+  return __atomic_compare_exchange_n(&value, &expected, desired, true,
+                                     __ATOMIC_ACQ_REL, __ATOMIC_RELAXED);
+#else
+  const uint32 prev = __sync_val_compare_and_swap(&value, expected, desired);
+  const bool ok = (prev == expected);
+  expected = prev;
+  return ok;
+#endif
+}
+
+inline uint32 fetch_add(volatile uint32 &value, const uint32 v) {
+#if defined(__ATOMIC_SEQ_CST)
+  return __atomic_fetch_add(&value, v, __ATOMIC_SEQ_CST);
+#else
+  return __sync_fetch_and_add(&value, v);
+#endif
+}
+
+/**
+ @brief full memory barrier (orders a store before a following load).
+**/
+inline void fence() {
+#if defined(__ATOMIC_SEQ_CST)
+  __atomic_thread_fence(__ATOMIC_SEQ_CST);
+#else
+  __sync_synchronize();
+#endif
+}
+
+} // namespace RingAtomic
+
+/**
+ @brief wake up of a consumer waiting for new elements in a ring.
+
+ The producers never block nor take a lock: `notify` costs a memory barrier
+ and, only if the consumer is sleeping, a system call (a futex wake on
+ Linux, elsewhere the consumer polls).
+
+ Consumer side:
+ ```
+ const uint32 seq = signal.prepare();
+ if (!ready()) {
+   signal.wait(seq, timeout_us);
+ }
+ signal.done();
+ ```
+**/
+class RingSignal {
+public:
+  RingSignal();
+
+  /**
+    @brief wake up the consumer (if waiting), called after publishing
+  **/
+  inline void notify() {
+    // orders the publication of the elements before reading `waiters_`
+    RingAtomic::fence();
+    if (RingAtomic::load_relaxed(waiters_) != 0u) {
+      wake();
+    }
+  }
+
+  /**
+    @brief announce the consumer is about to wait
+    @return sequence number to pass to `wait`
+  **/
+  inline uint32 prepare() {
+    (void)RingAtomic::fetch_add(waiters_, 1u);
+    return RingAtomic::load_acquire(seq_);
+  }
+
+  /**
+    @brief sleep until a `notify` following `prepare` or a timeout
+    @param seq value returned by `prepare`
+    @param timeout_us maximum waiting time in microseconds
+    @return false if the timeout expired
+  **/
+  bool wait(const uint32 seq, const uint32 timeout_us);
+
+  /**
+    @brief end of the wait started by `prepare`
+  **/
+  inline void done() { (void)RingAtomic::fetch_add(waiters_, ~0u); }
+
+private:
+  RingSignal(const RingSignal &);
+  RingSignal &operator=(const RingSignal &);
+
+  void wake();
+
+  volatile uint32 seq_;     // incremented by each wake up
+  volatile uint32 waiters_; // number of consumers between prepare and done
+};
+
+} // namespace MARTe
+
+#endif
@@ -0,0 +1,119 @@
+#ifndef _SMALL_VEC_H__
+#define _SMALL_VEC_H__
+
+#include "Vec.h"
+
+namespace MARTe {
+
+/**
+  @brief inline buffer of N elements of type T (not constructed).
+
+  Base of `SmallVec`, so that the buffer is created before the array
+  and destroyed after it.
+**/
+template <typename T, uint32 N> class SmallVecStorage {
+protected:
+  inline SmallVecStorage() {}
+  inline SmallVecStorage(const SmallVecStorage &) {}
+  inline SmallVecStorage &operator=(const SmallVecStorage &) { return *this; }
+
+  inline T *buffer() { return reinterpret_cast<T *>(storage_.bytes); }
+
+private:
+  union {
+    char bytes[N * sizeof(T)];
+    double align_double_;
+    uint64 align_uint64_;
+    void *align_ptr_;
+  } storage_;
+};
+
+/**
+  @brief dynamic array of type T with inline storage for N elements.
+
+  Behaves as a `Vec` (and can be used where a `Vec` is expected) but the
+  first N elements are stored inside the object itself: the heap is used
+  only if the array grows bigger than N.
+
+  @param T type of the contained value
+  @param N number of elements stored inline
+**/
+template <typename T, uint32 N>
+class SmallVec : private SmallVecStorage<T, N>, public Vec<T> {
+public:
+  /**
+    @brief empty array
+  **/
+  inline SmallVec() : SmallVecStorage<T, N>(), Vec<T>(N, this->buffer()) {}
+
+  /**
+    @brief copy constructor
+  **/
+  inline SmallVec(const SmallVec &other)
+      : SmallVecStorage<T, N>(), Vec<T>(N, this->buffer()) {
+    copy_from(other);
+  }
+
+  /**
+    @brief copy a dynamic array
+  **/
+  inline SmallVec(const Vec<T> &other)
+      : SmallVecStorage<T, N>(), Vec<T>(N, this->buffer()) {
+    copy_from(other);
+  }
+
+  /**
+    @brief create a dynamic array from a standard array
+    @param array array to be copied
+    @param size size of the array
+  **/
+  inline SmallVec(const T array[], const uint32 size)
+      : SmallVecStorage<T, N>(), Vec<T>(N, this->buffer()) {
+    this->set(array, size);
+  }
+
+#if __cplusplus >= 201103L
+  /**
+    @brief move constructor, the other array is left empty
+  **/
+  inline SmallVec(SmallVec &&other) noexcept
+      : SmallVecStorage<T, N>(), Vec<T>(N, this->buffer()) {
+    this->take(other);
+  }
+
+  /**
+    @brief move assign operator, the other array is left empty
+  **/
+  inline SmallVec &operator=(SmallVec &&other) noexcept {
+    Vec<T>::operator=(static_cast<Vec<T> &&>(other));
+    return *this;
+  }
+#endif
+
+  /**
+    @brief assign operator
+  **/
+  inline SmallVec &operator=(const SmallVec &other) {
+    Vec<T>::operator=(other);
+    return *this;
+  }
+
+  /**
+    @brief assign operator with a dynamic array
+  **/
+  inline SmallVec &operator=(const Vec<T> &other) {
+    Vec<T>::operator=(other);
+    return *this;
+  }
+
+private:
+  inline void copy_from(const Vec<T> &other) {
+    if (other.len() > 0u) {
+      this->set(&other[0u], other.len());
+    }
+  }
+};
+
+} // namespace MARTe
+
+#endif
@@ -0,0 +1,217 @@
+#ifndef _SPSC_RING_H__
+#define _SPSC_RING_H__
+
+#include "RingSignal.h"
+
+#include <assert.h>
+#include <new>
+
+namespace MARTe {
+
+/**
+  @brief bounded single producer, single consumer queue.
+
+  Wait-free: `push` and `pop` never block nor retry, they fail if the ring
+  is full (or empty). The producer and consumer indexes live on different
+  cache lines and each side keeps a cached copy of the other index, so the
+  shared cache lines are touched only when the cached copy is exhausted.
+  The batched versions publish many elements with a single store.
+
+  A blocking ring (constructor flag) lets the consumer sleep in `pop_wait`
+  until an element is pushed, at the cost of a memory barrier per push.
+
+  Exactly one thread may push and one thread may pop at the same time.
+
+  @param T type of the elements (copied in and out of the ring)
+  @param N capacity, must be a power of 2
+**/
+template <typename T, uint32 N> class SpscRing {
+public:
+  /**
+    @brief empty ring
+    @param blocking if true the consumer can wait with `pop_wait`
+  **/
+  inline explicit SpscRing(const bool blocking = false)
+      : tail_(0u), cached_head_(0u), head_(0u), cached_tail_(0u),
+        blocking_(blocking) {
+    // N must be a power of 2
+    typedef char power_of_two[((N & (N - 1u)) == 0u && N > 0u) ? 1 : -1];
+    (void)sizeof(power_of_two);
+  }
+
+  /**
+    @brief destroy the elements still in the ring
+  **/
+  inline ~SpscRing() {
+    for (uint32 i = head_; i != tail_; i++) {
+      slot(i)->~T();
+    }
+  }
+
+  /**
+    @brief add an element (producer)
+    @return false if the ring is full
+  **/
+  inline bool push(const T &item) {
+    const uint32 tail = tail_;
+    if (tail - cached_head_ == N) {
+      cached_head_ = RingAtomic::load_acquire(head_);
+      if (tail - cached_head_ == N) {
+        return false;
+      }
+    }
+    new (slot(tail)) T(item);
+    publish(tail + 1u);
+    return true;
+  }
+
+  /**
+    @brief add up to `count` elements (producer)
+    @return number of elements added
+  **/
+  inline uint32 push(const T *items, const uint32 count) {
+    const uint32 tail = tail_;
+    uint32 n = N - (tail - cached_head_);
+    if (n < count) {
+      cached_head_ = RingAtomic::load_acquire(head_);
+      n = N - (tail - cached_head_);
+    }
+    n = n < count ? n : count;
+    for (uint32 i = 0u; i < n; i++) {
+      new (slot(tail + i)) T(items[i]);
+    }
+    if (n > 0u) {
+      publish(tail + n);
+    }
+    return n;
+  }
+
+  /**
+    @brief remove the oldest element (consumer)
+    @return false if the ring is empty
+  **/
+  inline bool pop(T &item) {
+    const uint32 head = head_;
+    if (head == cached_tail_) {
+      cached_tail_ = RingAtomic::load_acquire(tail_);
+      if (head == cached_tail_) {
+        return false;
+      }
+    }
+    T *s = slot(head);
+    item = *s;
+    s->~T();
+    RingAtomic::store_release(head_, head + 1u);
+    return true;
+  }
+
+  /**
+    @brief remove up to `max` elements (consumer)
+    @return number of elements removed
+  **/
+  inline uint32 pop(T *items, const uint32 max) {
+    const uint32 head = head_;
+    uint32 n = cached_tail_ - head;
+    if (n < max) {
+      cached_tail_ = RingAtomic::load_acquire(tail_);
+      n = cached_tail_ - head;
+    }
+    n = n < max ? n : max;
+    for (uint32 i = 0u; i < n; i++) {
+      T *s = slot(head + i);
+      items[i] = *s;
+      s->~T();
+    }
+    if (n > 0u) {
+      RingAtomic::store_release(head_, head + n);
+    }
+    return n;
+  }
+
+  /**
+    @brief remove the oldest element, waiting for it if the ring is empty
+    (consumer, blocking rings only)
+    @param timeout_us maximum waiting time in microseconds
+    @return false if the ring is still empty after the timeout
+  **/
+  inline bool pop_wait(T &item, const uint32 timeout_us) {
+    return pop_wait(&item, 1u, timeout_us) == 1u;
+  }
+
+  /**
+    @brief remove up to `max` elements, waiting for at least one if the
+    ring is empty (consumer, blocking rings only)
+    @param timeout_us maximum waiting time in microseconds
+    @return number of elements removed (0 after the timeout)
+  **/
+  inline uint32 pop_wait(T *items, const uint32 max,
+                         const uint32 timeout_us) {
+    assert(blocking_);
+    uint32 n = pop(items, max);
+    if (n == 0u) {
+      const uint32 seq = signal_.prepare();
+      n = pop(items, max);
+      if (n == 0u && signal_.wait(seq, timeout_us)) {
+        n = pop(items, max);
+      }
+      signal_.done();
+    }
+    return n;
+  }
+
+  /**
+    @brief number of elements in the ring (exact only if called by the
+    producer or the consumer while the other side is idle)
+  **/
+  inline uint32 len() const {
+    return RingAtomic::load_acquire(tail_) - RingAtomic::load_acquire(head_);
+  }
+
+  /**
+    @brief true if the ring has no element
+  **/
+  inline bool empty() const { return len() == 0u; }
+
+  /**
+    @brief maximum number of elements
+  **/
+  static inline uint32 capacity() { return N; }
+
+private:
+  SpscRing(const SpscRing &);
+  SpscRing &operator=(const SpscRing &);
+
+  inline T *slot(const uint32 i) {
+    return reinterpret_cast<T *>(storage_.bytes) + (i & (N - 1u));
+  }
+
+  inline void publish(const uint32 tail) {
+    RingAtomic::store_release(tail_, tail);
+    if (blocking_) {
+      signal_.notify();
+    }
+  }
+
+  char pad0_[RING_CACHE_LINE_SIZE];
+  // producer side
+  volatile uint32 tail_;
+  uint32 cached_head_;
+  char pad1_[RING_CACHE_LINE_SIZE];
+  // consumer side
+  volatile uint32 head_;
+  uint32 cached_tail_;
+  char pad2_[RING_CACHE_LINE_SIZE];
+  bool blocking_;
+  RingSignal signal_;
+  char pad3_[RING_CACHE_LINE_SIZE];
+  union {
+    char bytes[N * sizeof(T)];
+    double align_double_;
+    uint64 align_uint64_;
+    void *align_ptr_;
+  } storage_;
+};
+
+} // namespace MARTe
+
+#endif
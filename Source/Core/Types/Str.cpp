@@ -1,209 +1,271 @@
 #include "Str.h"
+#include "StrOps.h"
 #include <assert.h>
 #include <stdio.h>
 #include <string.h>
 
-#define INIT_SIZE 16
-#define STEP 16
 namespace MARTe {
 
-Str::Str() : size_(INIT_SIZE), len_(0) {
-  mem_ = new char[size_];
-  mem_[0] = 0;
+Str::Str() : size_(inline_size), len_(0) { mem_.buff[0] = 0; }
+
+Str::Str(const char *str) : size_(inline_size), len_(0) {
+  init(str, strlen(str));
+}
+
+Str::Str(Allocator *allocator) : size_(inline_size), len_(0) {
+  mem_.buff[0] = 0;
+  use(allocator, 0u);
 }
 
-Str::Str(const char *str) : size_(INIT_SIZE) {
-  len_ = strlen(str);
-  if (len_ + 1 > size_) {
-    size_ = len_ + 1;
+Str::Str(const char *str, const uint32 len, Allocator *allocator)
+    : size_(inline_size), len_(0) {
+  mem_.buff[0] = 0;
+  use(allocator, len);
+  append(str, len);
+}
+
+Str::Str(const Str &other) : size_(inline_size), len_(0) {
+  mem_.buff[0] = 0;
+  use(other.allocator(), other.len_);
+  append(other.data(), other.len_);
+}
+
+#if __cplusplus >= 201103L
+Str::Str(Str &&other) noexcept : size_(other.size_), len_(other.len_) {
+  if (other.on_heap()) {
+    mem_.heap = other.mem_.heap;
+  } else {
+    // whole buffer: keeps the allocator of a string without buffer
+    memcpy(mem_.buff, other.mem_.buff, inline_size);
   }
-  mem_ = new char[size_];
-  if (!memccpy(mem_, str, 0, len_)) {
-    mem_[len_] = 0;
+  other.size_ = inline_size;
+  other.len_ = 0u;
+  other.mem_.buff[0] = 0;
+}
+#endif
+
+Str::~Str() {
+  if (on_heap()) {
+    deallocate(mem_.heap.alloc, mem_.heap.ptr, size_);
   }
 }
 
-Str::Str(const Str &other) : size_(other.size_), len_(other.len_) {
-  if (other.size_ > 0) {
-    mem_ = new char[size_];
-    if (!memccpy(mem_, other.mem_, 0, other.len_)) {
-      mem_[other.len_] = 0;
+bool Str::use(Allocator *allocator, const uint32 len) {
+  // strings using an allocator are always in its buffer
+  if (allocator != NULL_PTR(Allocator *)) {
+    const uint32 size = len < inline_size ? inline_size + 1u : len + 1u;
+    char *buff = static_cast<char *>(allocate(allocator, size));
+    mem_.heap.alloc = allocator;
+    if (buff == NULL_PTR(char *)) {
+      // exhausted: empty string without buffer (data() reads the null ptr)
+      mem_.heap.ptr = NULL_PTR(char *);
+      size_ = 0u;
+      return false;
     }
-  } else {
-    mem_ = NULL_PTR(char *);
+    buff[0] = 0;
+    mem_.heap.ptr = buff;
+    size_ = size;
   }
+  return true;
 }
 
-Str::~Str() {
-  if (mem_ != NULL_PTR(char *)) {
-    delete[] mem_;
-    mem_ = NULL_PTR(char *);
+bool Str::grow(const uint32 len, const char *str, const uint32 extra) {
+  uint32 new_size = 2u * size_;
+  if (new_size < len + 1u) {
+    new_size = len + 1u;
+  }
+  if (new_size <= inline_size) {
+    new_size = inline_size + 1u;
+  }
+  Allocator *alloc = allocator();
+  char *buff = static_cast<char *>(allocate(alloc, new_size));
+  if (buff == NULL_PTR(char *)) {
+    return false;
+  }
+  // str may point inside this string: copied before the old buffer is freed
+  memcpy(buff, data(), len_);
+  if (extra > 0u) {
+    memcpy(buff + len_, str, extra);
+  }
+  len_ += extra;
+  buff[len_] = 0;
+  if (on_heap()) {
+    deallocate(alloc, mem_.heap.ptr, size_);
   }
+  mem_.heap.ptr = buff;
+  mem_.heap.alloc = alloc;
+  size_ = new_size;
+  return true;
+}
+
+void Str::init(const char *str, const uint32 len) {
+  mem_.buff[0] = 0;
+  append(str, len);
 }
 
 uint32 Str::len() const { return len_; }
 
-const char *Str::cstr() const { return (const char *)mem_; }
+const char *Str::cstr() const { return data(); }
+
+StrView Str::view() const { return StrView(data(), len_); }
 
 void Str::clear() {
-  mem_[0] = 0;
+  data()[0] = 0;
   len_ = 0;
 }
 
-void Str::extend(uint32 new_l) {
-  if (new_l >= size_) {
-    uint32 new_size = new_l + 1;
-    char *buff = new char[new_size];
-    if (!memccpy(buff, mem_, 0, len_)) {
-      buff[len_] = 0;
+bool Str::reserve(const uint32 len) {
+  return len + 1u <= size_ || grow(len, NULL_PTR(const char *), 0u);
+}
+
+uint32 Str::capacity() const { return size_ > 0u ? size_ - 1u : 0u; }
+
+Allocator *Str::allocator() const {
+  return size_ == 0u || on_heap() ? mem_.heap.alloc : NULL_PTR(Allocator *);
+}
+
+Str &Str::append(const char *str, const uint32 len) {
+  if (len > 0u) {
+    if (len_ + len + 1u > size_) {
+      // unchanged if the allocator is exhausted
+      (void)grow(len_ + len, str, len);
+    } else {
+      char *mem = data();
+      memmove(mem + len_, str, len);
+      len_ += len;
+      mem[len_] = 0;
     }
-    delete[] mem_;
-    mem_ = buff;
-    size_ = new_size;
   }
+  return *this;
 }
 
-Str Str::operator+(const Str &other) const {
-  size_t l = other.len_ + len_ + 1;
-  Str s;
-  s.extend(l);
-  s.len_ = other.len_ + len_;
-  char *ptr = (char *)memccpy(s.mem_, mem_, 0, len_);
-  if (ptr == NULL_PTR(char *)) {
-    ptr = s.mem_ + len_;
+Str &Str::append(const Str &other) { return append(other.data(), other.len_); }
+
+Str &Str::append(const char *other) { return append(other, strlen(other)); }
+
+void Str::swap(Str &other) {
+  Str *a = this;
+  Str *b = &other;
+  if (!a->on_heap()) {
+    // keep the inline buffer (if any) in `b`
+    a = &other;
+    b = this;
+  }
+  if (a->on_heap() && b->on_heap()) {
+    const heap_t heap = a->mem_.heap;
+    a->mem_.heap = b->mem_.heap;
+    b->mem_.heap = heap;
+  } else if (a->on_heap()) {
+    const heap_t heap = a->mem_.heap;
+    memcpy(a->mem_.buff, b->mem_.buff, inline_size);
+    b->mem_.heap = heap;
   } else {
-    ptr = ptr - 1;
+    char buff[inline_size];
+    memcpy(buff, a->mem_.buff, inline_size);
+    memcpy(a->mem_.buff, b->mem_.buff, inline_size);
+    memcpy(b->mem_.buff, buff, inline_size);
   }
+  uint32 tmp = a->size_;
+  a->size_ = b->size_;
+  b->size_ = tmp;
+  tmp = a->len_;
+  a->len_ = b->len_;
+  b->len_ = tmp;
+}
 
-  if (!memccpy(ptr, other.mem_, 0, other.len_)) {
-    s.mem_[l] = 0;
-  };
+Str Str::operator+(const Str &other) const {
+  Str s;
+  s.reserve(len_ + other.len_);
+  s.append(data(), len_).append(other.data(), other.len_);
   return s;
 }
 
 Str Str::operator+(const char *other) const {
-  size_t l = strlen(other) + len_ + 1;
+  const uint32 l = strlen(other);
   Str s;
-  s.extend(l);
-
-  s.len_ = l - 1;
-  char *ptr = (char *)memccpy(s.mem_, mem_, 0, size_);
-  assert(ptr != NULL_PTR(char *));
-  if (!memccpy(ptr - 1, other, 0, l)) {
-    s.mem_[l] = 0;
-  };
-
+  s.reserve(len_ + l);
+  s.append(data(), len_).append(other, l);
   return s;
 }
 
 Str Str::operator+(const char &ch) const {
-  size_t l = len_ + 2;
   Str s;
-  s.extend(l);
-
-  s.len_ = l - 1;
-  char *ptr = (char *)memccpy(s.mem_, mem_, 0, size_);
-  assert(ptr != NULL_PTR(char *));
-  s.mem_[len_] = ch;
-  s.mem_[len_ + 1] = 0;
+  s.reserve(len_ + 1u);
+  s.append(data(), len_).append(&ch, 1u);
   return s;
 }
 
 Str &Str::operator=(const Str &other) {
-  if (other.len_ >= size_) {
-    extend(other.len());
+  // unchanged if the allocator is exhausted
+  if (this != &other && reserve(other.len_)) {
+    clear();
+    append(other.data(), other.len_);
   }
-  if (!memccpy(mem_, other.mem_, 0, other.len())) {
-    mem_[other.len()] = 0;
+  return *this;
+}
+
+#if __cplusplus >= 201103L
+Str &Str::operator=(Str &&other) noexcept {
+  if (this != &other) {
+    if (on_heap()) {
+      deallocate(mem_.heap.alloc, mem_.heap.ptr, size_);
+    }
+    size_ = other.size_;
+    len_ = other.len_;
+    if (other.on_heap()) {
+      mem_.heap = other.mem_.heap;
+    } else {
+      memcpy(mem_.buff, other.mem_.buff, inline_size);
+    }
+    other.size_ = inline_size;
+    other.len_ = 0u;
+    other.mem_.buff[0] = 0;
   }
-  len_ = other.len();
   return *this;
 }
+#endif
 
 Str &Str::operator+=(const char other) {
   if (other != 0) {
-    extend(len_ + 1);
-    mem_[len_++] = other;
-    mem_[len_] = 0;
+    append(&other, 1u);
   }
 
   return *this;
 }
 
 bool Str::operator==(const Str &other) const {
-  if (len_ != other.len_) {
-    return false;
-  }
-  return strcmp(mem_, other.mem_) == 0;
+  return len_ == other.len_ && StrOps::equal(data(), other.data(), len_);
 }
 
 bool Str::operator==(const char *other) const {
   if (other == NULL_PTR(const char *)) {
     return len_ == 0;
   }
-  uint32 l = strlen(other);
-  return l == len_ && strcmp(mem_, other) == 0;
+  const uint32 l = strlen(other);
+  return l == len_ && StrOps::equal(data(), other, len_);
 }
 
-bool Str::operator!=(const Str &other) const {
-  if (len_ != other.len_) {
-    return true;
-  }
-  return strcmp(mem_, other.mem_) != 0;
-}
-bool Str::operator!=(const char *other) const {
-  if (other == NULL_PTR(const char *)) {
-    return len_ != 0;
-  }
-  uint32 l = strlen(other);
-  return l != len_ || strcmp(mem_, other) != 0;
-}
+bool Str::operator!=(const Str &other) const { return !(*this == other); }
 
-bool Str::operator>(const Str &other) const {
-  if (len_ == 0 && other.len_ != 0) {
-    return false;
-  }
-  if (other.len_ == 0) {
-    return len_ != 0;
-  }
-  uint32 min = len_ < other.len_ ? len_ : other.len_;
-  for (uint32 i = 0u; i < min; i++) {
-    if (mem_[i] > other.mem_[i]) {
-      return true;
-    } else if (mem_[i] < other.mem_[i]) {
-      return false;
-    }
-  }
-  return len_ > other.len_;
-}
+bool Str::operator!=(const char *other) const { return !(*this == other); }
+
+bool Str::operator>(const Str &other) const { return other < *this; }
 
 bool Str::operator<(const Str &other) const {
-  if (len_ == 0 && other.len_ != 0) {
-    return true;
-  }
-  if (other.len_ == 0) {
-    return false;
-  }
-  uint32 min = len_ < other.len_ ? len_ : other.len_;
-  for (uint32 i = 0u; i < min; i++) {
-    if (mem_[i] > other.mem_[i]) {
-      return false;
-    } else if (mem_[i] < other.mem_[i]) {
-      return true;
-    }
-  }
-  return len_ < other.len_;
+  const uint32 min = len_ < other.len_ ? len_ : other.len_;
+  const int32 cmp = StrOps::compare(data(), other.data(), min);
+  return cmp < 0 || (cmp == 0 && len_ < other.len_);
 }
 
 char Str::operator[](int i) const {
   int j = i >= 0 ? i : (len_ + i);
   assert(j >= 0 && (uint32)j < len_);
-  return mem_[j];
+  return data()[j];
 }
 
 Str &Str::set(const int &i, const char &c) {
   int j = i >= 0 ? i : (len_ + i);
-  mem_[j] = c;
+  data()[j] = c;
   return *this;
 }
 
@@ -213,13 +275,7 @@ Str Str::substr(const int32 end) const {
     return "";
   if ((uint32)len >= len_)
     return Str(*this);
-  Str a;
-  a.extend((uint32)len);
-  a.len_ = (uint32)len;
-  if (!memccpy(a.mem_, mem_, 0, a.len_)) {
-    a.mem_[a.len_] = 0;
-  }
-  return a;
+  return Str(data(), (uint32)len);
 }
 
 Str Str::substr(const int32 start, const int32 end) const {
@@ -234,61 +290,19 @@ Str Str::substr(const int32 start, const int32 end) const {
   if (i0 >= (int32)len_ || ie <= i0 || ie < 0 || i0 < 0) {
     return Str();
   }
-  uint32 len = ie - i0;
-  Str a;
-  a.extend(len);
-  a.len_ = len;
-  if (!memccpy(a.mem_, &mem_[start], 0, len)) {
-    a.mem_[len] = 0;
-  }
-  return a;
+  return Str(data() + i0, (uint32)(ie - i0));
 }
 
 Option<uint32> Str::find(const Str &str, const uint32 &start) const {
-  if (start + str.len() > len() || str.len() == 0) {
-    return Option<uint32>();
-  }
-  uint32 i = 0;
-  uint32 m = 0;
-  for (uint32 n = start; n < len_; n++) {
-    if (mem_[n] == str.mem_[m]) {
-      if (m == 0) {
-        i = n;
-      }
-      if (++m == str.len()) {
-        return Option<uint32>(i);
-      }
-    } else {
-      m = 0;
-    }
-  }
-  return Option<uint32>();
+  return view().find(str.view(), start);
 }
+
 Option<uint32> Str::find(const char &ch, const uint32 &start) const {
-  if (start >= len()) {
-    return Option<uint32>();
-  }
-  for (uint32 i = start; i < len_; i++) {
-    if (mem_[i] == ch) {
-      return Option<uint32>(i);
-    }
-  }
-  return Option<uint32>();
+  return view().find(ch, start);
 }
 
-uint32 Str::hash() const {
-  uint32 hash_ = 0;
-  if (mem_ != NULL_PTR(char *)) {
-    for (uint32 i = 0; i < len_; i++) {
-      hash_ += mem_[i];
-      hash_ += (hash_ << 10);
-      hash_ ^= (hash_ >> 6);
-    }
-    hash_ += (hash_ << 3);
-    hash_ ^= (hash_ >> 11);
-    hash_ += (hash_ << 15);
-  }
-  return hash_;
-}
+uint32 Str::hash() const { return view().hash(); }
+
+uint64 Str::hash64() const { return view().hash64(); }
 
 } // namespace MARTe
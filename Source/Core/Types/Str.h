@@ -1,8 +1,10 @@
 #ifndef STR_H__
 #define STR_H__
 
+#include "Allocator.h"
 #include "CompilerTypes.h"
 #include "Option.h"
+#include "StrView.h"
 
 namespace MARTe {
 
@@ -11,6 +13,15 @@ namespace MARTe {
 
         This class create a variable size string capable of automatically resize
 when needed.
+
+        Strings shorter than `inline_size` bytes (terminator included) are
+stored inside the object without any heap allocation, longer strings grow
+their buffer geometrically.
+
+        The buffer can come from an `Allocator` (e.g. an `Arena`): such a
+string never uses the inline buffer, its copies use the same allocator.
+If the allocator is exhausted the string is left unchanged (empty and
+without buffer if it had none).
 **/
 class Str {
 public:
@@ -18,15 +29,34 @@ public:
     @brief Create an empty string
   **/
   Str();
+  /**
+    @brief Create an empty string using an allocator.
+    @param allocator source of the buffer (heap if null)
+  **/
+  explicit Str(Allocator *allocator);
   /**
     @brief Create a string with a value.
     @param str value used to the initalization
     **/
   Str(const char *str);
   /**
-    @brief Copy constructor.
+    @brief Create a string with the first `len` chars of a buffer.
+    @param str buffer (not necessarily null terminated)
+    @param len number of chars to copy
+    @param allocator source of the buffer (heap if null)
+    **/
+  Str(const char *str, const uint32 len,
+      Allocator *allocator = NULL_PTR(Allocator *));
+  /**
+    @brief Copy constructor (same allocator of the other string).
   **/
   Str(const Str &other);
+#if __cplusplus >= 201103L
+  /**
+    @brief Move constructor, the other string is left empty.
+  **/
+  Str(Str &&other) noexcept;
+#endif
 
   /**
     @brief Destructor
@@ -42,11 +72,50 @@ public:
     @return pointer to the first byte.
   **/
   const char *cstr() const;
+  /**
+    @brief Non-owning view of the string (valid until the string changes).
+  **/
+  StrView view() const;
   /**
     @brief Clears the string by resetting the counter and the first byte.
   **/
   void clear();
 
+  /**
+    @brief Make room for a string of `len` chars without reallocating.
+    @param len number of chars
+    @return false if the allocator is exhausted (the string is unchanged)
+  **/
+  bool reserve(const uint32 len);
+  /**
+    @brief Size of the buffer.
+    @return the number of chars that can be stored without reallocating.
+  **/
+  uint32 capacity() const;
+  /**
+    @brief Allocator of the buffer.
+    @return the allocator, null for the heap.
+  **/
+  Allocator *allocator() const;
+
+  /**
+    @brief Append a buffer at the end of the string.
+    @param str buffer (not necessarily null terminated)
+    @param len number of chars to append
+    @return it self (unchanged if the allocator is exhausted)
+  **/
+  Str &append(const char *str, const uint32 len);
+  /**
+    @brief Append a string at the end of the string.
+    @return it self
+  **/
+  Str &append(const Str &other);
+  /**
+    @brief Append a c string at the end of the string.
+    @return it self
+  **/
+  Str &append(const char *other);
+
   /**
     @brief Add operator with another Str
     @return the sum of the two strings
@@ -66,19 +135,23 @@ public:
     @brief Assign operator
   **/
   Str &operator=(const Str &other);
+#if __cplusplus >= 201103L
+  /**
+    @brief Move assign operator, the other string is left empty.
+  **/
+  Str &operator=(Str &&other) noexcept;
+#endif
   /**
     @brief equality operator with another Str
     @return true if same length and content.
   **/
   bool operator==(const Str &other) const;
   /**
-    @brief equality operator with another Str
-    @return true if same length and content.
+    @brief lexicographic order (chars compared as unsigned)
   **/
   bool operator<(const Str &other) const;
   /**
-    @brief equality operator with another Str
-    @return true if same length and content.
+    @brief lexicographic order (chars compared as unsigned)
   **/
   bool operator>(const Str &other) const;
   /**
@@ -143,12 +216,43 @@ public:
   Option<uint32> find(const Str &str, const uint32 &start = 0) const;
   Option<uint32> find(const char &ch, const uint32 &start = 0) const;
 
+  /**
+    @brief hash of the string (32 bits, used by `HashMap`)
+  **/
   uint32 hash() const;
+  /**
+    @brief 64 bits hash of the string (wyhash)
+  **/
+  uint64 hash64() const;
+
+  /**
+    @brief Size of the inline buffer (terminator included).
+  **/
+  static const uint32 inline_size = 24u;
 
 private:
-  void extend(uint32 lenght); /// extend
-  char *mem_;   // + 1 for byte 0 containing size and +1 for 0 padding
-  uint32 size_; // size of memory
+  friend class StrBuilder;
+
+  // size_ is 0 for a string without buffer (exhausted allocator in
+  // mem_.heap.alloc, null mem_.heap.ptr read as an empty inline buffer)
+  inline bool on_heap() const { return size_ > inline_size; }
+  inline char *data() { return on_heap() ? mem_.heap.ptr : mem_.buff; }
+  inline const char *data() const {
+    return on_heap() ? mem_.heap.ptr : mem_.buff;
+  }
+  void init(const char *str, const uint32 len);
+  bool use(Allocator *allocator, const uint32 len);
+  bool grow(const uint32 len, const char *str, const uint32 extra);
+  void swap(Str &other);
+  struct heap_t {
+    char *ptr;        // buffer
+    Allocator *alloc; // source of the buffer (null for the heap)
+  };
+  union {
+    heap_t heap;            // heap buffer (size_ > inline_size)
+    char buff[inline_size]; // inline buffer
+  } mem_;
+  uint32 size_; // size of memory (terminator included)
   uint32 len_;  // length of string
 };
 
@@ -0,0 +1,270 @@
+#include "StrBuilder.h"
+
+#include <float.h>
+#include <math.h>
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+namespace MARTe {
+
+namespace {
+
+const char digit_pairs[] = "00010203040506070809"
+                           "10111213141516171819"
+                           "20212223242526272829"
+                           "30313233343536373839"
+                           "40414243444546474849"
+                           "50515253545556575859"
+                           "60616263646566676869"
+                           "70717273747576777879"
+                           "80818283848586878889"
+                           "90919293949596979899";
+
+const uint32 max_decimals = 9u;
+
+const uint64 powers_of_ten[max_decimals + 1u] = {
+    1u,      10u,      100u,      1000u,      10000u,
+    100000u, 1000000u, 10000000u, 100000000u, 1000000000u};
+
+// larger values are written in scientific notation
+const float64 max_fixed = 1e18;
+
+/**
+ @brief escape of each byte inside a JSON string: 0 if copied as is, 'u' if
+ written as `\u00XX`, otherwise the char written after a backslash (bytes
+ from 0x60 are all copied)
+**/
+const char json_escapes[256] = {
+    'u', 'u', 'u', 'u', 'u', 'u', 'u', 'u',
+    'b', 't', 'n', 'u', 'f', 'r', 'u', 'u',
+    'u', 'u', 'u', 'u', 'u', 'u', 'u', 'u',
+    'u', 'u', 'u', 'u', 'u', 'u', 'u', 'u',
+    0, 0, '"', 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, '\\', 0, 0, 0,
+};
+
+const char hex_digits[] = "0123456789abcdef";
+
+// chars escaped between two checks of the capacity
+const uint32 json_chunk = 256u;
+
+/**
+ @brief write a char escaped for a JSON string (at most 6 chars)
+ @return end of the written chars
+**/
+inline char *json_escape(char *out, const uint8 c) {
+  const char escape = json_escapes[c];
+  if (escape == 0) {
+    *out = static_cast<char>(c);
+    return out + 1;
+  }
+  out[0] = '\\';
+  if (escape == 'u') {
+    out[1] = 'u';
+    out[2] = '0';
+    out[3] = '0';
+    out[4] = hex_digits[c >> 4u];
+    out[5] = hex_digits[c & 0xFu];
+    return out + 6;
+  }
+  out[1] = escape;
+  return out + 2;
+}
+
+/**
+ @brief write the digits of `value` backwards, ending at `end`
+ @return number of digits
+**/
+uint32 format_digits(uint64 value, char *end) {
+  char *it = end;
+  while (value >= 100u) {
+    const uint32 i = static_cast<uint32>(value % 100u) * 2u;
+    value /= 100u;
+    *--it = digit_pairs[i + 1u];
+    *--it = digit_pairs[i];
+  }
+  if (value >= 10u) {
+    const uint32 i = static_cast<uint32>(value) * 2u;
+    *--it = digit_pairs[i + 1u];
+    *--it = digit_pairs[i];
+  } else {
+    *--it = static_cast<char>('0' + value);
+  }
+  return static_cast<uint32>(end - it);
+}
+
+} // namespace
+
+StrBuilder::StrBuilder(const uint32 capacity, Allocator *allocator)
+    : alloc_(allocator), str_(allocator) {
+  if (capacity > 0u) {
+    reserve(capacity);
+  }
+}
+
+bool StrBuilder::grow(const uint32 len) {
+  // doubles the buffer at least
+  return str_.reserve(str_.len_ + len);
+}
+
+StrBuilder &StrBuilder::append(const uint64 value) {
+  char buff[20];
+  const uint32 n = format_digits(value, buff + sizeof(buff));
+  return append(buff + sizeof(buff) - n, n);
+}
+
+StrBuilder &StrBuilder::append(const int64 value) {
+  if (value < 0) {
+    // sign and digits together or nothing
+    if (!reserve(21u)) {
+      return *this;
+    }
+    append('-');
+    // negation in unsigned arithmetic (valid for the minimum too)
+    return append(static_cast<uint64>(0u) - static_cast<uint64>(value));
+  }
+  return append(static_cast<uint64>(value));
+}
+
+StrBuilder &StrBuilder::append(const uint32 value) {
+  return append(static_cast<uint64>(value));
+}
+
+StrBuilder &StrBuilder::append(const int32 value) {
+  return append(static_cast<int64>(value));
+}
+
+StrBuilder &StrBuilder::append_padded(const uint64 value, const uint32 width,
+                                      const char fill) {
+  char buff[20];
+  const uint32 n = format_digits(value, buff + sizeof(buff));
+  if (!reserve(n < width ? width : n)) {
+    return *this;
+  }
+  for (uint32 i = n; i < width; i++) {
+    append(fill);
+  }
+  return append(buff + sizeof(buff) - n, n);
+}
+
+StrBuilder &StrBuilder::append(const float64 value, const uint32 decimals) {
+  if (value != value) {
+    return append("nan", 3u);
+  }
+  // longest number: sign, 19 digits, point, decimals, exponent
+  if (!reserve(max_decimals + 26u)) {
+    return *this;
+  }
+  float64 v = value;
+  if (v < 0.0) {
+    append('-');
+    v = -v;
+  }
+  if (v > DBL_MAX) {
+    return append("inf", 3u);
+  }
+  const uint32 d = decimals < max_decimals ? decimals : max_decimals;
+  const uint64 scale = powers_of_ten[d];
+  int32 exponent = 0;
+  if (v >= max_fixed) {
+    // scientific notation, mantissa in [1, 10)
+    exponent = static_cast<int32>(floor(log10(v)));
+    v /= pow(10.0, exponent);
+    if (v >= 10.0) {
+      v /= 10.0;
+      exponent++;
+    } else if (v < 1.0) {
+      v *= 10.0;
+      exponent--;
+    }
+  }
+  uint64 integer = static_cast<uint64>(v);
+  uint64 fraction = static_cast<uint64>(
+      (v - static_cast<float64>(integer)) * static_cast<float64>(scale) + 0.5);
+  if (fraction >= scale) {
+    // rounded up to the next integer
+    fraction -= scale;
+    integer++;
+  }
+  if (exponent != 0 && integer == 10u) {
+    integer = 1u;
+    exponent++;
+  }
+  append(integer);
+  if (d > 0u) {
+    append('.');
+    append_padded(fraction, d);
+  }
+  if (exponent != 0) {
+    append("e+", 2u);
+    append(exponent);
+  }
+  return *this;
+}
+
+StrBuilder &StrBuilder::append_json_escaped(const char *str,
+                                            const uint32 len) {
+#if defined(__SSE2__)
+  const __m128i quote = _mm_set1_epi8('"');
+  const __m128i backslash = _mm_set1_epi8('\\');
+  const __m128i control = _mm_set1_epi8(0x1F);
+#endif
+  const uint32 start = str_.len_;
+  uint32 i = 0u;
+  while (i < len) {
+    // room for the worst case of a chunk (every char written as \u00XX),
+    // so that the chars are written without any check
+    const uint32 end = len - i < json_chunk ? len : i + json_chunk;
+    if (str_.len_ + (end - i) * 6u >= str_.size_ && !grow((end - i) * 6u)) {
+      // all or nothing: the chunks already escaped are removed
+      str_.len_ = start;
+      break;
+    }
+    char *const begin = str_.data() + str_.len_;
+    char *out = begin;
+#if defined(__SSE2__)
+    // blocks of 16 clean bytes (not quote, backslash or below 0x20) are
+    // copied at once, the others from their first special byte on
+    for (; i + 16u <= end; i += 16u) {
+      const __m128i x =
+          _mm_loadu_si128(reinterpret_cast<const __m128i *>(str + i));
+      _mm_storeu_si128(reinterpret_cast<__m128i *>(out), x);
+      const __m128i special = _mm_or_si128(
+          _mm_or_si128(_mm_cmpeq_epi8(x, quote), _mm_cmpeq_epi8(x, backslash)),
+          _mm_cmpeq_epi8(_mm_max_epu8(x, control), control));
+      const uint32 mask = static_cast<uint32>(_mm_movemask_epi8(special));
+      if (mask == 0u) {
+        out += 16u;
+      } else {
+        const uint32 clean = static_cast<uint32>(__builtin_ctz(mask));
+        out += clean;
+        for (uint32 k = clean; k < 16u; k++) {
+          out = json_escape(out, static_cast<uint8>(str[i + k]));
+        }
+      }
+    }
+#endif
+    for (; i < end; i++) {
+      out = json_escape(out, static_cast<uint8>(str[i]));
+    }
+    str_.len_ += static_cast<uint32>(out - begin);
+  }
+  str_.data()[str_.len_] = 0;
+  return *this;
+}
+
+Str StrBuilder::finish() {
+  Str res;
+  res.swap(str_);
+  str_.use(alloc_, 0u);
+  return res;
+}
+
+} // namespace MARTe
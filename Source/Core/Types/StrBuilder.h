@@ -0,0 +1,175 @@
+#ifndef STR_BUILDER_H__
+#define STR_BUILDER_H__
+
+#include "Allocator.h"
+#include "CompilerTypes.h"
+#include "Str.h"
+#include "StrView.h"
+
+#include <string.h>
+
+namespace MARTe {
+
+/**
+  @brief Builder of strings from pieces, chars and numbers.
+
+  The buffer grows geometrically, so building a string of length n costs
+  O(n) whatever the number of pieces (while `a = a + b` copies `a` at each
+  step). Integers and floats are formatted directly in the buffer, without
+  `printf`. `clear` keeps the buffer, so a builder reused for each log line
+  or token stops allocating once it reached the longest one, and `finish`
+  hands the buffer to the returned `Str` without copying it. A piece that
+  does not fit in an exhausted allocator is not appended.
+
+  ```
+  StrBuilder b;
+  b.append("x = ").append(42).append(", y = ").append(0.5, 2u);
+  Str s = b.finish(); // "x = 42, y = 0.50"
+  ```
+**/
+class StrBuilder {
+public:
+  /**
+    @brief empty builder
+    @param capacity initial capacity (chars)
+    @param allocator source of the buffer (heap if null)
+  **/
+  explicit StrBuilder(const uint32 capacity = 0u,
+                      Allocator *allocator = NULL_PTR(Allocator *));
+
+  /**
+    @brief append a char
+  **/
+  inline StrBuilder &append(const char c) {
+    if (str_.len_ + 1u >= str_.size_ && !grow(1u)) {
+      return *this;
+    }
+    char *mem = str_.data();
+    mem[str_.len_++] = c;
+    mem[str_.len_] = 0;
+    return *this;
+  }
+
+  /**
+    @brief append `len` chars of a buffer (not inside the builder)
+  **/
+  inline StrBuilder &append(const char *str, const uint32 len) {
+    if (str_.len_ + len >= str_.size_ && !grow(len)) {
+      return *this;
+    }
+    char *mem = str_.data();
+    memcpy(mem + str_.len_, str, len);
+    str_.len_ += len;
+    mem[str_.len_] = 0;
+    return *this;
+  }
+
+  /**
+    @brief append a null terminated string
+  **/
+  inline StrBuilder &append(const char *str) {
+    return append(str, static_cast<uint32>(strlen(str)));
+  }
+
+  /**
+    @brief append the viewed chars
+  **/
+  inline StrBuilder &append(const StrView &str) {
+    return append(str.data(), str.len());
+  }
+
+  /**
+    @brief append a string
+  **/
+  inline StrBuilder &append(const Str &str) {
+    return append(str.cstr(), str.len());
+  }
+
+  /**
+    @brief append an integer in decimal notation
+  **/
+  StrBuilder &append(const uint32 value);
+  StrBuilder &append(const int32 value);
+  StrBuilder &append(const uint64 value);
+  StrBuilder &append(const int64 value);
+
+  /**
+    @brief append a float in fixed notation (`printf("%.*f")`, rounded half
+    up), in scientific notation if larger than 1e18
+    @param decimals number of decimals (at most 9)
+  **/
+  StrBuilder &append(const float64 value, const uint32 decimals = 6u);
+
+  /**
+    @brief append an integer left padded to `width` chars (e.g. the fields
+    of a time stamp)
+    @param fill char used for the padding
+  **/
+  StrBuilder &append_padded(const uint64 value, const uint32 width,
+                            const char fill = '0');
+
+  /**
+    @brief append `len` chars as the content of a JSON string: quotes,
+    backslashes and control chars (below 0x20) are escaped (`\n`, `\t`,
+    `\u001b`...), other bytes (e.g. UTF-8 sequences) are copied
+  **/
+  StrBuilder &append_json_escaped(const char *str, const uint32 len);
+
+  /**
+    @brief make room for `len` more chars
+    @return false if the allocator is exhausted
+  **/
+  inline bool reserve(const uint32 len) {
+    return str_.reserve(str_.len_ + len);
+  }
+
+  /**
+    @brief remove the content, keeping the buffer
+  **/
+  inline void clear() { str_.clear(); }
+
+  /**
+    @brief number of chars
+  **/
+  inline uint32 len() const { return str_.len_; }
+
+  /**
+    @brief content (null terminated), valid until the next change
+  **/
+  inline const char *cstr() const { return str_.cstr(); }
+
+  /**
+    @brief view of the content, valid until the next change
+  **/
+  inline StrView view() const { return str_.view(); }
+
+  /**
+    @brief move the content in a string (same allocator), leaving the
+    builder empty
+  **/
+  Str finish();
+
+  /**
+    @brief exchange the content (and buffers) of two builders, e.g. to hand
+    the pending text to another thread without copying it
+  **/
+  inline void swap(StrBuilder &other) {
+    str_.swap(other.str_);
+    Allocator *const alloc = alloc_;
+    alloc_ = other.alloc_;
+    other.alloc_ = alloc;
+  }
+
+private:
+  StrBuilder(const StrBuilder &);
+  StrBuilder &operator=(const StrBuilder &);
+
+  bool grow(const uint32 len);
+
+  Allocator *alloc_;
+  Str str_;
+};
+
+} // namespace MARTe
+
+#endif
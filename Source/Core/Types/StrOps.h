@@ -0,0 +1,88 @@
+#ifndef STR_OPS_H__
+#define STR_OPS_H__
+
+#include "CompilerTypes.h"
+#include <string.h>
+
+namespace MARTe {
+
+/**
+ @brief byte kernels shared by `Str` and `StrView`.
+**/
+namespace StrOps {
+
+// unaligned loads (compiled to a single move)
+inline uint64 load64(const char *p) {
+  uint64 v;
+  memcpy(&v, p, sizeof(v));
+  return v;
+}
+
+inline uint32 load32(const char *p) {
+  uint32 v;
+  memcpy(&v, p, sizeof(v));
+  return v;
+}
+
+/**
+ @brief true if the `n` bytes are equal, comparing a word at a time
+ (identifiers are short: it avoids the `memcmp` call).
+**/
+inline bool equal(const char *a, const char *b, const uint32 n) {
+  if (n >= 8u) {
+    uint32 i = 0u;
+    for (; i + 8u < n; i += 8u) {
+      if (load64(a + i) != load64(b + i)) {
+        return false;
+      }
+    }
+    // last word, overlapping the previous one
+    return load64(a + n - 8u) == load64(b + n - 8u);
+  }
+  if (n >= 4u) {
+    return load32(a) == load32(b) && load32(a + n - 4u) == load32(b + n - 4u);
+  }
+  for (uint32 i = 0u; i < n; i++) {
+    if (a[i] != b[i]) {
+      return false;
+    }
+  }
+  return true;
+}
+
+/**
+ @brief compare the `n` bytes as unsigned chars, as `memcmp`, a word at a
+ time on little and big endian targets.
+**/
+inline int32 compare(const char *a, const char *b, const uint32 n) {
+  uint32 i = 0u;
+#if defined(__BYTE_ORDER__) && (__BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__ ||  \
+                                __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__)
+  for (; i + 8u <= n; i += 8u) {
+    uint64 x = load64(a + i);
+    uint64 y = load64(b + i);
+    if (x != y) {
+#if __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+      // the first byte has to be the most significant
+      x = __builtin_bswap64(x);
+      y = __builtin_bswap64(y);
+#endif
+      return x < y ? -1 : 1;
+    }
+  }
+#endif
+  for (; i < n; i++) {
+    const uint8 x = static_cast<uint8>(a[i]);
+    const uint8 y = static_cast<uint8>(b[i]);
+    if (x != y) {
+      return x < y ? -1 : 1;
+    }
+  }
+  return 0;
+}
+
+} // namespace StrOps
+
+} // namespace MARTe
+
+#endif
@@ -0,0 +1,264 @@
+#include "StrView.h"
+#include "Str.h"
+#include "StrOps.h"
+#include <assert.h>
+#include <string.h>
+#if defined(__AVX2__)
+#include <immintrin.h>
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+namespace MARTe {
+
+namespace {
+
+using StrOps::load32;
+using StrOps::load64;
+
+/**
+ @brief position of the first occurrence of `needle` (at least 2 chars)
+ in `text`, or -1.
+
+ The vector paths compare a block of candidate positions at once on the
+ first and on the last char of the needle, and check only the candidates
+ matching both; the remaining positions use `memchr` on the first char.
+**/
+int32 find_bytes(const char *text, const uint32 n, const char *needle,
+                 const uint32 m) {
+  const uint32 positions = n - m + 1u;
+  uint32 i = 0u;
+#if defined(__AVX2__)
+  const __m256i first = _mm256_set1_epi8(needle[0]);
+  const __m256i last = _mm256_set1_epi8(needle[m - 1u]);
+  for (; i + 32u <= positions; i += 32u) {
+    const __m256i f = _mm256_loadu_si256(
+        reinterpret_cast<const __m256i *>(text + i));
+    const __m256i l = _mm256_loadu_si256(
+        reinterpret_cast<const __m256i *>(text + i + m - 1u));
+    uint32 mask = static_cast<uint32>(_mm256_movemask_epi8(_mm256_and_si256(
+        _mm256_cmpeq_epi8(f, first), _mm256_cmpeq_epi8(l, last))));
+    while (mask != 0u) {
+      const uint32 j = i + static_cast<uint32>(__builtin_ctz(mask));
+      if (StrOps::equal(text + j + 1u, needle + 1u, m - 2u)) {
+        return static_cast<int32>(j);
+      }
+      mask &= mask - 1u;
+    }
+  }
+#elif defined(__SSE2__)
+  const __m128i first = _mm_set1_epi8(needle[0]);
+  const __m128i last = _mm_set1_epi8(needle[m - 1u]);
+  for (; i + 16u <= positions; i += 16u) {
+    const __m128i f =
+        _mm_loadu_si128(reinterpret_cast<const __m128i *>(text + i));
+    const __m128i l =
+        _mm_loadu_si128(reinterpret_cast<const __m128i *>(text + i + m - 1u));
+    uint32 mask = static_cast<uint32>(_mm_movemask_epi8(
+        _mm_and_si128(_mm_cmpeq_epi8(f, first), _mm_cmpeq_epi8(l, last))));
+    while (mask != 0u) {
+      const uint32 j = i + static_cast<uint32>(__builtin_ctz(mask));
+      if (StrOps::equal(text + j + 1u, needle + 1u, m - 2u)) {
+        return static_cast<int32>(j);
+      }
+      mask &= mask - 1u;
+    }
+  }
+#endif
+  while (i < positions) {
+    const char *it = static_cast<const char *>(
+        memchr(text + i, needle[0], positions - i));
+    if (it == NULL_PTR(const char *)) {
+      break;
+    }
+    i = static_cast<uint32>(it - text);
+    if (StrOps::equal(it + 1, needle + 1u, m - 1u)) {
+      return static_cast<int32>(i);
+    }
+    i++;
+  }
+  return -1;
+}
+
+// constants of the 64 bits hash (wyhash)
+const uint64 secret0 = 0xa0761d6478bd642fULL;
+const uint64 secret1 = 0xe7037ed1a0b428dbULL;
+const uint64 secret2 = 0x8ebc6af09c88c6e3ULL;
+const uint64 secret3 = 0x589965cc75374cc3ULL;
+
+/**
+ @brief 128 bits product of `a` and `b`, the low half in `a` and the high
+ half in `b`.
+**/
+inline void mum(uint64 &a, uint64 &b) {
+#if defined(__SIZEOF_INT128__)
+  const unsigned __int128 r = static_cast<unsigned __int128>(a) * b;
+  a = static_cast<uint64>(r);
+  b = static_cast<uint64>(r >> 64);
+#else
+  const uint64 ha = a >> 32, hb = b >> 32;
+  const uint64 la = static_cast<uint32>(a), lb = static_cast<uint32>(b);
+  const uint64 rh = ha * hb, rm0 = ha * lb, rm1 = hb * la, rl = la * lb;
+  const uint64 t = rl + (rm0 << 32);
+  uint64 c = t < rl ? 1u : 0u;
+  const uint64 lo = t + (rm1 << 32);
+  c += lo < t ? 1u : 0u;
+  a = lo;
+  b = rh + (rm0 >> 32) + (rm1 >> 32) + c;
+#endif
+}
+
+inline uint64 mix(uint64 a, uint64 b) {
+  mum(a, b);
+  return a ^ b;
+}
+
+inline uint64 load_small(const char *p, const uint32 n) {
+  return (static_cast<uint64>(static_cast<uint8>(p[0])) << 16) |
+         (static_cast<uint64>(static_cast<uint8>(p[n >> 1])) << 8) |
+         static_cast<uint64>(static_cast<uint8>(p[n - 1u]));
+}
+
+/**
+ @brief wyhash (final version 4) of `n` bytes, reading 8 or 16 bytes per
+ step.
+**/
+uint64 hash_bytes(const char *p, const uint32 n) {
+  uint64 seed = mix(secret0, secret1);
+  uint64 a, b;
+  if (n <= 16u) {
+    if (n >= 4u) {
+      const uint32 d = (n >> 3) << 2;
+      a = (static_cast<uint64>(load32(p)) << 32) | load32(p + d);
+      b = (static_cast<uint64>(load32(p + n - 4u)) << 32) |
+          load32(p + n - 4u - d);
+    } else if (n > 0u) {
+      a = load_small(p, n);
+      b = 0u;
+    } else {
+      a = 0u;
+      b = 0u;
+    }
+  } else {
+    uint32 i = n;
+    if (i > 48u) {
+      uint64 see1 = seed, see2 = seed;
+      do {
+        seed = mix(load64(p) ^ secret1, load64(p + 8u) ^ seed);
+        see1 = mix(load64(p + 16u) ^ secret2, load64(p + 24u) ^ see1);
+        see2 = mix(load64(p + 32u) ^ secret3, load64(p + 40u) ^ see2);
+        p += 48u;
+        i -= 48u;
+      } while (i > 48u);
+      seed ^= see1 ^ see2;
+    }
+    while (i > 16u) {
+      seed = mix(load64(p) ^ secret1, load64(p + 8u) ^ seed);
+      i -= 16u;
+      p += 16u;
+    }
+    a = load64(p + i - 16u);
+    b = load64(p + i - 8u);
+  }
+  a ^= secret1;
+  b ^= seed;
+  mum(a, b);
+  return mix(a ^ secret0 ^ n, b ^ secret1);
+}
+
+} // namespace
+
+StrView::StrView() : ptr_(""), len_(0u) {}
+
+StrView::StrView(const char *str) : ptr_(str), len_(strlen(str)) {}
+
+StrView::StrView(const char *str, const uint32 len) : ptr_(str), len_(len) {}
+
+uint32 StrView::len() const { return len_; }
+
+const char *StrView::data() const { return ptr_; }
+
+bool StrView::empty() const { return len_ == 0u; }
+
+char StrView::operator[](int32 i) const {
+  int32 j = i >= 0 ? i : ((int32)len_ + i);
+  assert(j >= 0 && (uint32)j < len_);
+  return ptr_[j];
+}
+
+StrView StrView::substr(const int32 end) const {
+  int32 len = end <= 0 ? ((int32)len_ + end) : end;
+  if (len < 0)
+    return StrView();
+  if ((uint32)len >= len_)
+    return *this;
+  return StrView(ptr_, (uint32)len);
+}
+
+StrView StrView::substr(const int32 start, const int32 end) const {
+  int32 i0, ie;
+  i0 = start < 0 ? ((int32)len_ + start) : start;
+  ie = end <= 0 ? ((int32)len_ + end) : end;
+
+  if (ie > (int32)len_) {
+    ie = len_;
+  }
+
+  if (i0 >= (int32)len_ || ie <= i0 || ie < 0 || i0 < 0) {
+    return StrView();
+  }
+  return StrView(ptr_ + i0, (uint32)(ie - i0));
+}
+
+Option<uint32> StrView::find(const StrView &str, const uint32 &start) const {
+  if (str.len_ == 0 || start + str.len_ > len_) {
+    return Option<uint32>();
+  }
+  if (str.len_ == 1u) {
+    return find(str.ptr_[0], start);
+  }
+  const int32 i = find_bytes(ptr_ + start, len_ - start, str.ptr_, str.len_);
+  if (i < 0) {
+    return Option<uint32>();
+  }
+  return Option<uint32>(start + static_cast<uint32>(i));
+}
+
+Option<uint32> StrView::find(const char &ch, const uint32 &start) const {
+  if (start >= len_) {
+    return Option<uint32>();
+  }
+  const void *it = memchr(ptr_ + start, ch, len_ - start);
+  if (it == NULL_PTR(const void *)) {
+    return Option<uint32>();
+  }
+  return Option<uint32>(
+      static_cast<uint32>(static_cast<const char *>(it) - ptr_));
+}
+
+uint32 StrView::hash() const {
+  const uint64 h = hash64();
+  return static_cast<uint32>(h ^ (h >> 32));
+}
+
+uint64 StrView::hash64() const { return hash_bytes(ptr_, len_); }
+
+bool StrView::operator==(const StrView &other) const {
+  return len_ == other.len_ && StrOps::equal(ptr_, other.ptr_, len_);
+}
+
+bool StrView::operator!=(const StrView &other) const {
+  return !(*this == other);
+}
+
+bool StrView::operator<(const StrView &other) const {
+  const uint32 min = len_ < other.len_ ? len_ : other.len_;
+  const int32 cmp = StrOps::compare(ptr_, other.ptr_, min);
+  return cmp < 0 || (cmp == 0 && len_ < other.len_);
+}
+
+bool StrView::operator>(const StrView &other) const { return other < *this; }
+
+Str StrView::str() const { return Str(ptr_, len_); }
+
+} // namespace MARTe
@@ -0,0 +1,120 @@
+#ifndef STR_VIEW_H__
+#define STR_VIEW_H__
+
+#include "CompilerTypes.h"
+#include "Option.h"
+
+namespace MARTe {
+
+class Str;
+
+/**
+  @brief Non-owning slice of a string.
+
+        A view is a pointer and a length: creating, copying and slicing it
+never allocates nor copies the characters. The viewed memory must outlive
+the view and it is not necessarily null terminated.
+**/
+class StrView {
+public:
+  /**
+    @brief Create an empty view
+  **/
+  StrView();
+  /**
+    @brief View of a c string.
+    @param str null terminated string
+  **/
+  StrView(const char *str);
+  /**
+    @brief View of the first `len` chars of a buffer.
+    @param str buffer
+    @param len number of chars
+  **/
+  StrView(const char *str, const uint32 len);
+
+  /**
+    @brief Gets the view length.
+  **/
+  uint32 len() const;
+  /**
+    @brief Gets the first viewed char (not null terminated).
+  **/
+  const char *data() const;
+  /**
+    @brief Check if the view is empty.
+  **/
+  bool empty() const;
+
+  /**
+    @brief operator to access the i-th char
+    @param i index of the char to get (if negative counted from the end)
+    @return char at i-th position
+  **/
+  char operator[](int32 i) const;
+
+  /**
+    @brief shorten the view at the specified index (same semantic of
+    `Str::substr`).
+    @param end index of the view (if negative will be deduced from len)
+  **/
+  StrView substr(const int32 end) const;
+  /**
+    @brief sub-view with the given start and end indexes (same semantic of
+    `Str::substr`).
+    @param start index
+    @param end index (if negative will be deduced from len)
+  **/
+  StrView substr(const int32 start, const int32 end) const;
+
+  /**
+    @brief find position of a sub-string
+    @param str is the sub string to find
+    @param start is the initial index where to start searching
+    @return index if found
+  **/
+  Option<uint32> find(const StrView &str, const uint32 &start = 0) const;
+  Option<uint32> find(const char &ch, const uint32 &start = 0) const;
+
+  /**
+    @brief hash of the viewed chars (same as `Str::hash`), `hash64` folded
+    on 32 bits
+  **/
+  uint32 hash() const;
+  /**
+    @brief 64 bits hash of the viewed chars (same as `Str::hash64`)
+  **/
+  uint64 hash64() const;
+
+  /**
+    @brief equality operator
+    @return true if same length and content.
+  **/
+  bool operator==(const StrView &other) const;
+  /**
+    @brief disequality operator
+    @return true if different length or content.
+  **/
+  bool operator!=(const StrView &other) const;
+  /**
+    @brief lexicographic order
+  **/
+  bool operator<(const StrView &other) const;
+  /**
+    @brief lexicographic order
+  **/
+  bool operator>(const StrView &other) const;
+
+  /**
+    @brief Copy the viewed chars in a new string.
+  **/
+  Str str() const;
+
+private:
+  const char *ptr_; // first char
+  uint32 len_;      // length of the view
+};
+
+}; // namespace MARTe
+
+#endif
@@ -1,14 +1,102 @@
 #ifndef _ARRAY_H__
 #define _ARRAY_H__
 
+#include "Allocator.h"
 #include "ErrorType.h"
 #include "Option.h"
 #include "Rc.h"
 #include "Result.h"
 
 #include <assert.h>
+#include <new>
+#include <string.h>
+#if __cplusplus >= 201103L
+#include <type_traits>
+#include <utility>
+#endif
 
 namespace MARTe {
+
+/**
+  @brief true if values of type T can be copied with `memcpy`.
+**/
+template <typename T> struct TriviallyCopyable {
+#if __cplusplus >= 201103L
+  static const bool value = std::is_trivially_copyable<T>::value;
+#else
+  static const bool value = __is_pod(T);
+#endif
+};
+
+/**
+  @brief element-wise operations on raw (not constructed) memory.
+
+  Selected at compile time: trivially copyable types are copied with
+  `memcpy`/`memmove` and never destroyed.
+**/
+template <typename T, bool trivial = TriviallyCopyable<T>::value>
+struct ArrayOps {
+  /**
+    @brief copy construct `size` elements in uninitialised memory
+  **/
+  static inline void copy(T *res, const T *src, uint32 size) {
+    for (uint32 i = 0u; i < size; i++) {
+      new (res + i) T(src[i]);
+    }
+  }
+  /**
+    @brief move `size` elements to uninitialised memory, destroying the source
+  **/
+  static inline void relocate(T *res, T *src, uint32 size) {
+    for (uint32 i = 0u; i < size; i++) {
+#if __cplusplus >= 201103L
+      new (res + i) T(std::move(src[i]));
+#else
+      new (res + i) T(src[i]);
+#endif
+      src[i].~T();
+    }
+  }
+  /**
+    @brief shift `size - 1` elements one position left, destroying the last
+  **/
+  static inline void shift(T *arr, uint32 size) {
+    for (uint32 i = 0u; i + 1u < size; i++) {
+#if __cplusplus >= 201103L
+      arr[i] = std::move(arr[i + 1u]);
+#else
+      arr[i] = arr[i + 1u];
+#endif
+    }
+    arr[size - 1u].~T();
+  }
+  /**
+    @brief destroy `size` elements
+  **/
+  static inline void destroy(T *arr, uint32 size) {
+    for (uint32 i = 0u; i < size; i++) {
+      arr[i].~T();
+    }
+  }
+};
+
+template <typename T> struct ArrayOps<T, true> {
+  static inline void copy(T *res, const T *src, uint32 size) {
+    if (size > 0u) {
+      memcpy(static_cast<void *>(res), src, size * sizeof(T));
+    }
+  }
+  static inline void relocate(T *res, T *src, uint32 size) {
+    copy(res, src, size);
+  }
+  static inline void shift(T *arr, uint32 size) {
+    if (size > 1u) {
+      memmove(static_cast<void *>(arr), arr + 1, (size - 1u) * sizeof(T));
+    }
+  }
+  static inline void destroy(T *, uint32) {}
+};
+
 /**
   @brief dynamic array of type T
 
@@ -17,33 +105,76 @@ namespace MARTe {
   buffer.
 
   If the array grows bigger than the buffer, a new
-  bigger buffer will be created and data copied.
+  buffer of double size will be created and data moved,
+  so appending is amortised O(1).
+  Only the first `len()` elements of the buffer are constructed.
+
+  The buffer comes from an optional `Allocator` (e.g. an `Arena`). The
+  allocator follows the buffer: copies and moves of the array use the same
+  allocator, while assigning to an existing array keeps its own.
 
   @param T type of the contained value
 **/
 template <typename T> class Vec {
 public:
+  /**
+    @brief position in the array.
+
+    Value type (no allocation), invalid once moved outside of the
+    array: it can be used both as a cursor (`it; it = it.next()`) and
+    with `begin()`/`end()` (`it != v.end(); ++it`).
+  **/
   class iterator {
   public:
-    Rc<iterator> next() {
-      if (pos + 1 >= parent->size_) {
-        return Rc<iterator>();
-      }
-      return new iterator(parent, pos + 1);
+    /**
+      @brief invalid iterator
+    **/
+    inline iterator() : parent(NULL_PTR(const Vec *)), pos(0u) {}
+
+    /**
+      @brief iterator to the next element (invalid if past the end)
+    **/
+    inline iterator next() const { return iterator(parent, pos + 1u); }
+    /**
+      @brief iterator to the previous element (invalid if before the start)
+    **/
+    inline iterator prev() const { return iterator(parent, pos - 1u); }
+    /**
+      @brief element at the current position
+    **/
+    inline T &value() const {
+      assert(*this);
+      return parent->arr_[pos];
     }
-    Rc<iterator> prev() {
-      if (pos == 0) {
-        return Rc<iterator>();
-      }
-      return new iterator(parent, pos - 1);
+    /**
+      @brief index of the current position
+    **/
+    inline uint32 index() const { return pos; }
+
+    inline T &operator*() const { return value(); }
+    inline iterator &operator++() {
+      pos++;
+      return *this;
+    }
+    inline iterator &operator--() {
+      pos--;
+      return *this;
+    }
+    inline bool operator==(const iterator &other) const {
+      return parent == other.parent && pos == other.pos;
+    }
+    inline bool operator!=(const iterator &other) const {
+      return !(*this == other);
+    }
+    /**
+      @brief true if the iterator points to an element of the array
+    **/
+    inline operator bool() const {
+      return parent != NULL_PTR(const Vec *) && pos < parent->size_;
     }
-    T &value() { return parent->arr_[pos]; }
 
   private:
-    inline iterator(const Vec *v, uint32 i) : parent(v), pos(i) {
-      assert(parent != NULL_PTR(Vec *));
-      assert(pos < parent->size_);
-    }
+    inline iterator(const Vec *v, uint32 i) : parent(v), pos(i) {}
     const Vec *parent;
     uint32 pos;
 
@@ -52,64 +183,174 @@ public:
   /**
     @brief empty array with an initialized empty buffer.
     @param init_size intial buffer size
+    @param allocator source of the buffer (heap if null), the array is left
+    without buffer if it is exhausted
+  **/
+  inline Vec(uint32 init_size = step,
+             Allocator *allocator = NULL_PTR(Allocator *))
+      : alloc_(allocator), arr_(allocate(init_size)), size_(0u),
+        buffsize_(arr_ != NULL_PTR(T *) ? init_size : 0u), borrowed_(false) {}
+
+  /**
+    @brief copy constructor (same allocator of the other array), empty if
+    the allocator is exhausted
   **/
-  inline Vec(uint32 init_size = step) : size_(0u), buffsize_(init_size) {
-    arr_ = new T[buffsize_];
+  inline Vec(const Vec &other)
+      : alloc_(other.alloc_), arr_(allocate(other.size_ + step)),
+        size_(arr_ != NULL_PTR(T *) ? other.size_ : 0u),
+        buffsize_(arr_ != NULL_PTR(T *) ? other.size_ + step : 0u),
+        borrowed_(false) {
+    ArrayOps<T>::copy(arr_, other.arr_, size_);
   }
 
+#if __cplusplus >= 201103L
   /**
-    @brief copy constructor
+    @brief move constructor, the other array is left empty
   **/
-  inline Vec(const Vec &other) {
-    buffsize_ = other.size_;
-    size_ = other.size_;
-    arr_ = new T[size_];
-    copy(arr_, other.arr_, size_);
+  inline Vec(Vec &&other) noexcept
+      : alloc_(NULL_PTR(Allocator *)), arr_(NULL_PTR(T *)), size_(0u),
+        buffsize_(0u), borrowed_(false) {
+    take(other);
   }
+#endif
 
   /**
     @brief create a dynamic array from a standard array
     @param array array to be copied
     @param size size of the array
+    @param allocator source of the buffer (heap if null), the array is
+    empty if it is exhausted
   **/
-  inline Vec(const T array[], const uint32 size)
-      : size_(size), buffsize_(size + step) {
-    arr_ = new T[buffsize_];
-    copy(arr_, array, size);
+  inline Vec(const T array[], const uint32 size,
+             Allocator *allocator = NULL_PTR(Allocator *))
+      : alloc_(allocator), arr_(allocate(size + step)),
+        size_(arr_ != NULL_PTR(T *) ? size : 0u),
+        buffsize_(arr_ != NULL_PTR(T *) ? size + step : 0u), borrowed_(false) {
+    ArrayOps<T>::copy(arr_, array, size_);
   }
 
   /**
     @brief destructor, clean the buffer
   **/
-  inline ~Vec() { delete[] arr_; }
+  inline ~Vec() {
+    ArrayOps<T>::destroy(arr_, size_);
+    release();
+  }
 
   /**
     @brief add item to the array
+    @return false if the allocator is exhausted (the array is unchanged)
+  **/
+  inline bool append(const T &item) {
+    if (size_ < buffsize_) {
+      new (arr_ + size_) T(item);
+    } else {
+      // item may be an element of the array: copy it before moving the rest
+      const uint32 nsize = grown(size_ + 1u);
+      T *arr = allocate(nsize);
+      if (arr == NULL_PTR(T *)) {
+        return false;
+      }
+      new (arr + size_) T(item);
+      adopt(arr, nsize);
+    }
+    size_++;
+    return true;
+  }
+
+#if __cplusplus >= 201103L
+  /**
+    @brief move item at the end of the array
+    @return false if the allocator is exhausted (the array is unchanged)
+  **/
+  inline bool append(T &&item) {
+    if (size_ < buffsize_) {
+      new (arr_ + size_) T(std::move(item));
+    } else {
+      const uint32 nsize = grown(size_ + 1u);
+      T *arr = allocate(nsize);
+      if (arr == NULL_PTR(T *)) {
+        return false;
+      }
+      new (arr + size_) T(std::move(item));
+      adopt(arr, nsize);
+    }
+    size_++;
+    return true;
+  }
+
+  /**
+    @brief construct a new element in place at the end of the array
+    @param args arguments of the element constructor
+    @return the new element, null if the allocator is exhausted
+  **/
+  template <typename... Args> inline T *emplace(Args &&...args) {
+    if (size_ < buffsize_) {
+      new (arr_ + size_) T(std::forward<Args>(args)...);
+    } else {
+      const uint32 nsize = grown(size_ + 1u);
+      T *arr = allocate(nsize);
+      if (arr == NULL_PTR(T *)) {
+        return NULL_PTR(T *);
+      }
+      new (arr + size_) T(std::forward<Args>(args)...);
+      adopt(arr, nsize);
+    }
+    return &arr_[size_++];
+  }
+#else
+  /**
+    @brief default construct a new element in place at the end of the array
+    @return the new element, null if the allocator is exhausted
   **/
-  inline void append(T item) {
-    if (size_ + 1u > buffsize_) {
-      T *arr = new T[buffsize_ + step];
-      copy(arr, arr_, buffsize_);
-      delete[] arr_;
-      arr_ = arr;
-      buffsize_ += step;
+  inline T *emplace() {
+    if (size_ >= buffsize_ && !reserve(grown(size_ + 1u))) {
+      return NULL_PTR(T *);
     }
-    arr_[size_++] = item;
+    new (arr_ + size_) T();
+    return &arr_[size_++];
+  }
+#endif
+
+  /**
+    @brief make room for at least `size` elements without reallocating
+    @param size number of elements
+    @return false if the allocator is exhausted (the array is unchanged)
+  **/
+  inline bool reserve(const uint32 size) {
+    if (size > buffsize_) {
+      T *arr = allocate(size);
+      if (arr == NULL_PTR(T *)) {
+        return false;
+      }
+      adopt(arr, size);
+    }
+    return true;
   }
 
   /**
     @brief copy an standard array inside the dyn array
     @param arr standard array to be copied
     @param size size of the input array
+    @return false if the allocator is exhausted (the array is unchanged)
   **/
-  inline void set(const T *arr, const uint32 size) {
-    size_ = size;
+  inline bool set(const T *arr, const uint32 size) {
+    T *buff = arr_;
     if (size > buffsize_) {
+      buff = allocate(size + step);
+      if (buff == NULL_PTR(T *)) {
+        return false;
+      }
+    }
+    ArrayOps<T>::destroy(arr_, size_);
+    if (buff != arr_) {
+      release();
+      arr_ = buff;
       buffsize_ = size + step;
-      delete[] arr_;
-      arr_ = new T[buffsize_];
     }
-    copy(arr_, arr, size);
+    size_ = size;
+    ArrayOps<T>::copy(arr_, arr, size);
+    return true;
   }
 
   /**
@@ -121,7 +362,7 @@ public:
   inline bool remove(int32 i) {
     int j = i + (i >= 0 ? 0 : (int32)size_);
     if (j >= 0 && j < (int32)size_) {
-      copy(arr_ + j, arr_ + j + 1, (int32)size_ - (j + 1));
+      ArrayOps<T>::shift(arr_ + j, size_ - static_cast<uint32>(j));
       size_--;
       return true;
     }
@@ -135,7 +376,7 @@ public:
     @return index (uint32) of the item if found
     @return empty optional if not found
   **/
-  inline Option<uint32> find(T item, uint32 from = 0) {
+  inline Option<uint32> find(const T &item, uint32 from = 0) {
     for (uint32 i = from; i < size_; i++) {
       if (arr_[i] == item)
         return i;
@@ -150,10 +391,9 @@ public:
     @return true if the element is inside the array
     @return false if not
   **/
-  inline bool contains(T item, uint32 from = 0) {
+  inline bool contains(const T &item, uint32 from = 0) {
     return !find(item, from).empty();
   }
-
   /**
     @brief get the elements at i-th position
 
@@ -235,26 +475,36 @@ public:
   /**
     @brief assign  operator for two arrays
     @param other second array
-    @return itself
+    @return itself (unchanged if the allocator is exhausted)
   **/
   inline Vec &operator=(const Vec &other) {
-    if (other.size_ > buffsize_) {
-      T *arr = new T[other.size_ + step];
-      delete[] arr_;
-      arr_ = arr;
-      buffsize_ = other.size_ + step;
+    if (this != &other) {
+      (void)set(other.arr_, other.size_);
+    }
+    return *this;
+  }
+
+#if __cplusplus >= 201103L
+  /**
+    @brief move assign operator, the other array is left empty
+    @param other second array
+    @return itself
+  **/
+  inline Vec &operator=(Vec &&other) noexcept {
+    if (this != &other) {
+      clear();
+      take(other);
     }
-    size_ = other.size_;
-    copy(arr_, other.arr_, other.size_);
     return *this;
   }
+#endif
 
   /**
     @brief add element  operator
     @param other element to be added
     @return itself
   **/
-  inline Vec &operator+=(const T other) {
+  inline Vec &operator+=(const T &other) {
     this->append(other);
     return *this;
   }
@@ -269,42 +519,131 @@ public:
     @return total number of elements of the buffer
   **/
   inline uint32 mem_size() const { return buffsize_; }
+  /**
+    @brief allocator of the buffer (null for the heap)
+  **/
+  inline Allocator *allocator() const { return alloc_; }
 
   /**
-    @brief reset the size counter
+    @brief remove all the elements, keeping the buffer
   **/
-  inline void clear() { size_ = 0; }
+  inline void clear() {
+    ArrayOps<T>::destroy(arr_, size_);
+    size_ = 0;
+  }
   /**
-    @brief reduce the size of the buffer to match
-    the number of data
+    @brief reduce the size of the buffer to the number of data
+    rounded up to the allocation step (the buffer never grows)
   **/
   inline void reduce() {
-    uint32 nsize = ((size_ / step) + 1) * step;
-    T *arr = new T[nsize];
-    copy(arr, arr_, size_);
-    delete[] arr_;
-    arr_ = arr;
-    buffsize_ = nsize;
+    uint32 nsize = ((size_ + step - 1u) / step) * step;
+    if (nsize == 0u) {
+      nsize = step;
+    }
+    T *arr = !borrowed_ && nsize < buffsize_ ? allocate(nsize) : NULL_PTR(T *);
+    if (arr != NULL_PTR(T *)) {
+      adopt(arr, nsize);
+    }
   }
 
-  inline Rc<iterator> iterate() const {
-    if (size_ == 0) {
-      return Rc<iterator>();
+  /**
+    @brief iterator to the first element (invalid if the array is empty)
+  **/
+  inline iterator iterate() const { return iterator(this, 0u); }
+  /**
+    @brief iterator to the first element
+  **/
+  inline iterator begin() const { return iterator(this, 0u); }
+  /**
+    @brief iterator past the last element
+  **/
+  inline iterator end() const { return iterator(this, size_); }
+
+protected:
+  /**
+    @brief empty array using an external uninitialised buffer
+
+    The buffer is never freed by the array and must outlive it, it is
+    replaced by a heap buffer when more than `size` elements are needed.
+    @param size size of the buffer
+    @param buffer buffer
+  **/
+  inline Vec(const uint32 size, T *buffer)
+      : alloc_(NULL_PTR(Allocator *)), arr_(buffer), size_(0u),
+        buffsize_(size), borrowed_(true) {}
+
+#if __cplusplus >= 201103L
+  /**
+    @brief take the elements of an array (with no elements).
+
+    Owned buffers are stolen (with their allocator), elements of borrowed
+    buffers are moved (unless the allocator is exhausted).
+  **/
+  inline void take(Vec &other) {
+    if (other.borrowed_) {
+      if (reserve(other.size_)) {
+        ArrayOps<T>::relocate(arr_, other.arr_, other.size_);
+        size_ = other.size_;
+        other.size_ = 0u;
+      }
+    } else {
+      release();
+      alloc_ = other.alloc_;
+      arr_ = other.arr_;
+      size_ = other.size_;
+      buffsize_ = other.buffsize_;
+      other.arr_ = NULL_PTR(T *);
+      other.size_ = 0u;
+      other.buffsize_ = 0u;
     }
-    return iterator(this, 0);
   }
+#endif
 
 private:
-  inline static void copy(T *res, const T *src, uint32 size) {
-    // memcpy(res, src, size * sizeof(T));
-    for (uint32 i = 0u; i < size; i++) {
-      res[i] = src[i]; // To work with non trivial types
+  /**
+    @brief allocate an uninitialised buffer (null if the allocator is
+    exhausted)
+  **/
+  inline T *allocate(const uint32 size) const {
+    return size > 0u ? static_cast<T *>(
+                           MARTe::allocate(alloc_, size * sizeof(T)))
+                     : NULL_PTR(T *);
+  }
+  /**
+    @brief free the buffer unless it is borrowed
+  **/
+  inline void release() {
+    if (!borrowed_) {
+      MARTe::deallocate(alloc_, arr_, buffsize_ * sizeof(T));
     }
+    arr_ = NULL_PTR(T *);
+    borrowed_ = false;
+  }
+
+  /**
+    @brief buffer size needed to store at least `size` elements
+  **/
+  inline uint32 grown(const uint32 size) const {
+    uint32 nsize = buffsize_ > 0u ? 2u * buffsize_ : step;
+    return nsize < size ? size : nsize;
   }
+
+  /**
+    @brief move the elements in a new buffer and take its ownership
+  **/
+  inline void adopt(T *arr, const uint32 nsize) {
+    ArrayOps<T>::relocate(arr, arr_, size_);
+    release();
+    arr_ = arr;
+    buffsize_ = nsize;
+  }
+
   static const uint32 step = 16;
+  Allocator *alloc_; // source of the buffer (null for the heap)
   T *arr_;
   uint32 size_;
   uint32 buffsize_;
+  bool borrowed_; // buffer not owned by the array (see `SmallVec`)
 };
 } // namespace MARTe
 
@@ -0,0 +1,114 @@
+/**
+ * @file Bench.cpp
+ * @brief Source file for the benchmark helpers
+ * @date 18/10/2026
+ *
+ * @copyright Copyright 2015 F4E | European Joint Undertaking for ITER and
+ * the Development of Fusion Energy ('Fusion for Energy').
+ * Licensed under the EUPL, Version 1.1 or - as soon they will be approved
+ * by the European Commission - subsequent versions of the EUPL (the "Licence")
+ * You may not use this work except in compliance with the Licence.
+ * You may obtain a copy of the Licence at: http://ec.europa.eu/idabc/eupl
+ *
+ * @warning Unless required by applicable law or agreed to in writing,
+ * software distributed under the Licence is distributed on an "AS IS"
+ * basis, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+ * or implied. See the Licence permissions and limitations under the Licence.
+ */
+
+/*---------------------------------------------------------------------------*/
+/*                         Standard header includes                          */
+/*---------------------------------------------------------------------------*/
+
+#include <new>
+#include <stdlib.h>
+#include <time.h>
+
+/*---------------------------------------------------------------------------*/
+/*                         Project header includes                           */
+/*---------------------------------------------------------------------------*/
+
+#include "Bench.h"
+
+/*---------------------------------------------------------------------------*/
+/*                           Static definitions                              */
+/*---------------------------------------------------------------------------*/
+
+#if __cplusplus >= 201103L
+#define BENCH_THROW_BAD_ALLOC
+#define BENCH_NOTHROW noexcept
+#else
+#define BENCH_THROW_BAD_ALLOC throw(std::bad_alloc)
+#define BENCH_NOTHROW throw()
+#endif
+
+namespace {
+volatile MARTe::uint64 alloc_count = 0u;
+volatile MARTe::uint64 alloc_bytes = 0u;
+volatile const void *sink = NULL;
+
+void *counted_alloc(size_t size) {
+  __sync_fetch_and_add(&alloc_count, 1u);
+  __sync_fetch_and_add(&alloc_bytes, static_cast<MARTe::uint64>(size));
+  void *ptr = malloc(size > 0u ? size : 1u);
+  if (ptr == NULL) {
+    throw std::bad_alloc();
+  }
+  return ptr;
+}
+} // namespace
+
+void *operator new(size_t size) BENCH_THROW_BAD_ALLOC {
+  return counted_alloc(size);
+}
+
+void *operator new[](size_t size) BENCH_THROW_BAD_ALLOC {
+  return counted_alloc(size);
+}
+
+void operator delete(void *ptr) BENCH_NOTHROW { free(ptr); }
+
+void operator delete[](void *ptr) BENCH_NOTHROW { free(ptr); }
+
+/*---------------------------------------------------------------------------*/
+/*                           Method definitions                              */
+/*---------------------------------------------------------------------------*/
+
+namespace bench {
+
+allocs_t allocations() {
+  allocs_t a;
+  a.count = __sync_fetch_and_add(&alloc_count, 0u);
+  a.bytes = __sync_fetch_and_add(&alloc_bytes, 0u);
+  return a;
+}
+
+MARTe::uint64 now_ns() {
+  timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return static_cast<MARTe::uint64>(ts.tv_sec) * 1000000000u +
+         static_cast<MARTe::uint64>(ts.tv_nsec);
+}
+
+Measure::Measure() : ns(0u), allocs(0u), bytes(0u), t0(0u) {
+  a0.count = 0u;
+  a0.bytes = 0u;
+  start();
+}
+
+void Measure::start() {
+  a0 = allocations();
+  t0 = now_ns();
+}
+
+void Measure::stop() {
+  const MARTe::uint64 t1 = now_ns();
+  const allocs_t a1 = allocations();
+  ns += t1 - t0;
+  allocs += a1.count - a0.count;
+  bytes += a1.bytes - a0.bytes;
+}
+
+void keep(const void *ptr) { sink = ptr; }
+
+} // namespace bench
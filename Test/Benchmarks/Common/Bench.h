@@ -0,0 +1,92 @@
+/**
+ * @file Bench.h
+ * @brief Header file for the benchmark helpers
+ * @date 18/10/2026
+ *
+ * @copyright Copyright 2015 F4E | European Joint Undertaking for ITER and
+ * the Development of Fusion Energy ('Fusion for Energy').
+ * Licensed under the EUPL, Version 1.1 or - as soon they will be approved
+ * by the European Commission - subsequent versions of the EUPL (the "Licence")
+ * You may not use this work except in compliance with the Licence.
+ * You may obtain a copy of the Licence at: http://ec.europa.eu/idabc/eupl
+ *
+ * @warning Unless required by applicable law or agreed to in writing,
+ * software distributed under the Licence is distributed on an "AS IS"
+ * basis, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+ * or implied. See the Licence permissions and limitations under the Licence.
+
+ * @details Timing and heap allocation counters shared by the benchmark
+ * executables. Linking `Bench.a` replaces the global `operator new` and
+ * `operator delete` with counting versions.
+ */
+
+#ifndef BENCH_H_
+#define BENCH_H_
+
+/*---------------------------------------------------------------------------*/
+/*                        Standard header includes                           */
+/*---------------------------------------------------------------------------*/
+
+/*---------------------------------------------------------------------------*/
+/*                        Project header includes                            */
+/*---------------------------------------------------------------------------*/
+
+#include "CompilerTypes.h"
+
+namespace bench {
+
+/**
+ * @brief Heap usage counters
+ **/
+struct allocs_t {
+  MARTe::uint64 count; //!< number of allocations
+  MARTe::uint64 bytes; //!< number of bytes allocated
+};
+
+/**
+ * @brief Allocations performed since the start of the process.
+ **/
+allocs_t allocations();
+
+/**
+ * @brief Monotonic time in nanoseconds.
+ **/
+MARTe::uint64 now_ns();
+
+/**
+ * @brief Measure of a benchmarked section (time and allocations).
+ **/
+class Measure {
+public:
+  /**
+   * @brief Start the measure.
+   **/
+  Measure();
+
+  /**
+   * @brief Restart the measure.
+   **/
+  void start();
+
+  /**
+   * @brief Stop the measure (accumulating with the previous sections).
+   **/
+  void stop();
+
+  MARTe::uint64 ns;     //!< elapsed time
+  MARTe::uint64 allocs; //!< number of allocations
+  MARTe::uint64 bytes;  //!< number of bytes allocated
+
+private:
+  MARTe::uint64 t0;
+  allocs_t a0;
+};
+
+/**
+ * @brief Prevent the compiler from optimising away a computed value.
+ **/
+void keep(const void *ptr);
+
+} // namespace bench
+
+#endif /* BENCH_H_ */
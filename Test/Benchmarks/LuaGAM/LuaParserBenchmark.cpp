@@ -0,0 +1,368 @@
+/**
+ * @file LuaParserBenchmark.cpp
+ * @brief Benchmark of the LuaGAM parser and verifier
+ * @date 18/10/2026
+ *
+ * @copyright Copyright 2015 F4E | European Joint Undertaking for ITER and
+ * the Development of Fusion Energy ('Fusion for Energy').
+ * Licensed under the EUPL, Version 1.1 or - as soon they will be approved
+ * by the European Commission - subsequent versions of the EUPL (the "Licence")
+ * You may not use this work except in compliance with the Licence.
+ * You may obtain a copy of the Licence at: http://ec.europa.eu/idabc/eupl
+ *
+ * @warning Unless required by applicable law or agreed to in writing,
+ * software distributed under the Licence is distributed on an "AS IS"
+ * basis, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+ * or implied. See the Licence permissions and limitations under the Licence.
+
+ * @details Times separately the scanner (`LUA::scan`), the AST generation
+ * (`LUA::generate_ast`) and the `LuaGAMValidator` passes over the grammar
+ * corpora and over synthetic `GAM()` scripts of increasing size.
+ *
+ * Usage (from the repository root):
+ * ```
+ * LuaParserBenchmark.ex [-n iterations] [-s statements] [corpus files...]
+ * ```
+ * By default the corpora in `Test/Resources/LuaGAM` are used, together
+ * with synthetic scripts of 10, 100 and 1000 statement blocks.
+ */
+
+/*---------------------------------------------------------------------------*/
+/*                         Standard header includes                          */
+/*---------------------------------------------------------------------------*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/*---------------------------------------------------------------------------*/
+/*                         Project header includes                           */
+/*---------------------------------------------------------------------------*/
+
+#include "AST.h"
+#include "Bench.h"
+#include "ErrorManagement.h"
+#include "LuaParser.h"
+#include "LuaParserBaseTypes.h"
+#include "Verifier.h"
+
+/*---------------------------------------------------------------------------*/
+/*                           Static definitions                              */
+/*---------------------------------------------------------------------------*/
+
+using namespace MARTe;
+using namespace MARTe::LUA;
+
+#define N_SYNTH_INPUTS 8u
+#define MIN_STAGE_NS 200000000u
+
+namespace {
+
+/**
+ * @brief Growing text buffer used to load the sources.
+ **/
+struct text_t {
+  char8 *mem;
+  uint32 len;
+  uint32 size;
+};
+
+void text_init(text_t &text) {
+  text.size = 1024u;
+  text.len = 0u;
+  text.mem = static_cast<char8 *>(malloc(text.size));
+  text.mem[0] = 0;
+}
+
+void text_append(text_t &text, const char8 *str) {
+  const uint32 l = static_cast<uint32>(strlen(str));
+  if (text.len + l + 1u > text.size) {
+    while (text.len + l + 1u > text.size) {
+      text.size *= 2u;
+    }
+    text.mem = static_cast<char8 *>(realloc(text.mem, text.size));
+  }
+  memcpy(&text.mem[text.len], str, l + 1u);
+  text.len += l;
+}
+
+/**
+ * @brief Source benchmarked: a list of independent code snippets.
+ **/
+struct source_t {
+  char8 name[64];
+  char8 **codes;
+  uint32 n_codes;
+  uint32 bytes;
+  bool gam; //!< snippets are complete `GAM()` scripts
+};
+
+void source_add(source_t &src, const text_t &code) {
+  char8 **codes = new char8 *[src.n_codes + 1u];
+  for (uint32 i = 0u; i < src.n_codes; i++) {
+    codes[i] = src.codes[i];
+  }
+  codes[src.n_codes] = new char8[code.len + 1u];
+  memcpy(codes[src.n_codes], code.mem, code.len + 1u);
+  delete[] src.codes;
+  src.codes = codes;
+  src.n_codes++;
+  src.bytes += code.len;
+}
+
+void source_free(source_t &src) {
+  for (uint32 i = 0u; i < src.n_codes; i++) {
+    delete[] src.codes[i];
+  }
+  delete[] src.codes;
+}
+
+/**
+ * @brief Load the code snippets of a `.corpus` file.
+ **/
+bool load_corpus(const char8 *path, source_t &src) {
+  const char8 *base = strrchr(path, '/');
+  snprintf(src.name, sizeof(src.name), "%s", base != NULL ? base + 1 : path);
+  src.codes = NULL_PTR(char8 **);
+  src.n_codes = 0u;
+  src.bytes = 0u;
+  src.gam = false;
+  FILE *f = fopen(path, "r");
+  if (f == NULL) {
+    printf("Cannot open corpus `%s`\n", path);
+    return false;
+  }
+  text_t code;
+  text_init(code);
+  bool in_code = false;
+  char8 line[1024];
+  while (fgets(line, sizeof(line), f) != NULL) {
+    if (strncmp(line, "==== CODE ====", 14u) == 0) {
+      in_code = true;
+      code.len = 0u;
+      code.mem[0] = 0;
+    } else if (strncmp(line, "==== AST  ====", 14u) == 0) {
+      in_code = false;
+      source_add(src, code);
+    } else if (in_code) {
+      text_append(code, line);
+    }
+  }
+  free(code.mem);
+  fclose(f);
+  return src.n_codes > 0u;
+}
+
+/**
+ * @brief Generate a `GAM()` script with `blocks` groups of statements
+ * (loops, branches, calls, tables and comments) using the signals
+ * `x1..x8` and `y1..y8`.
+ **/
+void synthetic_gam(const uint32 blocks, source_t &src) {
+  snprintf(src.name, sizeof(src.name), "synthetic[%u]", blocks);
+  src.codes = NULL_PTR(char8 **);
+  src.n_codes = 0u;
+  src.bytes = 0u;
+  src.gam = true;
+  text_t code;
+  text_init(code);
+  char8 buff[512];
+  text_append(code, "function GAM()\n  local acc = 0\n");
+  for (uint32 b = 0u; b < blocks; b++) {
+    const uint32 i = b % N_SYNTH_INPUTS + 1u;
+    const uint32 j = (b + 3u) % N_SYNTH_INPUTS + 1u;
+    snprintf(buff, sizeof(buff),
+             "  -- block %u\n"
+             "  for k = 1, %u do\n"
+             "    acc = acc + x%u * k - (x%u / 2.5)\n"
+             "  end\n"
+             "  if x%u > 0.5 and not (x%u == %u) then\n"
+             "    y%u = acc * 2\n"
+             "  elseif x%u < 0 then\n"
+             "    y%u = -acc\n"
+             "  else\n"
+             "    y%u = math.sqrt(x%u + 1.5) .. \"\"\n"
+             "  end\n"
+             "  local t%u = {x%u, x%u + 1, key = \"value\"}\n"
+             "  acc = acc + #t%u + t%u[1] ^ 2 %% 7\n",
+             b, (b % 16u) + 1u, i, j, i, j, b, i, j, i, i, j, b, i, j, b, b);
+    text_append(code, buff);
+  }
+  for (uint32 k = 1u; k <= N_SYNTH_INPUTS; k++) {
+    snprintf(buff, sizeof(buff), "  y%u = y%u + acc\n", k, k);
+    text_append(code, buff);
+  }
+  text_append(code, "end\n");
+  source_add(src, code);
+  free(code.mem);
+}
+
+uint32 count_nodes(Nodep node) {
+  uint32 n = 1u;
+  for (uint32 i = 0u; i < node->sub_nodes.len(); i++) {
+    n += count_nodes(node->sub_nodes[i]);
+  }
+  return n;
+}
+
+/**
+ * @brief Run the validator passes performed by `LuaGAM::Setup`.
+ **/
+void verify(const ast_t &ast, const bool gam, const uint32 max_lines) {
+  Verifier::LuaGAMValidator validator(ast);
+  bench::keep(&validator);
+  if (validator.check_gam() && gam) {
+    (void)validator.check_only_gam();
+    char8 name[8];
+    for (uint32 k = 1u; k <= N_SYNTH_INPUTS; k++) {
+      snprintf(name, sizeof(name), "x%u", k);
+      (void)validator.validate_input_signal(name);
+      snprintf(name, sizeof(name), "y%u", k);
+      (void)validator.validate_output_signal(name, max_lines);
+    }
+  }
+  Verifier::cost_t cost = validator.estimate_cost();
+  bench::keep(&cost);
+}
+
+/**
+ * @brief Measures of the three stages over all the snippets of a source.
+ **/
+struct stages_t {
+  bench::Measure scan;
+  bench::Measure ast;
+  bench::Measure verify;
+  uint32 tokens;
+  uint32 nodes;
+};
+
+bool run_once(const source_t &src, stages_t &st) {
+  bool ok = true;
+  st.tokens = 0u;
+  st.nodes = 0u;
+  for (uint32 i = 0u; ok && i < src.n_codes; i++) {
+    st.scan.start();
+    tokens_t tokens = scan(src.codes[i], ok);
+    st.scan.stop();
+    if (ok) {
+      st.tokens += tokens.len();
+      st.ast.start();
+      ast_t ast = generate_ast(tokens, ok);
+      st.ast.stop();
+      if (ok) {
+        for (uint32 n = 0u; n < ast.nodes.len(); n++) {
+          st.nodes += count_nodes(ast[n]);
+        }
+        st.verify.start();
+        verify(ast, src.gam, static_cast<uint32>(strlen(src.codes[i])) + 1u);
+        st.verify.stop();
+      }
+    }
+  }
+  if (!ok) {
+    printf("%-22s parsing failed\n", src.name);
+  }
+  return ok;
+}
+
+void report(const source_t &src, const char8 *stage,
+            const bench::Measure &m, const stages_t &st,
+            const uint32 iterations) {
+  const float64 s = static_cast<float64>(m.ns) * 1e-9;
+  const float64 kb = static_cast<float64>(src.bytes) * iterations / 1024.0;
+  const float64 tokens = static_cast<float64>(st.tokens) * iterations;
+  const float64 nodes = static_cast<float64>(st.nodes) * iterations;
+  printf("%-22s %-7s %9.1f %8u %8u %11.2f %11.3f %11.3f %10.1f\n", src.name,
+         stage, static_cast<float64>(src.bytes) / 1024.0, st.tokens,
+         st.nodes, static_cast<float64>(m.ns) / 1e3 / iterations,
+         s > 0.0 ? tokens / s / 1e6 : 0.0, s > 0.0 ? nodes / s / 1e6 : 0.0,
+         kb > 0.0 ? static_cast<float64>(m.allocs) / kb : 0.0);
+}
+
+bool bench_source(const source_t &src, uint32 iterations) {
+  stages_t st;
+  // warm-up run, also used to size the number of iterations
+  bench::Measure warmup;
+  bool ok = run_once(src, st);
+  warmup.stop();
+  if (ok && iterations == 0u) {
+    iterations = warmup.ns > 0u ? static_cast<uint32>(MIN_STAGE_NS / warmup.ns)
+                                : 1u;
+    iterations = iterations > 0u ? iterations : 1u;
+  }
+  st.scan = bench::Measure();
+  st.ast = bench::Measure();
+  st.verify = bench::Measure();
+  for (uint32 i = 0u; ok && i < iterations; i++) {
+    ok = run_once(src, st);
+  }
+  if (ok) {
+    report(src, "scan", st.scan, st, iterations);
+    report(src, "ast", st.ast, st, iterations);
+    report(src, "verify", st.verify, st, iterations);
+  }
+  return ok;
+}
+
+void silent(const ErrorManagement::ErrorInformation &errorInfo,
+            const char8 *const errorDescription) {}
+
+} // namespace
+
+/*---------------------------------------------------------------------------*/
+/*                           Method definitions                              */
+/*---------------------------------------------------------------------------*/
+
+int main(int argc, char **argv) {
+  uint32 iterations = 0u;
+  uint32 statements = 0u;
+  const char8 *default_corpora[] = {
+      "Test/Resources/LuaGAM/luaparser_exp.corpus",
+      "Test/Resources/LuaGAM/luaparser_stat.corpus",
+      "Test/Resources/LuaGAM/luaparser_decl.corpus",
+      "Test/Resources/LuaGAM/luaparser_comm.corpus"};
+  const char8 **corpora = default_corpora;
+  uint32 n_corpora = 4u;
+  const char8 **args = new const char8 *[argc];
+  uint32 n_args = 0u;
+  for (int i = 1; i < argc; i++) {
+    if (strcmp(argv[i], "-n") == 0 && i + 1 < argc) {
+      iterations = static_cast<uint32>(atoi(argv[++i]));
+    } else if (strcmp(argv[i], "-s") == 0 && i + 1 < argc) {
+      statements = static_cast<uint32>(atoi(argv[++i]));
+    } else {
+      args[n_args++] = argv[i];
+    }
+  }
+  if (n_args > 0u) {
+    corpora = args;
+    n_corpora = n_args;
+  }
+  ErrorManagement::SetErrorProcessFunction(&silent);
+
+  printf("%-22s %-7s %9s %8s %8s %11s %11s %11s %10s\n", "source", "stage",
+         "KB", "tokens", "nodes", "us/iter", "Mtokens/s", "Mnodes/s",
+         "allocs/KB");
+  bool ok = true;
+  for (uint32 i = 0u; i < n_corpora; i++) {
+    source_t src;
+    if (load_corpus(corpora[i], src)) {
+      ok &= bench_source(src, iterations);
+    } else {
+      ok = false;
+    }
+    source_free(src);
+  }
+  const uint32 sizes[] = {10u, 100u, 1000u};
+  for (uint32 i = 0u; i < 3u; i++) {
+    if (statements != 0u && i > 0u) {
+      break;
+    }
+    source_t src;
+    synthetic_gam(statements != 0u ? statements : sizes[i], src);
+    ok &= bench_source(src, iterations);
+    source_free(src);
+  }
+  delete[] args;
+  return ok ? 0 : 1;
+}
@@ -0,0 +1,111 @@
+/**
+ * @file LuaParserFuzzer.cpp
+ * @brief Fuzzing target of the LuaGAM parser
+ * @date 18/10/2026
+ *
+ * @copyright Copyright 2015 F4E | European Joint Undertaking for ITER and
+ * the Development of Fusion Energy ('Fusion for Energy').
+ * Licensed under the EUPL, Version 1.1 or - as soon they will be approved
+ * by the European Commission - subsequent versions of the EUPL (the "Licence")
+ * You may not use this work except in compliance with the Licence.
+ * You may obtain a copy of the Licence at: http://ec.europa.eu/idabc/eupl
+ *
+ * @warning Unless required by applicable law or agreed to in writing,
+ * software distributed under the Licence is distributed on an "AS IS"
+ * basis, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+ * or implied. See the Licence permissions and limitations under the Licence.
+
+ * @details libFuzzer entry point feeding arbitrary inputs to `LUA::parse`
+ * and, when parsing succeeds, to the `LuaGAMValidator` passes.
+ *
+ * `make -f Makefile.gcc fuzz` builds the libFuzzer version with clang
+ * (`LUAGAM_LIBFUZZER` defined), e.g.:
+ * ```
+ * LuaParserLibFuzzer.ex -max_len=4096 -timeout=2 corpus_dir/
+ * ```
+ * Without libFuzzer the executable replays the files given as arguments,
+ * to reproduce crashes and timeouts found by the fuzzer.
+ */
+
+/*---------------------------------------------------------------------------*/
+/*                         Standard header includes                          */
+/*---------------------------------------------------------------------------*/
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+
+/*---------------------------------------------------------------------------*/
+/*                         Project header includes                           */
+/*---------------------------------------------------------------------------*/
+
+#include "AST.h"
+#include "ErrorManagement.h"
+#include "LuaParser.h"
+#include "Verifier.h"
+
+/*---------------------------------------------------------------------------*/
+/*                           Static definitions                              */
+/*---------------------------------------------------------------------------*/
+
+using namespace MARTe;
+
+namespace {
+void silent(const ErrorManagement::ErrorInformation &errorInfo,
+            const char8 *const errorDescription) {}
+} // namespace
+
+/*---------------------------------------------------------------------------*/
+/*                           Method definitions                              */
+/*---------------------------------------------------------------------------*/
+
+extern "C" int LLVMFuzzerInitialize(int *argc, char ***argv) {
+  ErrorManagement::SetErrorProcessFunction(&silent);
+  return 0;
+}
+
+extern "C" int LLVMFuzzerTestOneInput(const uint8_t *data, size_t size) {
+  char8 *code = new char8[size + 1u];
+  memcpy(code, data, size);
+  code[size] = 0;
+  bool ok = true;
+  LUA::ast_t ast = LUA::parse(code, ok);
+  if (ok) {
+    LUA::Verifier::LuaGAMValidator validator(ast);
+    if (validator.check_gam()) {
+      (void)validator.check_only_gam();
+      (void)validator.validate_input_signal("x");
+      (void)validator.validate_output_signal("y",
+                                             static_cast<uint32>(size) + 1u);
+    }
+    (void)validator.estimate_cost();
+  }
+  delete[] code;
+  return 0;
+}
+
+#ifndef LUAGAM_LIBFUZZER
+int main(int argc, char **argv) {
+  LLVMFuzzerInitialize(&argc, &argv);
+  int ret = 0;
+  for (int i = 1; i < argc; i++) {
+    FILE *f = fopen(argv[i], "rb");
+    if (f == NULL) {
+      printf("Cannot open `%s`\n", argv[i]);
+      ret = 1;
+      continue;
+    }
+    fseek(f, 0, SEEK_END);
+    const long size = ftell(f);
+    rewind(f);
+    uint8_t *data = new uint8_t[size > 0 ? size : 1];
+    const size_t read = fread(data, 1u, static_cast<size_t>(size), f);
+    fclose(f);
+    printf("Running %s (%lu bytes)\n", argv[i], static_cast<unsigned long>(read));
+    (void)LLVMFuzzerTestOneInput(data, read);
+    delete[] data;
+  }
+  return ret;
+}
+#endif
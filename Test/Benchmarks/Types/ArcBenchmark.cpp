@@ -0,0 +1,176 @@
+/**
+ * @file ArcBenchmark.cpp
+ * @brief Contention benchmark of the reference counted pointers
+ * @date 18/10/2026
+ *
+ * @copyright Copyright 2015 F4E | European Joint Undertaking for ITER and
+ * the Development of Fusion Energy ('Fusion for Energy').
+ * Licensed under the EUPL, Version 1.1 or - as soon they will be approved
+ * by the European Commission - subsequent versions of the EUPL (the "Licence")
+ * You may not use this work except in compliance with the Licence.
+ * You may obtain a copy of the Licence at: http://ec.europa.eu/idabc/eupl
+ *
+ * @warning Unless required by applicable law or agreed to in writing,
+ * software distributed under the Licence is distributed on an "AS IS"
+ * basis, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+ * or implied. See the Licence permissions and limitations under the Licence.
+
+ * @details Times the copy and release of `Rc` and `Arc` pointers:
+ *  - `rc`: single threaded `Rc` copies (baseline);
+ *  - `arc-private`: every thread copies its own `Arc` (no sharing);
+ *  - `arc-shared`: all the threads copy the same `Arc` (contended counter);
+ *  - `arc-upgrade`: all the threads upgrade a weak reference to the same
+ *    object (compare and swap loop).
+ *
+ * Usage:
+ * ```
+ * ArcBenchmark.ex [-n operations per thread] [-t max threads]
+ * ```
+ */
+
+/*---------------------------------------------------------------------------*/
+/*                         Standard header includes                          */
+/*---------------------------------------------------------------------------*/
+
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/*---------------------------------------------------------------------------*/
+/*                         Project header includes                           */
+/*---------------------------------------------------------------------------*/
+
+#include "Arc.h"
+#include "Bench.h"
+#include "Rc.h"
+
+/*---------------------------------------------------------------------------*/
+/*                           Static definitions                              */
+/*---------------------------------------------------------------------------*/
+
+using namespace MARTe;
+
+#define DEFAULT_OPERATIONS 2000000u
+#define DEFAULT_MAX_THREADS 8u
+
+namespace {
+
+struct payload_t {
+  uint64 value[4];
+};
+
+enum arc_mode_t { ARC_PRIVATE, ARC_SHARED, ARC_UPGRADE };
+
+struct worker_t {
+  Arc<payload_t> ptr;
+  arc_mode_t mode;
+  uint32 operations;
+  pthread_barrier_t *barrier;
+  uint64 ns;
+};
+
+void *worker(void *arg) {
+  worker_t *w = static_cast<worker_t *>(arg);
+  pthread_barrier_wait(w->barrier);
+  const uint64 t0 = bench::now_ns();
+  if (w->mode == ARC_UPGRADE) {
+    for (uint32 i = 0u; i < w->operations; i++) {
+      Arc<payload_t> hard = +w->ptr;
+      bench::keep(&hard);
+    }
+  } else {
+    for (uint32 i = 0u; i < w->operations; i++) {
+      Arc<payload_t> copy(w->ptr);
+      bench::keep(&copy);
+    }
+  }
+  w->ns = bench::now_ns() - t0;
+  return NULL_PTR(void *);
+}
+
+void report(const char8 *mode, const uint32 threads, const uint32 operations,
+            const uint64 ns) {
+  const float64 ops = static_cast<float64>(operations) * threads;
+  printf("%-12s %7u %12.2f %12.2f\n", mode, threads,
+         static_cast<float64>(ns) / static_cast<float64>(operations),
+         ns > 0u ? ops / (static_cast<float64>(ns) * 1e-9) / 1e6 : 0.0);
+}
+
+void bench_rc(const uint32 operations) {
+  Rc<payload_t> ptr = make_rc<payload_t>();
+  bench::Measure m;
+  for (uint32 i = 0u; i < operations; i++) {
+    Rc<payload_t> copy(ptr);
+    bench::keep(&copy);
+  }
+  m.stop();
+  report("rc", 1u, operations, m.ns);
+}
+
+/**
+ * @brief Run `threads` workers, the slowest one gives the elapsed time.
+ **/
+void bench_arc(const arc_mode_t mode, const uint32 threads,
+               const uint32 operations) {
+  static const char8 *names[] = {"arc-private", "arc-shared", "arc-upgrade"};
+  Arc<payload_t> shared = make_arc<payload_t>();
+  pthread_barrier_t barrier;
+  pthread_barrier_init(&barrier, NULL_PTR(const pthread_barrierattr_t *),
+                       threads);
+  pthread_t *ids = new pthread_t[threads];
+  worker_t *workers = new worker_t[threads];
+  for (uint32 i = 0u; i < threads; i++) {
+    if (mode == ARC_PRIVATE) {
+      workers[i].ptr = make_arc<payload_t>();
+    } else if (mode == ARC_SHARED) {
+      workers[i].ptr = shared;
+    } else {
+      workers[i].ptr %= shared;
+    }
+    workers[i].mode = mode;
+    workers[i].operations = operations;
+    workers[i].barrier = &barrier;
+    workers[i].ns = 0u;
+  }
+  for (uint32 i = 0u; i < threads; i++) {
+    pthread_create(&ids[i], NULL_PTR(const pthread_attr_t *), worker,
+                   &workers[i]);
+  }
+  uint64 ns = 0u;
+  for (uint32 i = 0u; i < threads; i++) {
+    pthread_join(ids[i], NULL_PTR(void **));
+    ns = workers[i].ns > ns ? workers[i].ns : ns;
+  }
+  report(names[mode], threads, operations, ns);
+  delete[] workers;
+  delete[] ids;
+  pthread_barrier_destroy(&barrier);
+}
+
+} // namespace
+
+/*---------------------------------------------------------------------------*/
+/*                           Method definitions                              */
+/*---------------------------------------------------------------------------*/
+
+int main(int argc, char **argv) {
+  uint32 operations = DEFAULT_OPERATIONS;
+  uint32 max_threads = DEFAULT_MAX_THREADS;
+  for (int i = 1; i < argc; i++) {
+    if (strcmp(argv[i], "-n") == 0 && i + 1 < argc) {
+      operations = static_cast<uint32>(atoi(argv[++i]));
+    } else if (strcmp(argv[i], "-t") == 0 && i + 1 < argc) {
+      max_threads = static_cast<uint32>(atoi(argv[++i]));
+    }
+  }
+  printf("%-12s %7s %12s %12s\n", "mode", "threads", "ns/op", "Mops/s");
+  bench_rc(operations);
+  const arc_mode_t modes[] = {ARC_PRIVATE, ARC_SHARED, ARC_UPGRADE};
+  for (uint32 m = 0u; m < 3u; m++) {
+    for (uint32 t = 1u; t <= max_threads; t *= 2u) {
+      bench_arc(modes[m], t, operations);
+    }
+  }
+  return 0;
+}
@@ -0,0 +1,177 @@
+/**
+ * @file EscapeBenchmark.cpp
+ * @brief Throughput benchmark of the JSON escaping of log messages
+ * @date 18/10/2026
+ *
+ * @copyright Copyright 2015 F4E | European Joint Undertaking for ITER and
+ * the Development of Fusion Energy ('Fusion for Energy').
+ * Licensed under the EUPL, Version 1.1 or - as soon they will be approved
+ * by the European Commission - subsequent versions of the EUPL (the "Licence")
+ * You may not use this work except in compliance with the Licence.
+ * You may obtain a copy of the Licence at: http://ec.europa.eu/idabc/eupl
+ *
+ * @warning Unless required by applicable law or agreed to in writing,
+ * software distributed under the Licence is distributed on an "AS IS"
+ * basis, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+ * or implied. See the Licence permissions and limitations under the Licence.
+
+ * @details Compares `StrBuilder::append_json_escaped` (table driven, SSE2
+ * skip of clean runs, reused buffer) with the former `sanitize` of the
+ * `JSONLogger` (count pass, `new char[]` per message, 3 escaped chars), on
+ * messages of different lengths and densities of chars to escape.
+ *
+ * Usage:
+ * ```
+ * EscapeBenchmark.ex [-n messages]
+ * ```
+ */
+
+/*---------------------------------------------------------------------------*/
+/*                         Standard header includes                          */
+/*---------------------------------------------------------------------------*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/*---------------------------------------------------------------------------*/
+/*                         Project header includes                           */
+/*---------------------------------------------------------------------------*/
+
+#include "Bench.h"
+#include "StrBuilder.h"
+
+/*---------------------------------------------------------------------------*/
+/*                           Static definitions                              */
+/*---------------------------------------------------------------------------*/
+
+using namespace MARTe;
+
+#define DEFAULT_MESSAGES 1000000u
+#define ESCAPE_CHR '\\'
+
+namespace {
+
+/*
+ * Former JSONLogger escaping (the baseline).
+ */
+const uint32 num_non_valid_char = 3;
+const char non_valid_char[num_non_valid_char] = {'\n', '\t', '"'};
+const char valid_char[num_non_valid_char] = {'n', 't', '"'};
+
+bool is_non_valid(const char c) {
+  for (uint32 i = 0; i < num_non_valid_char; i++) {
+    if (c == non_valid_char[i]) {
+      return true;
+    }
+  }
+  return false;
+}
+
+uint32 count_non_valid(const char *str, const uint32 len) {
+  uint32 counter = 0;
+  for (uint32 i = 0; i < len; i++) {
+    if (is_non_valid(str[i]) && (i == 0 || str[i - 1] != ESCAPE_CHR)) {
+      counter++;
+    }
+  }
+  return counter;
+}
+
+char *sanitize(const char *msg) {
+  uint32 len = static_cast<uint32>(strlen(msg));
+  uint32 num_nvc = count_non_valid(msg, len);
+  char *str = new char[len + num_nvc + 1];
+  uint32 str_ind = 0;
+  for (uint32 i = 0; i < len; i++) {
+    if ((i == 0 || msg[i - 1] != ESCAPE_CHR)) {
+      bool wrote = false;
+      for (uint32 j = 0; j < num_non_valid_char; j++) {
+        if (msg[i] == non_valid_char[j]) {
+          str[str_ind++] = ESCAPE_CHR;
+          str[str_ind++] = valid_char[j];
+          wrote = true;
+          break;
+        }
+      }
+      if (!wrote) {
+        str[str_ind++] = msg[i];
+      }
+    } else {
+      str[str_ind++] = msg[i];
+    }
+  }
+  str[str_ind] = 0;
+  return str;
+}
+
+/**
+ * @brief message of `len` chars with a char to escape every `every` chars
+ * (none if 0)
+ **/
+void make_message(char *msg, const uint32 len, const uint32 every) {
+  static const char text[] = "Parameter Gain of GAM Controller out of range, "
+                             "value = 12.5 limit = 10.0 ";
+  static const char escapes[] = {'"', '\n', '\t', '\\'};
+  for (uint32 i = 0u; i < len; i++) {
+    msg[i] = text[i % (sizeof(text) - 1u)];
+    if (every > 0u && i % every == every - 1u) {
+      msg[i] = escapes[(i / every) % sizeof(escapes)];
+    }
+  }
+  msg[len] = 0;
+}
+
+void bench_escape(const char *name, const uint32 len, const uint32 every,
+                  const uint32 messages) {
+  char msg[256];
+  make_message(msg, len, every);
+  uint64 sum = 0u;
+  bench::Measure legacy;
+  for (uint32 i = 0u; i < messages; i++) {
+    char *str = sanitize(msg);
+    sum += static_cast<uint8>(str[0]);
+    delete[] str;
+  }
+  legacy.stop();
+  StrBuilder b;
+  bench::Measure m;
+  for (uint32 i = 0u; i < messages; i++) {
+    b.clear();
+    b.append_json_escaped(msg, len);
+    sum += b.len();
+  }
+  m.stop();
+  bench::keep(&sum);
+  const float64 bytes = static_cast<float64>(len) * messages;
+  const float64 legacy_ns = static_cast<float64>(legacy.ns);
+  const float64 ns = static_cast<float64>(m.ns);
+  printf("%-10s %5u %9.1f %9.1f %9.1f %9.1f %8.2fx %7.2f\n", name, len,
+         legacy_ns / messages, bytes / legacy_ns * 1e3, ns / messages,
+         bytes / ns * 1e3, legacy_ns / ns,
+         static_cast<float64>(legacy.allocs) / messages);
+}
+
+} // namespace
+
+/*---------------------------------------------------------------------------*/
+/*                           Method definitions                              */
+/*---------------------------------------------------------------------------*/
+
+int main(int argc, char **argv) {
+  uint32 messages = DEFAULT_MESSAGES;
+  for (int i = 1; i < argc; i++) {
+    if (strcmp(argv[i], "-n") == 0 && i + 1 < argc) {
+      messages = static_cast<uint32>(atoi(argv[++i]));
+    }
+  }
+  printf("%-10s %5s %9s %9s %9s %9s %9s %7s\n", "message", "len",
+         "old ns", "old MB/s", "new ns", "new MB/s", "speedup", "old al");
+  bench_escape("clean", 24u, 0u, messages);
+  bench_escape("clean", 80u, 0u, messages);
+  bench_escape("clean", 255u, 0u, messages);
+  bench_escape("sparse", 80u, 40u, messages);
+  bench_escape("sparse", 255u, 40u, messages);
+  bench_escape("dense", 255u, 4u, messages);
+  return 0;
+}
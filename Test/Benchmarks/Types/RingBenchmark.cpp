@@ -0,0 +1,289 @@
+/**
+ * @file RingBenchmark.cpp
+ * @brief Throughput and latency benchmark of the lock-free rings
+ * @date 18/10/2026
+ *
+ * @copyright Copyright 2015 F4E | European Joint Undertaking for ITER and
+ * the Development of Fusion Energy ('Fusion for Energy').
+ * Licensed under the EUPL, Version 1.1 or - as soon they will be approved
+ * by the European Commission - subsequent versions of the EUPL (the "Licence")
+ * You may not use this work except in compliance with the Licence.
+ * You may obtain a copy of the Licence at: http://ec.europa.eu/idabc/eupl
+ *
+ * @warning Unless required by applicable law or agreed to in writing,
+ * software distributed under the Licence is distributed on an "AS IS"
+ * basis, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+ * or implied. See the Licence permissions and limitations under the Licence.
+
+ * @details Throughput: producers push `-n` items each to a consumer thread:
+ *  - `mutex`: circular buffer protected by a mutex (baseline, as the
+ *    current loggers);
+ *  - `spsc`, `spsc-batch`: `SpscRing`, one item or 32 items at a time;
+ *  - `mpsc`, `mpsc-batch`: `MpscRing` with 1 to `-t` producers.
+ *
+ * Latency: one way latency of a ping-pong between two threads over two
+ * `SpscRing`, with the consumer spinning (`latency-spin`) or sleeping in
+ * `pop_wait` (`latency-wait`).
+ *
+ * Usage:
+ * ```
+ * RingBenchmark.ex [-n items per producer] [-t max producers]
+ * ```
+ */
+
+/*---------------------------------------------------------------------------*/
+/*                         Standard header includes                          */
+/*---------------------------------------------------------------------------*/
+
+#include <pthread.h>
+#include <sched.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/*---------------------------------------------------------------------------*/
+/*                         Project header includes                           */
+/*---------------------------------------------------------------------------*/
+
+#include "Bench.h"
+#include "MpscRing.h"
+#include "SpscRing.h"
+
+/*---------------------------------------------------------------------------*/
+/*                           Static definitions                              */
+/*---------------------------------------------------------------------------*/
+
+using namespace MARTe;
+
+#define DEFAULT_ITEMS 2000000u
+#define DEFAULT_MAX_PRODUCERS 4u
+#define RING_SIZE 1024u
+#define BATCH 32u
+#define PING_PONGS 100000u
+
+namespace {
+
+/**
+ * @brief mutex protected circular buffer (the baseline).
+ **/
+class locked_ring_t {
+public:
+  locked_ring_t() : head(0u), tail(0u) {
+    pthread_mutex_init(&mutex, NULL_PTR(const pthread_mutexattr_t *));
+  }
+  ~locked_ring_t() { pthread_mutex_destroy(&mutex); }
+
+  bool push(const uint64 item) {
+    pthread_mutex_lock(&mutex);
+    const bool ok = tail - head < RING_SIZE;
+    if (ok) {
+      items[tail % RING_SIZE] = item;
+      tail++;
+    }
+    pthread_mutex_unlock(&mutex);
+    return ok;
+  }
+
+  uint32 pop(uint64 *out, const uint32 max) {
+    pthread_mutex_lock(&mutex);
+    uint32 n = 0u;
+    while (n < max && head != tail) {
+      out[n++] = items[head % RING_SIZE];
+      head++;
+    }
+    pthread_mutex_unlock(&mutex);
+    return n;
+  }
+
+private:
+  pthread_mutex_t mutex;
+  uint64 items[RING_SIZE];
+  uint32 head;
+  uint32 tail;
+};
+
+enum ring_mode_t { MUTEX, SPSC, SPSC_BATCH, MPSC, MPSC_BATCH };
+
+struct context_t {
+  ring_mode_t mode;
+  uint32 items;
+  locked_ring_t *locked;
+  SpscRing<uint64, RING_SIZE> *spsc;
+  MpscRing<uint64> *mpsc;
+  pthread_barrier_t *barrier;
+};
+
+/**
+ * @brief push `items` values, yielding while the ring is full.
+ **/
+void *producer(void *arg) {
+  context_t *c = static_cast<context_t *>(arg);
+  uint64 batch[BATCH];
+  for (uint32 i = 0u; i < BATCH; i++) {
+    batch[i] = i;
+  }
+  pthread_barrier_wait(c->barrier);
+  uint32 sent = 0u;
+  while (sent < c->items) {
+    const uint32 left = c->items - sent;
+    uint32 n = 0u;
+    switch (c->mode) {
+    case MUTEX:
+      n = c->locked->push(sent) ? 1u : 0u;
+      break;
+    case SPSC:
+      n = c->spsc->push(sent) ? 1u : 0u;
+      break;
+    case SPSC_BATCH:
+      n = c->spsc->push(batch, left < BATCH ? left : BATCH);
+      break;
+    case MPSC:
+      n = c->mpsc->push(sent) ? 1u : 0u;
+      break;
+    case MPSC_BATCH:
+      n = c->mpsc->push(batch, left < BATCH ? left : BATCH);
+      break;
+    }
+    sent += n;
+    if (n == 0u) {
+      sched_yield();
+    }
+  }
+  return NULL_PTR(void *);
+}
+
+void bench_throughput(const ring_mode_t mode, const uint32 producers,
+                      const uint32 items) {
+  static const char8 *names[] = {"mutex", "spsc", "spsc-batch", "mpsc",
+                                 "mpsc-batch"};
+  locked_ring_t locked;
+  SpscRing<uint64, RING_SIZE> *spsc = new SpscRing<uint64, RING_SIZE>();
+  MpscRing<uint64> mpsc(RING_SIZE);
+  pthread_barrier_t barrier;
+  pthread_barrier_init(&barrier, NULL_PTR(const pthread_barrierattr_t *),
+                       producers + 1u);
+  context_t context = {mode, items, &locked, spsc, &mpsc, &barrier};
+  pthread_t *ids = new pthread_t[producers];
+  for (uint32 i = 0u; i < producers; i++) {
+    pthread_create(&ids[i], NULL_PTR(const pthread_attr_t *), producer,
+                   &context);
+  }
+  pthread_barrier_wait(&barrier);
+  bench::Measure m;
+  const uint64 total = static_cast<uint64>(items) * producers;
+  uint64 received = 0u;
+  uint64 sum = 0u;
+  uint64 out[BATCH];
+  while (received < total) {
+    uint32 n;
+    if (mode == MUTEX) {
+      n = locked.pop(out, BATCH);
+    } else if (mode == SPSC || mode == SPSC_BATCH) {
+      n = spsc->pop(out, BATCH);
+    } else {
+      n = mpsc.pop(out, BATCH);
+    }
+    for (uint32 i = 0u; i < n; i++) {
+      sum += out[i];
+    }
+    received += n;
+    if (n == 0u) {
+      sched_yield();
+    }
+  }
+  m.stop();
+  bench::keep(&sum);
+  for (uint32 i = 0u; i < producers; i++) {
+    pthread_join(ids[i], NULL_PTR(void **));
+  }
+  printf("%-14s %9u %12.2f %12.2f\n", names[mode], producers,
+         static_cast<float64>(total) / (static_cast<float64>(m.ns) * 1e-9) /
+             1e6,
+         static_cast<float64>(m.ns) / static_cast<float64>(total));
+  delete[] ids;
+  delete spsc;
+  pthread_barrier_destroy(&barrier);
+}
+
+typedef SpscRing<uint64, 16u> ping_ring_t;
+
+struct ping_t {
+  ping_ring_t *in;
+  ping_ring_t *out;
+  bool wait;
+};
+
+uint64 receive(ping_ring_t &ring, const bool wait) {
+  uint64 v = 0u;
+  if (wait) {
+    while (!ring.pop_wait(v, 1000000u)) {
+    }
+  } else {
+    while (!ring.pop(v)) {
+      sched_yield();
+    }
+  }
+  return v;
+}
+
+/**
+ * @brief send back every value received.
+ **/
+void *pong(void *arg) {
+  ping_t *p = static_cast<ping_t *>(arg);
+  for (uint32 i = 0u; i < PING_PONGS; i++) {
+    (void)p->out->push(receive(*p->in, p->wait));
+  }
+  return NULL_PTR(void *);
+}
+
+void bench_latency(const bool wait) {
+  ping_ring_t *ping = new ping_ring_t(wait);
+  ping_ring_t *back = new ping_ring_t(wait);
+  ping_t context = {ping, back, wait};
+  pthread_t id;
+  pthread_create(&id, NULL_PTR(const pthread_attr_t *), pong, &context);
+  bench::Measure m;
+  for (uint32 i = 0u; i < PING_PONGS; i++) {
+    (void)ping->push(i);
+    (void)receive(*back, wait);
+  }
+  m.stop();
+  pthread_join(id, NULL_PTR(void **));
+  printf("%-14s %9u %12.2f %12.2f\n", wait ? "latency-wait" : "latency-spin",
+         1u, static_cast<float64>(PING_PONGS) * 2.0 /
+                 (static_cast<float64>(m.ns) * 1e-9) / 1e6,
+         static_cast<float64>(m.ns) / (2.0 * PING_PONGS));
+  delete ping;
+  delete back;
+}
+
+} // namespace
+
+/*---------------------------------------------------------------------------*/
+/*                           Method definitions                              */
+/*---------------------------------------------------------------------------*/
+
+int main(int argc, char **argv) {
+  uint32 items = DEFAULT_ITEMS;
+  uint32 max_producers = DEFAULT_MAX_PRODUCERS;
+  for (int i = 1; i < argc; i++) {
+    if (strcmp(argv[i], "-n") == 0 && i + 1 < argc) {
+      items = static_cast<uint32>(atoi(argv[++i]));
+    } else if (strcmp(argv[i], "-t") == 0 && i + 1 < argc) {
+      max_producers = static_cast<uint32>(atoi(argv[++i]));
+    }
+  }
+  printf("%-14s %9s %12s %12s\n", "mode", "producers", "Mitems/s",
+         "ns/item");
+  bench_throughput(SPSC, 1u, items);
+  bench_throughput(SPSC_BATCH, 1u, items);
+  for (uint32 t = 1u; t <= max_producers; t *= 2u) {
+    bench_throughput(MUTEX, t, items);
+    bench_throughput(MPSC, t, items);
+    bench_throughput(MPSC_BATCH, t, items);
+  }
+  bench_latency(false);
+  bench_latency(true);
+  return 0;
+}
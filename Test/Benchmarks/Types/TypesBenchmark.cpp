@@ -0,0 +1,451 @@
+/**
+ * @file TypesBenchmark.cpp
+ * @brief Micro-benchmarks of the Core/Types containers
+ * @date 18/10/2026
+ *
+ * @copyright Copyright 2015 F4E | European Joint Undertaking for ITER and
+ * the Development of Fusion Energy ('Fusion for Energy').
+ * Licensed under the EUPL, Version 1.1 or - as soon they will be approved
+ * by the European Commission - subsequent versions of the EUPL (the "Licence")
+ * You may not use this work except in compliance with the Licence.
+ * You may obtain a copy of the Licence at: http://ec.europa.eu/idabc/eupl
+ *
+ * @warning Unless required by applicable law or agreed to in writing,
+ * software distributed under the Licence is distributed on an "AS IS"
+ * basis, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+ * or implied. See the Licence permissions and limitations under the Licence.
+
+ * @details Time and heap allocations (counted by `Bench.a`) per operation of
+ * the `Vec`, `Str`, `Rc`, `Option`, `Result` and `HashMap` operations used
+ * by the LuaGAM parser. Each case is repeated, doubling the number of
+ * operations, until it runs for at least `-m` milliseconds.
+ *
+ * Usage:
+ * ```
+ * TypesBenchmark.ex [-m milliseconds] [-c] [-b baseline.csv] [filters...]
+ * ```
+ * `-c` prints the results as CSV, to be saved and passed with `-b` to a
+ * later run which then reports the change of each case. Only the cases
+ * whose name contains one of the filters are run.
+ */
+
+/*---------------------------------------------------------------------------*/
+/*                         Standard header includes                          */
+/*---------------------------------------------------------------------------*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/*---------------------------------------------------------------------------*/
+/*                         Project header includes                           */
+/*---------------------------------------------------------------------------*/
+
+#include "Bench.h"
+#include "HashMap.h"
+#include "Option.h"
+#include "Rc.h"
+#include "Result.h"
+#include "Str.h"
+#include "Vec.h"
+
+/*---------------------------------------------------------------------------*/
+/*                           Static definitions                              */
+/*---------------------------------------------------------------------------*/
+
+using namespace MARTe;
+
+#define DEFAULT_MIN_MS 100u
+#define N_ITEMS 1000u
+#define MAX_BASELINE 64u
+#define NAME_SIZE 32u
+
+namespace {
+
+/**
+ * @brief Inputs shared by the cases, built once.
+ **/
+struct fixture_t {
+  Vec<uint32> items;
+  Str text;
+  Str brackets;
+  Str word;
+  Str other_word;
+  HashMap<uint32, uint32> map;
+  Rc<uint32> rc;
+};
+
+fixture_t *fx = NULL_PTR(fixture_t *);
+
+void setup() {
+  fx = new fixture_t();
+  for (uint32 i = 0u; i < N_ITEMS; i++) {
+    fx->items.append(i * 7u);
+    fx->map.set(i * 7u, i);
+    fx->text += static_cast<char>('a' + (i % 26u));
+  }
+  fx->text.append("needle.");
+  for (uint32 i = 0u; i < N_ITEMS / 4u; i++) {
+    fx->brackets.append("]=]=");
+  }
+  fx->brackets.append("]==]");
+  fx->word = "local_variable_name";
+  fx->other_word = "local_variable_nama";
+  fx->rc = make_rc<uint32>(42u);
+}
+
+// Each case performs `n` operations.
+
+void vec_append(const uint32 n) {
+  Vec<uint32> v;
+  for (uint32 i = 0u; i < n; i++) {
+    v.append(i);
+  }
+  bench::keep(&v);
+}
+
+void vec_copy(const uint32 n) {
+  for (uint32 i = 0u; i < n; i++) {
+    Vec<uint32> copy(fx->items);
+    bench::keep(&copy);
+  }
+}
+
+void vec_find(const uint32 n) {
+  uint32 sum = 0u;
+  for (uint32 i = 0u; i < n; i++) {
+    Option<uint32> pos = fx->items.find(((i % N_ITEMS) * 7u));
+    sum += pos.val();
+  }
+  bench::keep(&sum);
+}
+
+void vec_iterate(const uint32 n) {
+  uint32 sum = 0u;
+  for (uint32 i = 0u; i < n; i++) {
+    for (Vec<uint32>::iterator it = fx->items.begin(); it != fx->items.end();
+         ++it) {
+      sum += *it;
+    }
+  }
+  bench::keep(&sum);
+}
+
+void vec_at(const uint32 n) {
+  uint32 sum = 0u;
+  for (uint32 i = 0u; i < n; i++) {
+    sum += fx->items.at(static_cast<int32>(i % N_ITEMS)).val();
+  }
+  bench::keep(&sum);
+}
+
+void str_concat(const uint32 n) {
+  for (uint32 i = 0u; i < n; i++) {
+    Str s = fx->word + "_suffix";
+    bench::keep(&s);
+  }
+}
+
+void str_append(const uint32 n) {
+  Str s;
+  for (uint32 i = 0u; i < n; i++) {
+    s += static_cast<char>('a' + (i % 26u));
+  }
+  bench::keep(&s);
+}
+
+void str_substr(const uint32 n) {
+  for (uint32 i = 0u; i < n; i++) {
+    Str s = fx->text.substr(100, 164);
+    bench::keep(&s);
+  }
+}
+
+void str_find(const uint32 n) {
+  const Str needle("needle");
+  uint32 sum = 0u;
+  for (uint32 i = 0u; i < n; i++) {
+    sum += fx->text.find(needle).val();
+  }
+  bench::keep(&sum);
+}
+
+void str_find_char(const uint32 n) {
+  uint32 sum = 0u;
+  for (uint32 i = 0u; i < n; i++) {
+    sum += fx->text.find('.').val();
+  }
+  bench::keep(&sum);
+}
+
+void str_find_partial(const uint32 n) {
+  const Str needle("]==]");
+  uint32 sum = 0u;
+  for (uint32 i = 0u; i < n; i++) {
+    sum += fx->brackets.find(needle).val();
+  }
+  bench::keep(&sum);
+}
+
+void str_equal(const uint32 n) {
+  uint32 sum = 0u;
+  for (uint32 i = 0u; i < n; i++) {
+    sum += fx->word == fx->other_word ? 1u : 0u;
+  }
+  bench::keep(&sum);
+}
+
+void str_less(const uint32 n) {
+  uint32 sum = 0u;
+  for (uint32 i = 0u; i < n; i++) {
+    sum += fx->word < fx->other_word ? 1u : 0u;
+  }
+  bench::keep(&sum);
+}
+
+void str_hash(const uint32 n) {
+  uint32 sum = 0u;
+  for (uint32 i = 0u; i < n; i++) {
+    sum += fx->word.hash();
+  }
+  bench::keep(&sum);
+}
+
+void str_hash_long(const uint32 n) {
+  uint32 sum = 0u;
+  for (uint32 i = 0u; i < n; i++) {
+    sum += fx->text.hash();
+  }
+  bench::keep(&sum);
+}
+
+void str_hash64(const uint32 n) {
+  uint64 sum = 0u;
+  for (uint32 i = 0u; i < n; i++) {
+    sum += fx->word.hash64();
+  }
+  bench::keep(&sum);
+}
+
+void str_hash64_long(const uint32 n) {
+  uint64 sum = 0u;
+  for (uint32 i = 0u; i < n; i++) {
+    sum += fx->text.hash64();
+  }
+  bench::keep(&sum);
+}
+
+void rc_copy(const uint32 n) {
+  for (uint32 i = 0u; i < n; i++) {
+    Rc<uint32> copy(fx->rc);
+    bench::keep(&copy);
+  }
+}
+
+void rc_make(const uint32 n) {
+  for (uint32 i = 0u; i < n; i++) {
+    Rc<uint32> ptr = make_rc<uint32>(i);
+    bench::keep(&ptr);
+  }
+}
+
+void option_some(const uint32 n) {
+  for (uint32 i = 0u; i < n; i++) {
+    Option<uint32> o(i);
+    bench::keep(&o);
+  }
+}
+
+void option_none(const uint32 n) {
+  for (uint32 i = 0u; i < n; i++) {
+    Option<uint32> o;
+    bench::keep(&o);
+  }
+}
+
+void result_succ(const uint32 n) {
+  for (uint32 i = 0u; i < n; i++) {
+    Result<uint32> r = Result<uint32>::Succ(i);
+    bench::keep(&r);
+  }
+}
+
+void result_fail(const uint32 n) {
+  for (uint32 i = 0u; i < n; i++) {
+    Result<uint32> r = Result<uint32>::Fail(ErrorManagement::OutOfRange);
+    bench::keep(&r);
+  }
+}
+
+void hashmap_find(const uint32 n) {
+  uint32 sum = 0u;
+  for (uint32 i = 0u; i < n; i++) {
+    sum += fx->map.find((i % N_ITEMS) * 7u).val();
+  }
+  bench::keep(&sum);
+}
+
+struct case_t {
+  const char8 *name;
+  void (*run)(const uint32 n);
+};
+
+const case_t cases[] = {
+    {"vec/append", vec_append},
+    {"vec/copy[1000]", vec_copy},
+    {"vec/find[1000]", vec_find},
+    {"vec/iterate[1000]", vec_iterate},
+    {"vec/at", vec_at},
+    {"str/concat", str_concat},
+    {"str/append", str_append},
+    {"str/substr[64]", str_substr},
+    {"str/find[1007]", str_find},
+    {"str/find-char[1007]", str_find_char},
+    {"str/find-partial[404]", str_find_partial},
+    {"str/equal[19]", str_equal},
+    {"str/less[19]", str_less},
+    {"str/hash[19]", str_hash},
+    {"str/hash[1007]", str_hash_long},
+    {"str/hash64[19]", str_hash64},
+    {"str/hash64[1007]", str_hash64_long},
+    {"rc/copy", rc_copy},
+    {"rc/make", rc_make},
+    {"option/some", option_some},
+    {"option/none", option_none},
+    {"result/succ", result_succ},
+    {"result/fail", result_fail},
+    {"hashmap/find[1000]", hashmap_find},
+};
+
+/**
+ * @brief Result of a previous run, read from its CSV output.
+ **/
+struct baseline_t {
+  char8 name[NAME_SIZE];
+  float64 ns;
+  float64 allocs;
+};
+
+baseline_t baseline[MAX_BASELINE];
+uint32 n_baseline = 0u;
+
+bool load_baseline(const char8 *path) {
+  FILE *f = fopen(path, "r");
+  if (f == NULL) {
+    printf("Cannot open baseline `%s`\n", path);
+    return false;
+  }
+  char8 line[256];
+  while (n_baseline < MAX_BASELINE && fgets(line, sizeof(line), f) != NULL) {
+    baseline_t &b = baseline[n_baseline];
+    unsigned long iterations;
+    float64 bytes;
+    if (sscanf(line, "%31[^,],%lu,%lf,%lf,%lf", b.name, &iterations, &b.ns,
+               &b.allocs, &bytes) == 5) {
+      n_baseline++;
+    }
+  }
+  fclose(f);
+  return true;
+}
+
+const baseline_t *find_baseline(const char8 *name) {
+  for (uint32 i = 0u; i < n_baseline; i++) {
+    if (strcmp(baseline[i].name, name) == 0) {
+      return &baseline[i];
+    }
+  }
+  return NULL_PTR(const baseline_t *);
+}
+
+bool selected(const char8 *name, char8 **filters, const uint32 n_filters) {
+  bool ok = n_filters == 0u;
+  for (uint32 i = 0u; !ok && i < n_filters; i++) {
+    ok = strstr(name, filters[i]) != NULL;
+  }
+  return ok;
+}
+
+/**
+ * @brief Double the operations until the case runs for `min_ns`.
+ **/
+bench::Measure run_case(const case_t &c, const uint64 min_ns, uint32 &n) {
+  c.run(1u);
+  n = 16u;
+  bench::Measure m;
+  while (true) {
+    m = bench::Measure();
+    c.run(n);
+    m.stop();
+    if (m.ns >= min_ns || n >= 0x40000000u) {
+      break;
+    }
+    n *= 2u;
+  }
+  return m;
+}
+
+void report(const case_t &c, const bench::Measure &m, const uint32 n,
+            const bool csv) {
+  const float64 ops = static_cast<float64>(n);
+  const float64 ns = static_cast<float64>(m.ns) / ops;
+  const float64 allocs = static_cast<float64>(m.allocs) / ops;
+  const float64 bytes = static_cast<float64>(m.bytes) / ops;
+  if (csv) {
+    printf("%s,%u,%.3f,%.3f,%.1f\n", c.name, n, ns, allocs, bytes);
+    return;
+  }
+  printf("%-22s %11u %11.2f %11.3f %11.1f", c.name, n, ns, allocs, bytes);
+  const baseline_t *b = find_baseline(c.name);
+  if (b != NULL_PTR(const baseline_t *)) {
+    printf(" %+9.1f%%", b->ns > 0.0 ? (ns - b->ns) / b->ns * 100.0 : 0.0);
+    if (allocs > b->allocs + 1e-3) {
+      printf("  allocs %.3f -> %.3f", b->allocs, allocs);
+    }
+  }
+  printf("\n");
+}
+
+} // namespace
+
+/*---------------------------------------------------------------------------*/
+/*                           Method definitions                              */
+/*---------------------------------------------------------------------------*/
+
+int main(int argc, char **argv) {
+  uint32 min_ms = DEFAULT_MIN_MS;
+  bool csv = false;
+  char8 **filters = new char8 *[argc];
+  uint32 n_filters = 0u;
+  for (int i = 1; i < argc; i++) {
+    if (strcmp(argv[i], "-m") == 0 && i + 1 < argc) {
+      min_ms = static_cast<uint32>(atoi(argv[++i]));
+    } else if (strcmp(argv[i], "-c") == 0) {
+      csv = true;
+    } else if (strcmp(argv[i], "-b") == 0 && i + 1 < argc) {
+      if (!load_baseline(argv[++i])) {
+        return 1;
+      }
+    } else {
+      filters[n_filters++] = argv[i];
+    }
+  }
+  setup();
+  if (csv) {
+    printf("name,iterations,ns_per_op,allocs_per_op,bytes_per_op\n");
+  } else {
+    printf("%-22s %11s %11s %11s %11s%s\n", "case", "iterations", "ns/op",
+           "allocs/op", "bytes/op", n_baseline > 0u ? "    change" : "");
+  }
+  const uint64 min_ns = static_cast<uint64>(min_ms) * 1000000u;
+  for (uint32 i = 0u; i < sizeof(cases) / sizeof(cases[0]); i++) {
+    if (selected(cases[i].name, filters, n_filters)) {
+      uint32 n;
+      const bench::Measure m = run_case(cases[i], min_ns, n);
+      report(cases[i], m, n, csv);
+    }
+  }
+  delete fx;
+  delete[] filters;
+  return 0;
+}
@@ -111,11 +111,61 @@ TEST(LuaParser, TestParserComments) {
   ASSERT_TRUE(tester.TestParserComments());
 }
 
+TEST(LuaParser, TestParserMalformedInput) {
+  LuaParserTest tester;
+  ASSERT_TRUE(tester.TestParserMalformedInput());
+}
+
 TEST(LuaParser, TestUnopBinop) {
   LuaParserTest tester;
   ASSERT_TRUE(tester.TestUnopBinop());
 }
 
+TEST(LuaParser, TestCostEstimation) {
+  LuaParserTest tester;
+  ASSERT_TRUE(tester.TestCostEstimation());
+}
+
+TEST(LuaParser, TestCostNestedLoops) {
+  LuaParserTest tester;
+  ASSERT_TRUE(tester.TestCostNestedLoops());
+}
+
+TEST(LuaParser, TestCostUnboundedLoops) {
+  LuaParserTest tester;
+  ASSERT_TRUE(tester.TestCostUnboundedLoops());
+}
+
+TEST(LuaParser, TestCostSignalLengths) {
+  LuaParserTest tester;
+  ASSERT_TRUE(tester.TestCostSignalLengths());
+}
+
+TEST(LuaParser, TestOptimiserFolding) {
+  LuaParserTest tester;
+  ASSERT_TRUE(tester.TestOptimiserFolding());
+}
+
+TEST(LuaParser, TestOptimiserDeadBranches) {
+  LuaParserTest tester;
+  ASSERT_TRUE(tester.TestOptimiserDeadBranches());
+}
+
+TEST(LuaParser, TestOptimiserAssignedStates) {
+  LuaParserTest tester;
+  ASSERT_TRUE(tester.TestOptimiserAssignedStates());
+}
+
+TEST(LuaParser, TestParseService) {
+  LuaParserTest tester;
+  ASSERT_TRUE(tester.TestParseService());
+}
+
+TEST(LuaParser, TestSymbolInterning) {
+  LuaParserTest tester;
+  ASSERT_TRUE(tester.TestSymbolInterning());
+}
+
 TEST(LuaGAM, TestEmptyInitialisation) {
   LuaGAMTest tester;
   ASSERT_TRUE(tester.TestEmptyInitialisation());
@@ -225,3 +275,23 @@ TEST(LuaGAM, TestSimulatorGAM) {
   LuaGAMTest tester;
   ASSERT_TRUE(tester.TestSimulatorGAM());
 }
+
+TEST(LuaGAM, TestInitCycleBudget) {
+  LuaGAMTest tester;
+  ASSERT_TRUE(tester.TestInitCycleBudget());
+}
+
+TEST(LuaGAM, TestInitCycleBudgetArray) {
+  LuaGAMTest tester;
+  ASSERT_TRUE(tester.TestInitCycleBudgetArray());
+}
+
+TEST(LuaGAM, TestExecOptimised) {
+  LuaGAMTest tester;
+  ASSERT_TRUE(tester.TestExecOptimised());
+}
+
+TEST(LuaGAM, TestParallelParsing) {
+  LuaGAMTest tester;
+  ASSERT_TRUE(tester.TestParallelParsing());
+}
@@ -3,8 +3,11 @@
 #include "LuaGAM.h"
 #include "LuaGAMTest.h"
 #include "LuaParser.h"
+#include "Optimiser.h"
+#include "ParseService.h"
 #include "TestMacros.h"
 #include "Utils.h"
+#include "Verifier.h"
 #include "dbutils.h"
 #include "lua.hpp"
 #include <execinfo.h>
@@ -263,12 +266,12 @@ Str diff(const char *a, const char *b, uint32 tab = 0) {
   Vec<Str> line_a = tolines(a);
   Vec<Str> line_b = tolines(b);
   uint32 line = 0;
-  for (Rc<Vec<Str>::iterator> it = line_a.iterate(); it; it = it->next()) {
+  for (Vec<Str>::iterator it = line_a.begin(); it != line_a.end(); ++it) {
     line++;
-    if (!line_b.contains(it->value())) {
+    if (!line_b.contains(it.value())) {
       char num[10];
       sprintf(num, "%d", line);
-      res = res + spaces + "\e[32mexp:" + num + ">" + it->value() + "\e[0m\n";
+      res = res + spaces + "\e[32mexp:" + num + ">" + it.value() + "\e[0m\n";
     }
   }
   line = 0;
@@ -278,12 +281,12 @@ Str diff(const char *a, const char *b, uint32 tab = 0) {
   div[(tab + 2) * 4] = '\n';
   div[(tab + 2) * 4 + 1] = 0;
   res = res + div;
-  for (Rc<Vec<Str>::iterator> it = line_b.iterate(); it; it = it->next()) {
+  for (Vec<Str>::iterator it = line_b.begin(); it != line_b.end(); ++it) {
     line++;
-    if (!line_a.contains(it->value())) {
+    if (!line_a.contains(it.value())) {
       char num[10];
       sprintf(num, "%d", line);
-      res = res + spaces + "\e[31mres:" + num + ">" + it->value() + "\e[0m\n";
+      res = res + spaces + "\e[31mres:" + num + ">" + it.value() + "\e[0m\n";
     }
   }
 
@@ -302,9 +305,9 @@ bool run_corpus_test(const uint32 test_i, const char *path, const char *desc,
            desc);
   } else {
     Str ast_computed;
-    for (Rc<LUA::NodepList::iterator> it = ast_->iterate(); it;
-         it = it->next()) {
-      ast_computed = ast_computed + it->value()->toString(0, 4, true);
+    for (LUA::NodepList::iterator it = ast_->begin(); it != ast_->end();
+         ++it) {
+      ast_computed = ast_computed + it.value()->toString(0, 4, true);
     }
     ok = strcmp(ast_computed.cstr(), ast) == 0;
     if (!ok) {
@@ -446,6 +449,25 @@ bool LuaParserTest::TestParserTreeBuilding() {
       "end\n");
 }
 
+bool LuaParserTest::TestParserMalformedInput() {
+  bool ok = true;
+  // inputs found by fuzzing: they used to hang or crash the parser
+  const char *codes[] = {"end", "x = 1 end", "f() until x", "--[=", "--[==\n]==]",
+                         "x = [="};
+  for (MARTe::uint32 i = 0u; i < 6u; i++) {
+    bool parsed = true;
+    LUA::parse(codes[i], parsed);
+    T_ASSERT_FALSE(parsed);
+  }
+  // statements without children must not break the validator
+  bool parsed = true;
+  LUA::ast_t ast = LUA::parse(";", parsed);
+  T_ASSERT_TRUE(parsed);
+  LUA::Verifier::LuaGAMValidator validator(ast);
+  T_ASSERT_FALSE(validator.check_gam());
+  return ok;
+}
+
 bool LuaParserTest::TestUnopBinop() {
   return TestParse("a = 3 - 2\n"
 
@@ -454,6 +476,368 @@ bool LuaParserTest::TestUnopBinop() {
                    "d = ~c\n");
 }
 
+bool TestCost(const char *code, const uint64 expected, const bool bounded,
+              const LUA::Verifier::sizes_map_t *sizes =
+                  NULL_PTR(LUA::Verifier::sizes_map_t *)) {
+  bool ok = true;
+  LUA::ast_t ast = LUA::parse(code, ok);
+  T_ASSERT_TRUE(ok);
+  LUA::Verifier::LuaGAMValidator validator(ast);
+  LUA::Verifier::cost_t cost = validator.estimate_cost(sizes);
+  if (cost.bounded != bounded || (bounded && cost.ops != expected)) {
+    printf("  > cost %llu (bounded: %d), expected %llu (bounded: %d)\n",
+           (unsigned long long)cost.ops, cost.bounded,
+           (unsigned long long)expected, bounded);
+    T_ASSERT_TRUE(false);
+  }
+  return ok;
+}
+
+bool LuaParserTest::TestCostEstimation() {
+  bool ok = TestCost("function GAM()\n"
+                     "end\n",
+                     0u, true);
+  // store of y, then y, x, +, 1
+  ok &= TestCost("function GAM()\n"
+                 "  y = x + 1\n"
+                 "end\n",
+                 5u, true);
+  // condition (x > 1) plus the most expensive branch (y = x * 2 + 1)
+  ok &= TestCost("function GAM()\n"
+                 "  if x > 1 then\n"
+                 "    y = x * 2 + 1\n"
+                 "  else\n"
+                 "    y = 0\n"
+                 "  end\n"
+                 "end\n",
+                 3u + 7u, true);
+  return ok;
+}
+
+bool LuaParserTest::TestCostNestedLoops() {
+  // bounds (1, 10) plus 10 iterations of (y = y + i) and the loop test
+  bool ok = TestCost("function GAM()\n"
+                     "  for i = 1, 10 do\n"
+                     "    y = y + i\n"
+                     "  end\n"
+                     "end\n",
+                     2u + 10u * (5u + 1u), true);
+  // 4 outer iterations (1, 7, 2) each running 3 inner iterations (-1, 1)
+  ok &= TestCost("function GAM()\n"
+                 "  for i = 1, 7, 2 do\n"
+                 "    for j = -1, 1 do\n"
+                 "      y = y + i * j\n"
+                 "    end\n"
+                 "  end\n"
+                 "end\n",
+                 3u + 4u * ((3u + 3u * (7u + 1u)) + 1u), true);
+  ok &= TestCost("function GAM()\n"
+                 "  for i = 10, 1 do\n"
+                 "    y = y + i\n"
+                 "  end\n"
+                 "end\n",
+                 2u, true);
+  return ok;
+}
+
+bool LuaParserTest::TestCostUnboundedLoops() {
+  bool ok = TestCost("function GAM()\n"
+                     "  while y < 10 do\n"
+                     "    y = y + 1\n"
+                     "  end\n"
+                     "end\n",
+                     0u, false);
+  ok &= TestCost("function GAM()\n"
+                 "  repeat\n"
+                 "    y = y + 1\n"
+                 "  until y > 10\n"
+                 "end\n",
+                 0u, false);
+  ok &= TestCost("function GAM()\n"
+                 "  for i = 1, n do\n"
+                 "    y = y + 1\n"
+                 "  end\n"
+                 "end\n",
+                 0u, false);
+  ok &= TestCost("function GAM()\n"
+                 "  for k, v in pairs(t) do\n"
+                 "    y = y + v\n"
+                 "  end\n"
+                 "end\n",
+                 0u, false);
+  bool parsed = true;
+  LUA::ast_t ast = LUA::parse("function GAM()\n"
+                              "  for i = 1, 100 do\n"
+                              "    y = y + i\n"
+                              "  end\n"
+                              "end\n",
+                              parsed);
+  T_ASSERT_TRUE(parsed);
+  LUA::Verifier::LuaGAMValidator validator(ast);
+  T_ASSERT_TRUE(validator.check_cycle_budget(1000u));
+  T_ASSERT_FALSE(validator.check_cycle_budget(100u));
+  return ok;
+}
+
+bool LuaParserTest::TestCostSignalLengths() {
+  LUA::Verifier::sizes_map_t sizes;
+  sizes.set(StrView("x"), 8u);
+  sizes.set(StrView("y"), 1u);
+  // bounds (1, #x) plus 8 iterations of (y = y + i) and the loop test
+  bool ok = TestCost("function GAM()\n"
+                     "  for i = 1, #x do\n"
+                     "    y = y + i\n"
+                     "  end\n"
+                     "end\n",
+                     3u + 8u * (5u + 1u), true, &sizes);
+  // bounds (0, #x - 1, 2): 4 iterations
+  ok &= TestCost("function GAM()\n"
+                 "  for i = 0, #x - 1, 2 do\n"
+                 "    y = y + i\n"
+                 "  end\n"
+                 "end\n",
+                 6u + 4u * (5u + 1u), true, &sizes);
+  // bounds (-#x, 2 + #y): 12 iterations
+  ok &= TestCost("function GAM()\n"
+                 "  for i = -#x, 2 + #y do\n"
+                 "    y = y + i\n"
+                 "  end\n"
+                 "end\n",
+                 7u + 12u * (5u + 1u), true, &sizes);
+  // unknown signals, other operators and missing sizes are not static
+  ok &= TestCost("function GAM()\n"
+                 "  for i = 1, #n do\n"
+                 "    y = y + i\n"
+                 "  end\n"
+                 "end\n",
+                 0u, false, &sizes);
+  ok &= TestCost("function GAM()\n"
+                 "  for i = 1, #x * 2 do\n"
+                 "    y = y + i\n"
+                 "  end\n"
+                 "end\n",
+                 0u, false, &sizes);
+  ok &= TestCost("function GAM()\n"
+                 "  for i = 1, #x do\n"
+                 "    y = y + i\n"
+                 "  end\n"
+                 "end\n",
+                 0u, false);
+  return ok;
+}
+
+bool TestOptimise(LUA::Optimiser::LuaGAMOptimiser &optimiser,
+                  const char *expected) {
+  bool ok = true;
+  Str code = optimiser.optimise();
+  if (code != expected) {
+    printf("  > optimised code:\n%s\n  > expected:\n%s\n", code.cstr(),
+           expected);
+    T_ASSERT_TRUE(false);
+  }
+  // the generated code must still be valid
+  LUA::parse(code.cstr(), ok);
+  T_ASSERT_TRUE(ok);
+  return ok;
+}
+
+bool LuaParserTest::TestOptimiserFolding() {
+  bool ok = true;
+  LUA::Optimiser::LuaGAMOptimiser optimiser("function GAM()\n"
+                                            "  y = x * gain - offset\n"
+                                            "  z = name .. t.gain\n"
+                                            "end\n",
+                                            ok);
+  T_ASSERT_TRUE(ok);
+  T_ASSERT_TRUE(optimiser.add_constant("gain", "1.5"));
+  T_ASSERT_TRUE(optimiser.add_constant("offset", "-2"));
+  T_ASSERT_TRUE(optimiser.add_constant("name", "\"abc\""));
+  T_ASSERT_FALSE(optimiser.add_constant("table", "{1, 2}"));
+  T_ASSERT_FALSE(optimiser.add_constant("call", "math.cos(1)"));
+  ok &= TestOptimise(optimiser, "function GAM()\n"
+                                "  y = x * 1.5 - (-2)\n"
+                                "  z = \"abc\" .. t.gain\n"
+                                "end\n");
+  T_ASSERT_EQ(optimiser.folded(), 3u);
+  T_ASSERT_EQ(optimiser.eliminated(), 0u);
+  return ok;
+}
+
+bool LuaParserTest::TestOptimiserDeadBranches() {
+  bool ok = true;
+  LUA::Optimiser::LuaGAMOptimiser optimiser(
+      "function GAM()\n"
+      "  if debug then\n"
+      "    print(y)\n"
+      "  elseif mode == 2 then\n"
+      "    y = x\n"
+      "  else\n"
+      "    y = 0\n"
+      "  end\n"
+      "  if x > 1 then y = 1 elseif not debug then y = 2 else y = 3 end\n"
+      "  if debug then y = 4 end\n"
+      "end\n",
+      ok);
+  T_ASSERT_TRUE(ok);
+  T_ASSERT_TRUE(optimiser.add_constant("debug", "false"));
+  T_ASSERT_TRUE(optimiser.add_constant("mode", "2"));
+  // removed lines are kept to preserve the line numbers
+  ok &= TestOptimise(optimiser, "function GAM()\n"
+                                "  do\n"
+                                "    y = x\n"
+                                "  end\n"
+                                "\n"
+                                "\n"
+                                "\n"
+                                "\n"
+                                "  if x > 1 then y = 1 else y = 2 end\n"
+                                "  \n"
+                                "end\n");
+  T_ASSERT_EQ(optimiser.eliminated(), 4u);
+  return ok;
+}
+
+bool LuaParserTest::TestOptimiserAssignedStates() {
+  bool ok = true;
+  LUA::Optimiser::LuaGAMOptimiser optimiser("function GAM()\n"
+                                            "  if enabled then\n"
+                                            "    counter = counter + step\n"
+                                            "  end\n"
+                                            "  local limit = 3\n"
+                                            "  y = limit\n"
+                                            "end\n",
+                                            ok);
+  T_ASSERT_TRUE(ok);
+  T_ASSERT_TRUE(optimiser.add_constant("enabled", "true"));
+  T_ASSERT_TRUE(optimiser.add_constant("counter", "0"));
+  T_ASSERT_TRUE(optimiser.add_constant("limit", "5"));
+  T_ASSERT_TRUE(optimiser.add_constant("step", "1"));
+  T_ASSERT_TRUE(optimiser.add_code("function reset()\n"
+                                   "  step = 0\n"
+                                   "end\n"));
+  // counter, limit and step are assigned, only enabled is constant
+  ok &= TestOptimise(optimiser, "function GAM()\n"
+                                "  do\n"
+                                "    counter = counter + step\n"
+                                "  end\n"
+                                "  local limit = 3\n"
+                                "  y = limit\n"
+                                "end\n");
+  return ok;
+}
+
+bool LuaParserTest::TestParseService() {
+  bool ok = true;
+  const MARTe::uint32 N_JOBS = 64u;
+  const char *codes[] = {"function GAM()\n"
+                         "  for i = 1, 10 do\n"
+                         "    y = y + x * i\n"
+                         "  end\n"
+                         "end\n",
+                         "function GAM()\n"
+                         "  if x > 0 then y = x else y = -x end\n"
+                         "end\n",
+                         "function GAM()\n"
+                         "  y = (x + \n"
+                         "end\n",
+                         "function test()\n"
+                         "end\n"};
+  const bool expected[] = {true, true, false, false};
+  LUA::ParseService &service = LUA::ParseService::instance();
+  T_ASSERT_TRUE(service.workers() > 0u);
+  LUA::parse_job_t *jobs = new LUA::parse_job_t[N_JOBS];
+  for (MARTe::uint32 i = 0u; i < N_JOBS; i++) {
+    jobs[i].code = codes[i % 4u];
+    jobs[i].only_gam = true;
+    service.submit(jobs[i]);
+  }
+  // wait in reverse order to exercise both the queued and completed jobs
+  for (MARTe::uint32 i = N_JOBS; i > 0u; i--) {
+    LUA::parse_job_t &job = jobs[i - 1u];
+    T_ASSERT_EQ(service.wait(job), expected[(i - 1u) % 4u]);
+    T_ASSERT_TRUE(job.done);
+    if (job.ok) {
+      bool parsed = true;
+      LUA::ast_t ast = LUA::parse(job.code, parsed);
+      T_ASSERT_TRUE(parsed);
+      T_ASSERT_EQ(job.ast.nodes.len(), ast.nodes.len());
+      T_ASSERT_TRUE(job.ast[0]->toString() == ast[0]->toString());
+    }
+  }
+  delete[] jobs;
+  // cycle budget is verified by the job
+  LUA::parse_job_t job;
+  job.code = codes[0];
+  job.cycle_budget = 10u;
+  service.submit(job);
+  T_ASSERT_FALSE(service.wait(job));
+  return ok;
+}
+
+bool LuaParserTest::TestSymbolInterning() {
+  bool ok = true;
+  LUA::tokens_t tokens = LUA::scan("local a = b\n"
+                                   "a = a + \"a\"\n"
+                                   "b.c = a\n",
+                                   ok);
+  T_ASSERT_TRUE(ok);
+  T_ASSERT_FALSE(tokens.symbols.isNull());
+  // a, b and c
+  T_ASSERT_EQ(tokens.symbols->len(), 3u);
+  MARTe::uint32 a_sym = NO_SYMBOL;
+  for (MARTe::uint32 i = 0u; i < tokens.toks.len(); i++) {
+    LUA::Tokenp tok = tokens.toks[i];
+    if (tok->type == LUA::ID) {
+      T_ASSERT_TRUE(tok->sym != NO_SYMBOL);
+      T_ASSERT_TRUE(tokens.symbols->name(tok->sym) == tok->raw);
+      if (tok->raw == "a") {
+        if (a_sym == NO_SYMBOL) {
+          a_sym = tok->sym;
+        }
+        T_ASSERT_EQ(tok->sym, a_sym);
+      } else {
+        T_ASSERT_TRUE(tok->sym != a_sym);
+      }
+    } else {
+      // keywords, operators and strings are not interned
+      T_ASSERT_EQ(tok->sym, NO_SYMBOL);
+    }
+  }
+  MARTe::uint32 sym = NO_SYMBOL;
+  T_ASSERT_TRUE(tokens.symbols->find("a", sym));
+  T_ASSERT_EQ(sym, a_sym);
+  T_ASSERT_FALSE(tokens.symbols->find("d", sym));
+  T_ASSERT_EQ(sym, NO_SYMBOL);
+  T_ASSERT_FALSE(tokens.symbols->find("local", sym));
+  // the table grows keeping the symbols
+  LUA::symbols_t symbols;
+  char name[16];
+  for (MARTe::uint32 i = 0u; i < 1000u; i++) {
+    snprintf(name, sizeof(name), "v%u", i);
+    T_ASSERT_EQ(symbols.intern(name, strlen(name)), i);
+  }
+  for (MARTe::uint32 i = 0u; i < 1000u; i++) {
+    snprintf(name, sizeof(name), "v%u", i);
+    T_ASSERT_TRUE(symbols.find(name, sym));
+    T_ASSERT_EQ(sym, i);
+    T_ASSERT_TRUE(symbols.name(i) == name);
+  }
+  // the AST shares the table of the tokens
+  LUA::ast_t ast = LUA::parse("function GAM()\n"
+                              "  y = x\n"
+                              "end\n",
+                              ok);
+  T_ASSERT_TRUE(ok);
+  T_ASSERT_FALSE(ast.symbols.isNull());
+  T_ASSERT_TRUE(ast.symbols->find("GAM", sym));
+  LUA::Verifier::LuaGAMValidator validator(ast);
+  T_ASSERT_TRUE(validator.check_gam());
+  T_ASSERT_TRUE(validator.validate_input_signal("x"));
+  T_ASSERT_TRUE(validator.validate_output_signal("y", 10u));
+  T_ASSERT_FALSE(validator.validate_input_signal("z"));
+  return ok;
+}
+
 bool LuaGAMTest::TestEmptyInitialisation() {
   bool ok = true;
   LuaFriend luagam;
@@ -1082,3 +1466,178 @@ bool LuaGAMTest::TestSimulatorGAM() {
   // MARTe::float32 *y = (MARTe::float32 *)luagam.output_pointer(0);
   return ok;
 }
+
+bool LuaGAMTest::TestInitCycleBudget() {
+  bool ok = true;
+  const char *code = "function GAM()\n"
+                     "  for i = 1, 100 do\n"
+                     "    y = y + x * i\n"
+                     "  end\n"
+                     "end\n";
+  {
+    LuaFriend luagam;
+    MARTe::ConfigurationDatabase db = MARTe::GAMDB::create();
+    MARTe::GAMDB::set_parameter(db, "Code", code);
+    MARTe::GAMDB::set_parameter(db, "CycleBudget", 1000u);
+    MARTe::GAMDB::add_input(db, "x", "float32", DB_TEST);
+    MARTe::GAMDB::add_output(db, "y", "float32", DB_TEST);
+    MARTe::ConfigurationDatabase cdb = MARTe::GAMDB::make_cdb(db, ok);
+    T_ASSERT_TRUE(ok);
+    T_ASSERT_TRUE(luagam.Initialise(db));
+    T_ASSERT_TRUE(luagam.SetConfiguredDatabase(cdb));
+    T_ASSERT_TRUE(luagam.Setup());
+  }
+  {
+    LuaFriend luagam;
+    MARTe::ConfigurationDatabase db = MARTe::GAMDB::create();
+    MARTe::GAMDB::set_parameter(db, "Code", code);
+    MARTe::GAMDB::set_parameter(db, "CycleBudget", 100u);
+    MARTe::GAMDB::add_input(db, "x", "float32", DB_TEST);
+    MARTe::GAMDB::add_output(db, "y", "float32", DB_TEST);
+    MARTe::ConfigurationDatabase cdb = MARTe::GAMDB::make_cdb(db, ok);
+    T_ASSERT_TRUE(ok);
+    T_ASSERT_TRUE(luagam.Initialise(db));
+    T_ASSERT_TRUE(luagam.SetConfiguredDatabase(cdb));
+    T_ASSERT_FALSE(luagam.Setup());
+  }
+  {
+    LuaFriend luagam;
+    MARTe::ConfigurationDatabase db = MARTe::GAMDB::create();
+    MARTe::GAMDB::set_parameter(db, "Code", "function GAM()\n"
+                                            "  while y < x do\n"
+                                            "    y = y + 1\n"
+                                            "  end\n"
+                                            "end\n");
+    MARTe::GAMDB::set_parameter(db, "CycleBudget", 1000u);
+    MARTe::GAMDB::add_input(db, "x", "float32", DB_TEST);
+    MARTe::GAMDB::add_output(db, "y", "float32", DB_TEST);
+    MARTe::ConfigurationDatabase cdb = MARTe::GAMDB::make_cdb(db, ok);
+    T_ASSERT_TRUE(ok);
+    T_ASSERT_TRUE(luagam.Initialise(db));
+    T_ASSERT_TRUE(luagam.SetConfiguredDatabase(cdb));
+    T_ASSERT_FALSE(luagam.Setup());
+  }
+  return ok;
+}
+
+bool LuaGAMTest::TestInitCycleBudgetArray() {
+  bool ok = true;
+  const char *code = "function GAM()\n"
+                     "  y = 0\n"
+                     "  for i = 1, #x do\n"
+                     "    y = y + x[i]\n"
+                     "  end\n"
+                     "end\n";
+  for (MARTe::uint32 parallel = 0u; parallel < 2u; parallel++) {
+    {
+      LuaFriend luagam;
+      MARTe::ConfigurationDatabase db = MARTe::GAMDB::create();
+      MARTe::GAMDB::set_parameter(db, "Code", code);
+      MARTe::GAMDB::set_parameter(db, "CycleBudget", 1000u);
+      MARTe::GAMDB::set_parameter(db, "ParallelParsing", parallel);
+      MARTe::GAMDB::add_input(db, "x", "float32", DB_TEST, 1, 16);
+      MARTe::GAMDB::add_output(db, "y", "float32", DB_TEST);
+      MARTe::ConfigurationDatabase cdb = MARTe::GAMDB::make_cdb(db, ok);
+      T_ASSERT_TRUE(ok);
+      T_ASSERT_TRUE(luagam.Initialise(db));
+      T_ASSERT_TRUE(luagam.SetConfiguredDatabase(cdb));
+      T_ASSERT_TRUE(luagam.Setup());
+    }
+    {
+      // 16 iterations do not fit
+      LuaFriend luagam;
+      MARTe::ConfigurationDatabase db = MARTe::GAMDB::create();
+      MARTe::GAMDB::set_parameter(db, "Code", code);
+      MARTe::GAMDB::set_parameter(db, "CycleBudget", 100u);
+      MARTe::GAMDB::set_parameter(db, "ParallelParsing", parallel);
+      MARTe::GAMDB::add_input(db, "x", "float32", DB_TEST, 1, 16);
+      MARTe::GAMDB::add_output(db, "y", "float32", DB_TEST);
+      MARTe::ConfigurationDatabase cdb = MARTe::GAMDB::make_cdb(db, ok);
+      T_ASSERT_TRUE(ok);
+      T_ASSERT_TRUE(luagam.Initialise(db));
+      T_ASSERT_TRUE(luagam.SetConfiguredDatabase(cdb));
+      T_ASSERT_FALSE(luagam.Setup());
+    }
+  }
+  return ok;
+}
+
+bool LuaGAMTest::TestExecOptimised() {
+  bool ok = true;
+  LuaFriend luagam;
+  MARTe::ConfigurationDatabase db = MARTe::GAMDB::create();
+  MARTe::GAMDB::add_input(db, "x", "float64", DB_TEST);
+  MARTe::GAMDB::add_output(db, "y", "float64", DB_TEST);
+  const char *code = "function GAM()\n"
+                     "  if debug then\n"
+                     "    y = -x\n"
+                     "  else\n"
+                     "    y = x * gain\n"
+                     "  end\n"
+                     "end\n";
+  MARTe::GAMDB::set_parameter(db, "Code", code);
+  MARTe::GAMDB::set_parameter(db, "Optimise", 1u);
+  T_ASSERT_TRUE(db.CreateAbsolute("InternalStates"));
+  T_ASSERT_TRUE(addInternalState(db, "debug", "false"));
+  T_ASSERT_TRUE(addInternalState(db, "gain", "2"));
+  db.MoveToRoot();
+  MARTe::ConfigurationDatabase cdb = MARTe::GAMDB::make_cdb(db, ok);
+  T_ASSERT_TRUE(ok);
+  T_ASSERT_TRUE(luagam.Initialise(db));
+  T_ASSERT_TRUE(luagam.SetConfiguredDatabase(cdb));
+  T_ASSERT_TRUE(luagam.AllocateInputSignalsMemory());
+  T_ASSERT_TRUE(luagam.AllocateOutputSignalsMemory());
+  T_ASSERT_TRUE(luagam.Setup());
+  MARTe::float64 *x = (MARTe::float64 *)luagam.input_pointer(0);
+  MARTe::float64 *y = (MARTe::float64 *)luagam.output_pointer(0);
+  *x = 1.5;
+  T_ASSERT_TRUE(luagam.Execute());
+  T_ASSERT_EQ(*y, 3.0);
+  return ok;
+}
+
+bool LuaGAMTest::TestParallelParsing() {
+  bool ok = true;
+  const MARTe::uint32 N_GAMS = 16u;
+  LuaFriend *gams = new LuaFriend[N_GAMS];
+  MARTe::ConfigurationDatabase *cdbs = new MARTe::ConfigurationDatabase[N_GAMS];
+  for (MARTe::uint32 i = 0u; ok && i < N_GAMS; i++) {
+    MARTe::ConfigurationDatabase db = MARTe::GAMDB::create();
+    MARTe::GAMDB::add_input(db, "x", "float64", DB_TEST);
+    MARTe::GAMDB::add_output(db, "y", "float64", DB_TEST);
+    // the last GAM does not write its output
+    const char *code = (i + 1u < N_GAMS) ? "function GAM()\n"
+                                           "  y = x * 2\n"
+                                           "end\n"
+                                         : "function GAM()\n"
+                                           "  z = x * 2\n"
+                                           "end\n";
+    MARTe::GAMDB::set_parameter(db, "Code", code);
+    MARTe::GAMDB::set_parameter(db, "ParallelParsing", 1u);
+    cdbs[i] = MARTe::GAMDB::make_cdb(db, ok);
+    T_ASSERT_TRUE(ok);
+    T_ASSERT_TRUE(gams[i].Initialise(db));
+  }
+  for (MARTe::uint32 i = 0u; ok && i < N_GAMS; i++) {
+    T_ASSERT_TRUE(gams[i].SetConfiguredDatabase(cdbs[i]));
+    T_ASSERT_TRUE(gams[i].AllocateInputSignalsMemory());
+    T_ASSERT_TRUE(gams[i].AllocateOutputSignalsMemory());
+    T_ASSERT_EQ(gams[i].Setup(), i + 1u < N_GAMS);
+  }
+  MARTe::float64 *x = (MARTe::float64 *)gams[0].input_pointer(0);
+  MARTe::float64 *y = (MARTe::float64 *)gams[0].output_pointer(0);
+  *x = 1.5;
+  T_ASSERT_TRUE(gams[0].Execute());
+  T_ASSERT_EQ(*y, 3.0);
+  delete[] cdbs;
+  delete[] gams;
+  // a GAM destroyed before Setup waits for its pending job
+  {
+    LuaFriend luagam;
+    MARTe::ConfigurationDatabase db = MARTe::GAMDB::create();
+    MARTe::GAMDB::set_parameter(db, "Code", "function GAM() end");
+    MARTe::GAMDB::set_parameter(db, "ParallelParsing", 1u);
+    T_ASSERT_TRUE(luagam.Initialise(db));
+  }
+  return ok;
+}
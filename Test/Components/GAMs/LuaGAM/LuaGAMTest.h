@@ -25,6 +25,10 @@ public:
   bool TestExecWithAuxiliaries();
   bool TestExecWrongAuxiliaries();
   bool TestSimulatorGAM();
+  bool TestInitCycleBudget();
+  bool TestInitCycleBudgetArray();
+  bool TestExecOptimised();
+  bool TestParallelParsing();
 };
 
 class LuaParserTest {
@@ -51,7 +55,17 @@ public:
   bool TestParserStatements();
   bool TestParserDeclarations();
   bool TestParserComments();
+  bool TestParserMalformedInput();
   bool TestUnopBinop();
+  bool TestCostEstimation();
+  bool TestCostNestedLoops();
+  bool TestCostUnboundedLoops();
+  bool TestCostSignalLengths();
+  bool TestOptimiserFolding();
+  bool TestOptimiserDeadBranches();
+  bool TestOptimiserAssignedStates();
+  bool TestParseService();
+  bool TestSymbolInterning();
 };
 
 #endif
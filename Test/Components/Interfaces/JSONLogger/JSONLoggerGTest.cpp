@@ -2,7 +2,14 @@
 #include "ErrorType.h"
 #include "JSONLogger.h"
 #include "LoggerService.h"
+#include "Str.h"
+#include "StringHelper.h"
 #include "gtest/gtest.h"
+#include <glob.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
 
 TEST(JSONLogger, Init) {
   MARTe::JSONLogger logger;
@@ -68,3 +75,279 @@ TEST(JSONLogger, SanitizeLog) {
   Sleep::Sec(0.1);
   ASSERT_TRUE(true);
 }
+
+namespace {
+/**
+ * @brief number of lines of a file containing `pattern`
+ **/
+MARTe::uint32 count_lines(const char *path, const char *pattern) {
+  MARTe::uint32 n = 0u;
+  FILE *file = fopen(path, "r");
+  if (file != NULL) {
+    char line[1024];
+    while (fgets(line, sizeof(line), file) != NULL) {
+      if (strstr(line, pattern) != NULL) {
+        n++;
+      }
+    }
+    fclose(file);
+  }
+  return n;
+}
+} // namespace
+
+TEST(JSONLogger, QueueFull) {
+  using namespace MARTe;
+  const uint32 messages = 10000u;
+  uint32 dropped;
+  remove("/tmp/test_queue_full.log");
+  {
+    JSONLogger logger;
+    ConfigurationDatabase cdb;
+    cdb.Write("LogPath", "/tmp/test_queue_full");
+    cdb.Write("QueueSize", 2u);
+    ASSERT_TRUE(logger.Initialise(cdb));
+    LoggerPage page;
+    page.errorInfo.header.errorType = ErrorManagement::Information;
+    page.errorInfo.timeSeconds = 0u;
+    page.errorInfo.hrtTime = 0u;
+    page.errorInfo.fileName = __FILE__;
+    StringHelper::Copy(page.errorStrBuffer, "QueueFullMessage");
+    // never blocks, the messages not queued are dropped
+    for (uint32 i = 0u; i < messages; i++) {
+      logger.ConsumeLogMessage(&page);
+    }
+    dropped = logger.GetDroppedMessages();
+  }
+  // every message is either written or counted as dropped
+  ASSERT_EQ(count_lines("/tmp/test_queue_full.log", "QueueFullMessage"),
+            messages - dropped);
+  if (dropped > 0u) {
+    ASSERT_TRUE(count_lines("/tmp/test_queue_full.log", "dropped") > 0u);
+  }
+}
+
+TEST(JSONLogger, Rotation) {
+  using namespace MARTe;
+  glob_t found;
+  if (glob("/tmp/test_rotation.log*", 0, NULL, &found) == 0) {
+    for (size_t i = 0u; i < found.gl_pathc; i++) {
+      remove(found.gl_pathv[i]);
+    }
+    globfree(&found);
+  }
+  {
+    JSONLogger logger;
+    ConfigurationDatabase cdb;
+    cdb.Write("LogPath", "/tmp/test_rotation");
+    cdb.Write("MaxFileSizeMB", 1u);
+    cdb.Write("KeepFiles", 2u);
+    ASSERT_TRUE(logger.Initialise(cdb));
+    LoggerPage page;
+    page.errorInfo.header.errorType = ErrorManagement::Information;
+    page.errorInfo.timeSeconds = 0u;
+    page.errorInfo.hrtTime = 0u;
+    page.errorInfo.fileName = __FILE__;
+    memset(page.errorStrBuffer, 'x', 100u);
+    page.errorStrBuffer[100] = 0;
+    // about 10 MB, in bursts that fit in the queue
+    for (uint32 i = 0u; i < 40000u; i++) {
+      logger.ConsumeLogMessage(&page);
+      if ((i % 512u) == 0u) {
+        Sleep::MSec(2u);
+      }
+    }
+  }
+  // only the last rotated files are kept (compressed or not)
+  ASSERT_EQ(glob("/tmp/test_rotation.log.*", 0, NULL, &found), 0);
+  ASSERT_EQ(found.gl_pathc, 2u);
+  globfree(&found);
+}
+
+TEST(JSONLogger, BinaryFormat) {
+  using namespace MARTe;
+  const uint32 messages = 100u;
+  remove("/tmp/test_binary.bin");
+  {
+    JSONLogger logger;
+    ConfigurationDatabase cdb;
+    cdb.Write("LogPath", "/tmp/test_binary");
+    cdb.Write("Format", "Binary");
+    cdb.Write("QueueSize", 256u);
+    ASSERT_TRUE(logger.Initialise(cdb));
+    LoggerPage page;
+    page.errorInfo.header.errorType = ErrorManagement::Warning;
+    page.errorInfo.header.lineNumber = 42u;
+    page.errorInfo.timeSeconds = 0u;
+    page.errorInfo.hrtTime = 0u;
+    page.errorInfo.fileName = __FILE__;
+    StringHelper::Copy(page.errorStrBuffer, "Binary \"message\"");
+    for (uint32 i = 0u; i < messages; i++) {
+      logger.ConsumeLogMessage(&page);
+    }
+    ASSERT_EQ(logger.GetDroppedMessages(), 0u);
+  }
+  FILE *in = fopen("/tmp/test_binary.bin", "rb");
+  FILE *out = fopen("/tmp/test_binary.log", "w");
+  ASSERT_TRUE(in != NULL && out != NULL);
+  ASSERT_TRUE(JSONLogger::ConvertBinaryLog(in, out, false));
+  fclose(in);
+  fclose(out);
+  // the same lines written in json format
+  ASSERT_EQ(count_lines("/tmp/test_binary.log",
+                        "\"error_type\":\"Warning\", \"file_name\":\"" __FILE__
+                        "\", \"line_number\":42, "
+                        "\"message\":\"Binary \\\"message\\\"\"}"),
+            messages);
+  remove("/tmp/test_binary.log");
+}
+
+TEST(JSONLogger, BinaryFileNames) {
+  using namespace MARTe;
+  remove("/tmp/test_binary_names.bin");
+  // the same address holds another file name (e.g. a reloaded library)
+  char8 file_name[32];
+  {
+    JSONLogger logger;
+    ConfigurationDatabase cdb;
+    cdb.Write("LogPath", "/tmp/test_binary_names");
+    cdb.Write("Format", "Binary");
+    ASSERT_TRUE(logger.Initialise(cdb));
+    LoggerPage page;
+    page.errorInfo.header.errorType = ErrorManagement::Information;
+    page.errorInfo.timeSeconds = 0u;
+    page.errorInfo.hrtTime = 0u;
+    page.errorInfo.fileName = file_name;
+    StringHelper::Copy(page.errorStrBuffer, "FileNameMessage");
+    StringHelper::Copy(file_name, "FirstFile.cpp");
+    logger.ConsumeLogMessage(&page);
+    // written before the name changes
+    Sleep::MSec(100u);
+    StringHelper::Copy(file_name, "SecondFile.cpp");
+    logger.ConsumeLogMessage(&page);
+  }
+  FILE *in = fopen("/tmp/test_binary_names.bin", "rb");
+  FILE *out = fopen("/tmp/test_binary_names.log", "w");
+  ASSERT_TRUE(in != NULL && out != NULL);
+  ASSERT_TRUE(JSONLogger::ConvertBinaryLog(in, out, false));
+  fclose(in);
+  fclose(out);
+  ASSERT_EQ(count_lines("/tmp/test_binary_names.log",
+                        "\"file_name\":\"FirstFile.cpp\""),
+            1u);
+  ASSERT_EQ(count_lines("/tmp/test_binary_names.log",
+                        "\"file_name\":\"SecondFile.cpp\""),
+            1u);
+  remove("/tmp/test_binary_names.log");
+}
+
+namespace {
+/**
+ * @brief pages of the Timestamps test: same second, next second and across
+ * a day boundary (UTC)
+ **/
+const MARTe::uint32 time_pages = 5u;
+const MARTe::uint32 time_seconds[time_pages] = {1700000000u, 1700000000u,
+                                                1700000001u, 1700006399u,
+                                                1700006400u};
+const MARTe::uint32 time_microseconds[time_pages] = {5u, 999999u, 0u, 123456u,
+                                                     1u};
+
+/**
+ * @brief log the pages of the Timestamps test in `<path>.log`
+ **/
+void log_time_pages(const char *path, const bool epoch_ns) {
+  using namespace MARTe;
+  Str log_path(path);
+  log_path.append(".log");
+  remove(log_path.cstr());
+  JSONLogger logger;
+  ConfigurationDatabase cdb;
+  cdb.Write("LogPath", path);
+  cdb.Write("EpochTimestamp", epoch_ns);
+  ASSERT_TRUE(logger.Initialise(cdb));
+  LoggerPage page;
+  page.errorInfo.header.errorType = ErrorManagement::Information;
+  page.errorInfo.hrtTime = 0u;
+  page.errorInfo.fileName = __FILE__;
+  StringHelper::Copy(page.errorStrBuffer, "TimestampMessage");
+  for (uint32 i = 0u; i < time_pages; i++) {
+    page.errorInfo.timeSeconds = time_seconds[i];
+    page.errorInfo.timeMicroseconds = time_microseconds[i];
+    logger.ConsumeLogMessage(&page);
+  }
+}
+} // namespace
+
+TEST(JSONLogger, Timestamps) {
+  // the dates are converted in local time by MARTe2
+  const char *tz = getenv("TZ");
+  MARTe::Str old_tz(tz != NULL ? tz : "");
+  setenv("TZ", "UTC", 1);
+  tzset();
+  log_time_pages("/tmp/test_timestamps", false);
+  const char *dates[time_pages] = {
+      "\"timestamp\":\"2023-11-14T22:13:20.000005\"",
+      "\"timestamp\":\"2023-11-14T22:13:20.999999\"",
+      "\"timestamp\":\"2023-11-14T22:13:21.000000\"",
+      "\"timestamp\":\"2023-11-14T23:59:59.123456\"",
+      "\"timestamp\":\"2023-11-15T00:00:00.000001\""};
+  for (MARTe::uint32 i = 0u; i < time_pages; i++) {
+    ASSERT_EQ(count_lines("/tmp/test_timestamps.log", dates[i]), 1u);
+  }
+  log_time_pages("/tmp/test_timestamps", true);
+  const char *nanoseconds[time_pages] = {
+      "\"timestamp\":1700000000000005000,",
+      "\"timestamp\":1700000000999999000,",
+      "\"timestamp\":1700000001000000000,",
+      "\"timestamp\":1700006399123456000,",
+      "\"timestamp\":1700006400000001000,"};
+  for (MARTe::uint32 i = 0u; i < time_pages; i++) {
+    ASSERT_EQ(count_lines("/tmp/test_timestamps.log", nanoseconds[i]), 1u);
+  }
+  ASSERT_EQ(count_lines("/tmp/test_timestamps.log", "TimestampMessage"),
+            time_pages);
+  if (tz != NULL) {
+    setenv("TZ", old_tz.cstr(), 1);
+  } else {
+    unsetenv("TZ");
+  }
+  tzset();
+  remove("/tmp/test_timestamps.log");
+}
+
+TEST(JSONLogger, ErrorTypes) {
+  using namespace MARTe;
+  const ErrorManagement::ErrorType types[] = {
+      ErrorManagement::Information, ErrorManagement::Warning,
+      ErrorManagement::Information, ErrorManagement::FatalError,
+      ErrorManagement::Warning, ErrorManagement::Information};
+  const uint32 n_types = sizeof(types) / sizeof(types[0]);
+  remove("/tmp/test_error_types.log");
+  {
+    JSONLogger logger;
+    ConfigurationDatabase cdb;
+    cdb.Write("LogPath", "/tmp/test_error_types");
+    ASSERT_TRUE(logger.Initialise(cdb));
+    LoggerPage page;
+    page.errorInfo.timeSeconds = 0u;
+    page.errorInfo.hrtTime = 0u;
+    page.errorInfo.fileName = __FILE__;
+    StringHelper::Copy(page.errorStrBuffer, "ErrorTypeMessage");
+    for (uint32 i = 0u; i < n_types; i++) {
+      page.errorInfo.header.errorType = types[i];
+      logger.ConsumeLogMessage(&page);
+    }
+  }
+  // the names cached for each value
+  ASSERT_EQ(count_lines("/tmp/test_error_types.log",
+                        "\"error_type\":\"Information\""),
+            3u);
+  ASSERT_EQ(
+      count_lines("/tmp/test_error_types.log", "\"error_type\":\"Warning\""),
+      2u);
+  ASSERT_EQ(count_lines("/tmp/test_error_types.log",
+                        "\"error_type\":\"FatalError\""),
+            1u);
+  remove("/tmp/test_error_types.log");
+}
@@ -0,0 +1,27 @@
+#include "ArcTest.h"
+#include "gtest/gtest.h"
+
+TEST(Arc, TestConstructor) {
+  ArcTest tester;
+  ASSERT_TRUE(tester.TestConstructor());
+}
+
+TEST(Arc, TestMakeArc) {
+  ArcTest tester;
+  ASSERT_TRUE(tester.TestMakeArc());
+}
+
+TEST(Arc, TestWeakReferences) {
+  ArcTest tester;
+  ASSERT_TRUE(tester.TestWeakReferences());
+}
+
+TEST(Arc, TestConcurrentCopies) {
+  ArcTest tester;
+  ASSERT_TRUE(tester.TestConcurrentCopies());
+}
+
+TEST(Arc, TestConcurrentUpgrade) {
+  ArcTest tester;
+  ASSERT_TRUE(tester.TestConcurrentUpgrade());
+}
@@ -0,0 +1,163 @@
+#include "ArcTest.h"
+#include "Arc.h"
+#include "TestMacros.h"
+#include <pthread.h>
+
+using namespace MARTe;
+
+#define ARC_TEST_THREADS 4u
+#define ARC_TEST_LOOPS 20000u
+
+namespace {
+
+struct shared_t {
+  static volatile int32 alive;
+  int32 x;
+  int32 y;
+  shared_t() : x(0), y(0) { __sync_fetch_and_add(&alive, 1); }
+  shared_t(int32 x_, int32 y_) : x(x_), y(y_) {
+    __sync_fetch_and_add(&alive, 1);
+  }
+  shared_t(const shared_t &other) : x(other.x), y(other.y) {
+    __sync_fetch_and_add(&alive, 1);
+  }
+  ~shared_t() { __sync_fetch_and_sub(&alive, 1); }
+};
+
+volatile int32 shared_t::alive = 0;
+
+struct worker_t {
+  Arc<shared_t> ptr;
+  uint32 errors;
+};
+
+void *copy_worker(void *arg) {
+  worker_t *worker = static_cast<worker_t *>(arg);
+  for (uint32 i = 0u; i < ARC_TEST_LOOPS; i++) {
+    Arc<shared_t> copy(worker->ptr);
+    Arc<shared_t> weak = ~copy;
+    Arc<shared_t> hard = +weak;
+    if (hard.isNull() || hard->x != 1 || hard->y != 2) {
+      worker->errors++;
+    }
+  }
+  worker->ptr.del();
+  return NULL_PTR(void *);
+}
+
+void *upgrade_worker(void *arg) {
+  worker_t *worker = static_cast<worker_t *>(arg);
+  // the hard references are dropped while the weak ones are upgraded
+  for (uint32 i = 0u; i < ARC_TEST_LOOPS; i++) {
+    Arc<shared_t> hard = +worker->ptr;
+    if (!hard.isNull() && (hard->x != 1 || hard->y != 2)) {
+      worker->errors++;
+    }
+  }
+  worker->ptr.del();
+  return NULL_PTR(void *);
+}
+
+bool run_workers(void *(*fun)(void *), Arc<shared_t> &ptr, bool weak) {
+  pthread_t threads[ARC_TEST_THREADS];
+  worker_t workers[ARC_TEST_THREADS];
+  for (uint32 i = 0u; i < ARC_TEST_THREADS; i++) {
+    if (weak) {
+      workers[i].ptr %= ptr;
+    } else {
+      workers[i].ptr = ptr;
+    }
+    workers[i].errors = 0u;
+  }
+  for (uint32 i = 0u; i < ARC_TEST_THREADS; i++) {
+    pthread_create(&threads[i], NULL_PTR(const pthread_attr_t *), fun,
+                   &workers[i]);
+  }
+  ptr.del();
+  uint32 errors = 0u;
+  for (uint32 i = 0u; i < ARC_TEST_THREADS; i++) {
+    pthread_join(threads[i], NULL_PTR(void **));
+    errors += workers[i].errors;
+  }
+  return errors == 0u;
+}
+
+} // namespace
+
+bool ArcTest::TestConstructor() {
+  Arc<int32> p0;
+  T_ASSERT_TRUE(p0.isNull());
+  T_ASSERT_EQ(p0.referencesCount(), 0u);
+  Arc<int32> p1(10);
+  T_ASSERT_FALSE(p1.isNull());
+  T_ASSERT_EQ(*p1, 10);
+  Arc<int32> p2(new int32(11));
+  T_ASSERT_FALSE(p2.isNull());
+  T_ASSERT_EQ(p2.val(), 11);
+  Arc<int32> p3(p1);
+  T_ASSERT_TRUE(p3.same(p1));
+  T_ASSERT_EQ(p1.referencesCount(), 2u);
+  p3 = p2;
+  T_ASSERT_EQ(p1.referencesCount(), 1u);
+  T_ASSERT_EQ(p2.referencesCount(), 2u);
+  p3.del();
+  T_ASSERT_TRUE(p3.isNull());
+  T_ASSERT_EQ(p2.referencesCount(), 1u);
+  return true;
+}
+
+bool ArcTest::TestMakeArc() {
+  {
+    Arc<shared_t> a = make_arc<shared_t>(1, 2);
+    T_ASSERT_EQ(a->x, 1);
+    T_ASSERT_EQ(a->y, 2);
+    T_ASSERT_EQ(shared_t::alive, 1);
+    Arc<shared_t> b = make_arc<shared_t>();
+    T_ASSERT_EQ(shared_t::alive, 2);
+    b = a;
+    T_ASSERT_EQ(shared_t::alive, 1);
+    T_ASSERT_EQ(a.referencesCount(), 2u);
+  }
+  T_ASSERT_EQ(shared_t::alive, 0);
+  return true;
+}
+
+bool ArcTest::TestWeakReferences() {
+  Arc<shared_t> weak;
+  {
+    Arc<shared_t> a = make_arc<shared_t>(3, 4);
+    weak = ~a;
+    T_ASSERT_TRUE(weak.isWeak());
+    T_ASSERT_FALSE(weak.isNull());
+    T_ASSERT_EQ(a.referencesCount(), 1u);
+    T_ASSERT_EQ(a.weakReferencesCount(), 1u);
+    Arc<shared_t> hard = +weak;
+    T_ASSERT_FALSE(hard.isWeak());
+    T_ASSERT_EQ(hard->y, 4);
+    T_ASSERT_EQ(a.referencesCount(), 2u);
+  }
+  T_ASSERT_EQ(shared_t::alive, 0);
+  T_ASSERT_TRUE(weak.isNull());
+  T_ASSERT_EQ(weak.weakReferencesCount(), 1u);
+  Arc<shared_t> hard = +weak;
+  T_ASSERT_TRUE(hard.isNull());
+  weak.del();
+  T_ASSERT_TRUE(weak.isNull());
+  return true;
+}
+
+bool ArcTest::TestConcurrentCopies() {
+  Arc<shared_t> ptr = make_arc<shared_t>(1, 2);
+  T_ASSERT_TRUE(run_workers(&copy_worker, ptr, false));
+  T_ASSERT_EQ(shared_t::alive, 0);
+  return true;
+}
+
+bool ArcTest::TestConcurrentUpgrade() {
+  for (uint32 i = 0u; i < 8u; i++) {
+    Arc<shared_t> ptr = make_arc<shared_t>(1, 2);
+    T_ASSERT_TRUE(run_workers(&upgrade_worker, ptr, true));
+    T_ASSERT_EQ(shared_t::alive, 0);
+  }
+  return true;
+}
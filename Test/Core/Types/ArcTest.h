@@ -0,0 +1,16 @@
+#ifndef _EC_ARC_TEST_H__
+#define _EC_ARC_TEST_H__
+
+/**
+ @brief Tests atomically reference counted pointer
+**/
+class ArcTest {
+public:
+  bool TestConstructor();
+  bool TestMakeArc();
+  bool TestWeakReferences();
+  bool TestConcurrentCopies();
+  bool TestConcurrentUpgrade();
+};
+
+#endif
@@ -0,0 +1,47 @@
+#include "ArenaTest.h"
+#include "gtest/gtest.h"
+
+TEST(Arena, TestConstructor) {
+  ArenaTest tester;
+  ASSERT_TRUE(tester.TestConstructor());
+}
+
+TEST(Arena, TestAllocate) {
+  ArenaTest tester;
+  ASSERT_TRUE(tester.TestAllocate());
+}
+
+TEST(Arena, TestGrowth) {
+  ArenaTest tester;
+  ASSERT_TRUE(tester.TestGrowth());
+}
+
+TEST(Arena, TestRewind) {
+  ArenaTest tester;
+  ASSERT_TRUE(tester.TestRewind());
+}
+
+TEST(Arena, TestReset) {
+  ArenaTest tester;
+  ASSERT_TRUE(tester.TestReset());
+}
+
+TEST(Arena, TestExternalBuffer) {
+  ArenaTest tester;
+  ASSERT_TRUE(tester.TestExternalBuffer());
+}
+
+TEST(Arena, TestScope) {
+  ArenaTest tester;
+  ASSERT_TRUE(tester.TestScope());
+}
+
+TEST(Arena, TestContainers) {
+  ArenaTest tester;
+  ASSERT_TRUE(tester.TestContainers());
+}
+
+TEST(Arena, TestExhausted) {
+  ArenaTest tester;
+  ASSERT_TRUE(tester.TestExhausted());
+}
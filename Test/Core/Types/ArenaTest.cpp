@@ -0,0 +1,238 @@
+#include "ArenaTest.h"
+#include "Arena.h"
+#include "MpscRing.h"
+#include "Pool.h"
+#include "Str.h"
+#include "StrBuilder.h"
+#include "TestMacros.h"
+#include "Vec.h"
+#include <stdint.h>
+#include <string.h>
+
+using namespace MARTe;
+
+namespace {
+bool aligned(const void *ptr) {
+  return (reinterpret_cast<uintptr_t>(ptr) % Arena::alignment) == 0u;
+}
+} // namespace
+
+bool ArenaTest::TestConstructor() {
+  Arena a;
+  // nothing is allocated before the first use
+  T_ASSERT_EQ(a.capacity(), 0u);
+  T_ASSERT_EQ(a.used(), 0u);
+  Arena b(128u);
+  T_ASSERT_TRUE(b.allocate(1u) != NULL_PTR(void *));
+  T_ASSERT_EQ(b.capacity(), 128u);
+  T_ASSERT_EQ(b.used(), 1u);
+  return true;
+}
+
+bool ArenaTest::TestAllocate() {
+  Arena a(256u);
+  char *p = static_cast<char *>(a.allocate(3u));
+  char *q = static_cast<char *>(a.allocate(5u));
+  T_ASSERT_TRUE(aligned(p));
+  T_ASSERT_TRUE(aligned(q));
+  T_ASSERT_EQ(q, p + Arena::alignment);
+  memset(p, 'p', 3u);
+  memset(q, 'q', 5u);
+  T_ASSERT_EQ(p[2], 'p');
+  // only the last allocation can be given back
+  a.deallocate(p, 3u);
+  T_ASSERT_EQ(a.used(), Arena::alignment + 5u);
+  a.deallocate(q, 5u);
+  T_ASSERT_EQ(a.used(), Arena::alignment);
+  T_ASSERT_EQ(a.allocate(8u), q);
+  return true;
+}
+
+bool ArenaTest::TestGrowth() {
+  Arena a(64u);
+  for (uint32 i = 0u; i < 16u; i++) {
+    void *p = a.allocate(32u);
+    T_ASSERT_TRUE(p != NULL_PTR(void *));
+    T_ASSERT_TRUE(aligned(p));
+    memset(p, static_cast<int>(i), 32u);
+  }
+  T_ASSERT_EQ(a.capacity(), 8u * 64u);
+  // bigger requests get their own chunk
+  void *big = a.allocate(1000u);
+  T_ASSERT_TRUE(big != NULL_PTR(void *));
+  memset(big, 0, 1000u);
+  T_ASSERT_EQ(a.capacity(), 8u * 64u + 1000u);
+  return true;
+}
+
+bool ArenaTest::TestRewind() {
+  Arena a(64u);
+  void *first = a.allocate(16u);
+  const Arena::mark_t m = a.mark();
+  void *p = a.allocate(16u);
+  for (uint32 i = 0u; i < 10u; i++) {
+    (void)a.allocate(48u);
+  }
+  const uint32 capacity = a.capacity();
+  a.rewind(m);
+  T_ASSERT_EQ(a.used(), 16u);
+  // the same memory is given again, without new chunks
+  T_ASSERT_EQ(a.allocate(16u), p);
+  for (uint32 i = 0u; i < 10u; i++) {
+    (void)a.allocate(48u);
+  }
+  T_ASSERT_EQ(a.capacity(), capacity);
+  T_ASSERT_TRUE(first != p);
+  return true;
+}
+
+bool ArenaTest::TestReset() {
+  Arena a(64u);
+  void *first = a.allocate(8u);
+  for (uint32 i = 0u; i < 10u; i++) {
+    (void)a.allocate(40u);
+  }
+  const uint32 capacity = a.capacity();
+  a.reset();
+  T_ASSERT_EQ(a.used(), 0u);
+  T_ASSERT_EQ(a.allocate(8u), first);
+  // a chunk too small for the request is skipped, not freed
+  void *big = a.allocate(100u);
+  T_ASSERT_TRUE(big != NULL_PTR(void *));
+  T_ASSERT_EQ(a.capacity(), capacity + 100u);
+  a.reset();
+  T_ASSERT_EQ(a.allocate(8u), first);
+  T_ASSERT_EQ(a.capacity(), capacity + 100u);
+  // reserve a chunk in advance
+  Arena b(32u);
+  b.reserve(200u);
+  T_ASSERT_EQ(b.capacity(), 200u);
+  (void)b.allocate(200u);
+  T_ASSERT_EQ(b.capacity(), 200u);
+  return true;
+}
+
+bool ArenaTest::TestExternalBuffer() {
+  union {
+    char bytes[256];
+    double align_double_;
+  } buffer;
+  Arena a(buffer.bytes, sizeof(buffer.bytes));
+  T_ASSERT_TRUE(a.capacity() > 0u);
+  T_ASSERT_TRUE(a.capacity() < 256u);
+  char *p = static_cast<char *>(a.allocate(64u));
+  T_ASSERT_TRUE(p >= buffer.bytes && p + 64 <= buffer.bytes + 256);
+  T_ASSERT_TRUE(aligned(p));
+  // the arena never grows
+  T_ASSERT_TRUE(a.allocate(1024u) == NULL_PTR(void *));
+  while (a.allocate(16u) != NULL_PTR(void *)) {
+  }
+  T_ASSERT_TRUE(a.used() <= a.capacity());
+  a.reset();
+  T_ASSERT_EQ(a.allocate(64u), p);
+  // too small to hold anything
+  Arena b(buffer.bytes, 4u);
+  T_ASSERT_EQ(b.capacity(), 0u);
+  T_ASSERT_TRUE(b.allocate(1u) == NULL_PTR(void *));
+  return true;
+}
+
+bool ArenaTest::TestScope() {
+  Arena a(128u);
+  (void)a.allocate(10u);
+  const uint32 used = a.used();
+  void *p;
+  {
+    ArenaScope scope(a);
+    p = a.allocate(20u);
+    (void)a.allocate(500u);
+    T_ASSERT_TRUE(a.used() > used);
+  }
+  T_ASSERT_EQ(a.used(), used);
+  T_ASSERT_EQ(a.allocate(20u), p);
+  return true;
+}
+
+bool ArenaTest::TestContainers() {
+  Arena a(1024u);
+  {
+    Vec<Str> v(4u, &a);
+    for (uint32 i = 0u; i < 20u; i++) {
+      v.append(Str("a string stored in an arena", 27u, &a));
+    }
+    T_ASSERT_EQ(v.len(), 20u);
+    T_ASSERT_TRUE(v.allocator() == &a);
+    T_ASSERT_TRUE(v[19u].allocator() == &a);
+    T_ASSERT_TRUE(v[0u] == "a string stored in an arena");
+    T_ASSERT_TRUE(a.used() > 20u * 27u);
+    // copies come from the same arena
+    Vec<Str> w(v);
+    T_ASSERT_TRUE(w.allocator() == &a);
+    T_ASSERT_TRUE(w[3u].allocator() == &a);
+    T_ASSERT_TRUE(w == v);
+  }
+  a.reset();
+  T_ASSERT_EQ(a.used(), 0u);
+  return true;
+}
+
+bool ArenaTest::TestExhausted() {
+  union {
+    char bytes[512];
+    double align_double_;
+  } buffer;
+  Arena a(buffer.bytes, sizeof(buffer.bytes));
+  Vec<uint32> v(4u, &a);
+  Str s("0123456789", 10u, &a);
+  StrBuilder b(0u, &a);
+  Pool<uint64> p(4u, &a);
+  b.append("abcdefghijklmnopqrstu");
+  uint64 *item = p.create(7u);
+  T_ASSERT_TRUE(item != NULL_PTR(uint64 *));
+  while (a.allocate(8u) != NULL_PTR(void *)) {
+  }
+  // the containers are unchanged and report the failure
+  for (uint32 i = 0u; i < 4u; i++) {
+    T_ASSERT_TRUE(v.append(i));
+  }
+  T_ASSERT_FALSE(v.append(4u));
+  T_ASSERT_FALSE(v.reserve(100u));
+  T_ASSERT_EQ(v.len(), 4u);
+  T_ASSERT_EQ(v[3u], 3u);
+  T_ASSERT_FALSE(s.reserve(100u));
+  s.append("a string longer than the buffer of s");
+  T_ASSERT_TRUE(s == "0123456789");
+  b.append("a string longer than the buffer of b").append(-12345);
+  b.append(1.5, 3u).append_padded(7u, 40u);
+  b.append_json_escaped("\"quoted\" string longer than the buffer", 39u);
+  T_ASSERT_TRUE(b.view() == "abcdefghijklmnopqrstu");
+  for (uint32 i = 1u; i < 4u; i++) {
+    T_ASSERT_TRUE(p.create(i) != NULL_PTR(uint64 *));
+  }
+  T_ASSERT_TRUE(p.create(4u) == NULL_PTR(uint64 *));
+  T_ASSERT_FALSE(p.reserve(1u));
+  T_ASSERT_EQ(*item, 7u);
+  // without any buffer: empty, but still using the arena
+  Vec<uint32> w(4u, &a);
+  T_ASSERT_EQ(w.mem_size(), 0u);
+  T_ASSERT_FALSE(w.append(1u));
+  T_ASSERT_EQ(w.len(), 0u);
+  Str t("abc", 3u, &a);
+  T_ASSERT_EQ(t.len(), 0u);
+  T_ASSERT_EQ(t.capacity(), 0u);
+  T_ASSERT_TRUE(t.allocator() == &a);
+  T_ASSERT_TRUE(Str(t).allocator() == &a);
+  MpscRing<uint32> r(4u, false, &a);
+  T_ASSERT_EQ(r.capacity(), 0u);
+  T_ASSERT_FALSE(r.push(1u));
+  uint32 out = 0u;
+  T_ASSERT_FALSE(r.pop(out));
+  // usable again once memory is given back
+  a.reset();
+  t.append("abc");
+  T_ASSERT_TRUE(t == "abc");
+  T_ASSERT_TRUE(t.allocator() == &a);
+  T_ASSERT_TRUE(w.append(1u));
+  T_ASSERT_EQ(w.len(), 1u);
+  return true;
+}
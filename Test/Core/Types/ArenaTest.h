@@ -0,0 +1,20 @@
+#ifndef _ARENA_TEST_H__
+#define _ARENA_TEST_H__
+
+/**
+ @brief Tests arena allocator methods
+**/
+class ArenaTest {
+public:
+  bool TestConstructor();
+  bool TestAllocate();
+  bool TestGrowth();
+  bool TestRewind();
+  bool TestReset();
+  bool TestExternalBuffer();
+  bool TestScope();
+  bool TestContainers();
+  bool TestExhausted();
+};
+
+#endif
@@ -0,0 +1,42 @@
+#include "HashMapTest.h"
+#include "gtest/gtest.h"
+
+TEST(HashMap, TestConstructor) {
+  HashMapTest tester;
+  ASSERT_TRUE(tester.TestConstructor());
+}
+
+TEST(HashMap, TestSet) {
+  HashMapTest tester;
+  ASSERT_TRUE(tester.TestSet());
+}
+
+TEST(HashMap, TestFind) {
+  HashMapTest tester;
+  ASSERT_TRUE(tester.TestFind());
+}
+
+TEST(HashMap, TestRemove) {
+  HashMapTest tester;
+  ASSERT_TRUE(tester.TestRemove());
+}
+
+TEST(HashMap, TestGrowth) {
+  HashMapTest tester;
+  ASSERT_TRUE(tester.TestGrowth());
+}
+
+TEST(HashMap, TestStrKeys) {
+  HashMapTest tester;
+  ASSERT_TRUE(tester.TestStrKeys());
+}
+
+TEST(HashMap, TestIterator) {
+  HashMapTest tester;
+  ASSERT_TRUE(tester.TestIterator());
+}
+
+TEST(HashMap, TestCopy) {
+  HashMapTest tester;
+  ASSERT_TRUE(tester.TestCopy());
+}
@@ -0,0 +1,188 @@
+#include "HashMapTest.h"
+#include "HashMap.h"
+#include "Str.h"
+#include "StrView.h"
+#include "TestMacros.h"
+#include <stdio.h>
+
+using namespace MARTe;
+
+bool HashMapTest::TestConstructor() {
+  HashMap<uint32, uint32> a;
+  T_ASSERT_EQ(a.len(), 0u);
+  T_ASSERT_TRUE(a.empty());
+  T_ASSERT_EQ(a.capacity(), 0u);
+  T_ASSERT_FALSE(a.contains(1u));
+  T_ASSERT_EQ(a.get(1u), NULL_PTR(uint32 *));
+
+  HashMap<uint32, uint32> c;
+  c[5u] = 1u;
+  T_ASSERT_EQ(c.len(), 1u);
+  T_ASSERT_EQ(*c.get(5u), 1u);
+
+  HashMap<uint32, uint32> b(100u);
+  T_ASSERT_EQ(b.len(), 0u);
+  T_ASSERT_TRUE(b.capacity() >= 100u);
+  return true;
+}
+
+bool HashMapTest::TestSet() {
+  HashMap<int32, int32> a;
+  T_ASSERT_TRUE(a.set(1, 10));
+  T_ASSERT_TRUE(a.set(-2, 20));
+  T_ASSERT_EQ(a.len(), 2u);
+  T_ASSERT_FALSE(a.set(1, 11));
+  T_ASSERT_EQ(a.len(), 2u);
+  T_ASSERT_EQ(*a.get(1), 11);
+  T_ASSERT_EQ(*a.get(-2), 20);
+  a[3] = 30;
+  T_ASSERT_EQ(a.len(), 3u);
+  T_ASSERT_EQ(a[3], 30);
+  a[3] += 1;
+  T_ASSERT_EQ(*a.get(3), 31);
+  T_ASSERT_EQ(a[4], 0);
+  T_ASSERT_EQ(a.len(), 4u);
+  return true;
+}
+
+bool HashMapTest::TestFind() {
+  HashMap<uint32, uint32> a;
+  for (uint32 i = 0u; i < 100u; i++) {
+    a.set(i * 7u, i);
+  }
+  for (uint32 i = 0u; i < 100u; i++) {
+    Option<uint32> v = a.find(i * 7u);
+    T_ASSERT_FALSE(v.empty());
+    T_ASSERT_EQ(v.val(), i);
+    T_ASSERT_TRUE(a.contains(i * 7u));
+    T_ASSERT_FALSE(a.contains(i * 7u + 1u));
+  }
+  T_ASSERT_TRUE(a.find(701u).empty());
+  return true;
+}
+
+bool HashMapTest::TestRemove() {
+  HashMap<uint32, uint32> a;
+  for (uint32 i = 0u; i < 1000u; i++) {
+    a.set(i, i + 1u);
+  }
+  for (uint32 i = 0u; i < 1000u; i += 2u) {
+    T_ASSERT_TRUE(a.remove(i));
+  }
+  T_ASSERT_FALSE(a.remove(0u));
+  T_ASSERT_EQ(a.len(), 500u);
+  for (uint32 i = 0u; i < 1000u; i++) {
+    if (i % 2u == 0u) {
+      T_ASSERT_FALSE(a.contains(i));
+    } else {
+      T_ASSERT_EQ(*a.get(i), i + 1u);
+    }
+  }
+  a.clear();
+  T_ASSERT_EQ(a.len(), 0u);
+  T_ASSERT_FALSE(a.contains(1u));
+  T_ASSERT_TRUE(a.set(1u, 2u));
+  T_ASSERT_EQ(*a.get(1u), 2u);
+  return true;
+}
+
+bool HashMapTest::TestGrowth() {
+  HashMap<uint64, uint32> a;
+  a.reserve(1000u);
+  const uint32 slots = a.capacity();
+  T_ASSERT_TRUE(slots >= 1000u);
+  for (uint32 i = 0u; i < 1000u; i++) {
+    a.set(static_cast<uint64>(i) << 32u, i);
+  }
+  // reserved: no rehash
+  T_ASSERT_EQ(a.capacity(), slots);
+  for (uint32 i = 1000u; i < 10000u; i++) {
+    a.set(static_cast<uint64>(i) << 32u, i);
+  }
+  T_ASSERT_EQ(a.len(), 10000u);
+  T_ASSERT_TRUE(a.capacity() * 7u >= a.len() * 8u);
+  for (uint32 i = 0u; i < 10000u; i++) {
+    T_ASSERT_EQ(*a.get(static_cast<uint64>(i) << 32u), i);
+  }
+  a.rehash(0u);
+  T_ASSERT_TRUE(a.capacity() < 2u * 16384u);
+  T_ASSERT_EQ(*a.get(static_cast<uint64>(9999u) << 32u), 9999u);
+  return true;
+}
+
+bool HashMapTest::TestStrKeys() {
+  HashMap<Str, uint32> a;
+  a.set("alpha", 1u);
+  a.set("beta", 2u);
+  a.set("a long key that does not fit in the inline buffer", 3u);
+  T_ASSERT_EQ(*a.get("alpha"), 1u);
+  T_ASSERT_EQ(*a.get("beta"), 2u);
+  T_ASSERT_EQ(*a.get("a long key that does not fit in the inline buffer"),
+              3u);
+  T_ASSERT_FALSE(a.contains("gamma"));
+  for (uint32 i = 0u; i < 200u; i++) {
+    char8 key[16];
+    snprintf(key, sizeof(key), "key_%u", i);
+    a.set(key, i);
+  }
+  T_ASSERT_EQ(*a.get("key_199"), 199u);
+  T_ASSERT_TRUE(a.remove("alpha"));
+  T_ASSERT_FALSE(a.contains("alpha"));
+
+  // views of strings owned by the caller
+  const char8 *code = "local x = y";
+  HashMap<StrView, uint32> b;
+  b.set(StrView(code, 5u), 0u);
+  b.set(StrView(code + 6, 1u), 6u);
+  b.set(StrView(code + 10, 1u), 10u);
+  T_ASSERT_EQ(*b.get("local"), 0u);
+  T_ASSERT_EQ(*b.get("x"), 6u);
+  T_ASSERT_EQ(*b.get("y"), 10u);
+  T_ASSERT_FALSE(b.contains("z"));
+  return true;
+}
+
+bool HashMapTest::TestIterator() {
+  HashMap<uint32, uint32> a;
+  T_ASSERT_TRUE(a.begin() == a.end());
+  uint32 keys = 0u;
+  for (uint32 i = 1u; i <= 100u; i++) {
+    a.set(i, i * 2u);
+    keys += i;
+  }
+  uint32 n = 0u;
+  uint32 sum = 0u;
+  for (HashMap<uint32, uint32>::iterator it = a.begin(); it != a.end();
+       ++it) {
+    T_ASSERT_EQ(it.value(), it.key() * 2u);
+    sum += it.key();
+    n++;
+  }
+  T_ASSERT_EQ(n, 100u);
+  T_ASSERT_EQ(sum, keys);
+  return true;
+}
+
+bool HashMapTest::TestCopy() {
+  HashMap<Str, Str> a;
+  a.set("one", "1");
+  a.set("two", "2");
+  HashMap<Str, Str> b(a);
+  T_ASSERT_EQ(b.len(), 2u);
+  b.set("one", "uno");
+  T_ASSERT_TRUE(*a.get("one") == "1");
+  T_ASSERT_TRUE(*b.get("one") == "uno");
+  HashMap<Str, Str> c;
+  c = b;
+  T_ASSERT_TRUE(*c.get("two") == "2");
+  c = c;
+  T_ASSERT_EQ(c.len(), 2u);
+  // value aliasing an entry of the table
+  for (uint32 i = 0u; i < 100u; i++) {
+    char8 key[16];
+    snprintf(key, sizeof(key), "k%u", i);
+    c.set(key, *c.get("one"));
+  }
+  T_ASSERT_TRUE(*c.get("k99") == "uno");
+  return true;
+}
@@ -0,0 +1,19 @@
+#ifndef _HASH_MAP_TEST_H__
+#define _HASH_MAP_TEST_H__
+
+/**
+ @brief Tests open addressing hash map methods
+**/
+class HashMapTest {
+public:
+  bool TestConstructor();
+  bool TestSet();
+  bool TestFind();
+  bool TestRemove();
+  bool TestGrowth();
+  bool TestStrKeys();
+  bool TestIterator();
+  bool TestCopy();
+};
+
+#endif
@@ -0,0 +1,32 @@
+#include "MpscRingTest.h"
+#include "gtest/gtest.h"
+
+TEST(MpscRing, TestPushPop) {
+  MpscRingTest tester;
+  ASSERT_TRUE(tester.TestPushPop());
+}
+
+TEST(MpscRing, TestFull) {
+  MpscRingTest tester;
+  ASSERT_TRUE(tester.TestFull());
+}
+
+TEST(MpscRing, TestBatch) {
+  MpscRingTest tester;
+  ASSERT_TRUE(tester.TestBatch());
+}
+
+TEST(MpscRing, TestNonTrivial) {
+  MpscRingTest tester;
+  ASSERT_TRUE(tester.TestNonTrivial());
+}
+
+TEST(MpscRing, TestConcurrent) {
+  MpscRingTest tester;
+  ASSERT_TRUE(tester.TestConcurrent());
+}
+
+TEST(MpscRing, TestWait) {
+  MpscRingTest tester;
+  ASSERT_TRUE(tester.TestWait());
+}
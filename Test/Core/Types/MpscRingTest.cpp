@@ -0,0 +1,204 @@
+#include "MpscRingTest.h"
+#include "Arena.h"
+#include "MpscRing.h"
+#include "Str.h"
+#include "TestMacros.h"
+#include <pthread.h>
+#include <sched.h>
+
+using namespace MARTe;
+
+#define MPSC_TEST_PRODUCERS 4u
+#define MPSC_TEST_ITEMS 50000u
+
+namespace {
+
+struct counted_t {
+  static int32 alive;
+  uint32 value;
+  counted_t() : value(0u) { alive++; }
+  counted_t(const uint32 v) : value(v) { alive++; }
+  counted_t(const counted_t &other) : value(other.value) { alive++; }
+  ~counted_t() { alive--; }
+};
+
+int32 counted_t::alive = 0;
+
+typedef MpscRing<uint32> ring_t;
+
+struct producer_t {
+  ring_t *ring;
+  uint32 id;
+  bool batched;
+};
+
+// the producer id in the high bits, the sequence number in the low ones
+void *produce(void *arg) {
+  producer_t *p = static_cast<producer_t *>(arg);
+  uint32 next = 0u;
+  while (next < MPSC_TEST_ITEMS) {
+    if (p->batched) {
+      uint32 items[8];
+      uint32 n = MPSC_TEST_ITEMS - next < 8u ? MPSC_TEST_ITEMS - next : 8u;
+      for (uint32 i = 0u; i < n; i++) {
+        items[i] = (p->id << 24u) | (next + i);
+      }
+      n = p->ring->push(items, n);
+      next += n;
+      if (n == 0u) {
+        sched_yield();
+      }
+    } else if (p->ring->push((p->id << 24u) | next)) {
+      next++;
+    } else {
+      sched_yield();
+    }
+  }
+  return NULL_PTR(void *);
+}
+
+/**
+ @brief run the producers and pop all the items, checking the order of
+ the items of each producer.
+**/
+bool run(const bool batched, const bool wait) {
+  ring_t ring(64u, wait);
+  pthread_t threads[MPSC_TEST_PRODUCERS];
+  producer_t producers[MPSC_TEST_PRODUCERS];
+  for (uint32 i = 0u; i < MPSC_TEST_PRODUCERS; i++) {
+    producers[i].ring = &ring;
+    producers[i].id = i;
+    producers[i].batched = batched;
+    pthread_create(&threads[i], NULL_PTR(const pthread_attr_t *), produce,
+                   &producers[i]);
+  }
+  uint32 expected[MPSC_TEST_PRODUCERS] = {0u};
+  uint32 total = 0u;
+  bool ok = true;
+  while (total < MPSC_TEST_PRODUCERS * MPSC_TEST_ITEMS) {
+    uint32 items[16];
+    const uint32 n =
+        wait ? ring.pop_wait(items, 16u, 100000u) : ring.pop(items, 16u);
+    for (uint32 i = 0u; i < n; i++) {
+      const uint32 id = items[i] >> 24u;
+      if (id >= MPSC_TEST_PRODUCERS ||
+          (items[i] & 0xFFFFFFu) != expected[id]) {
+        ok = false;
+      } else {
+        expected[id]++;
+      }
+    }
+    total += n;
+    if (n == 0u && !wait) {
+      sched_yield();
+    }
+  }
+  for (uint32 i = 0u; i < MPSC_TEST_PRODUCERS; i++) {
+    pthread_join(threads[i], NULL_PTR(void **));
+  }
+  return ok && ring.empty();
+}
+
+} // namespace
+
+bool MpscRingTest::TestPushPop() {
+  MpscRing<int32> ring(3u);
+  // rounded up to a power of 2
+  T_ASSERT_EQ(ring.capacity(), 4u);
+  T_ASSERT_TRUE(ring.empty());
+  int32 v = 0;
+  T_ASSERT_FALSE(ring.pop(v));
+  for (int32 i = 0; i < 100; i++) {
+    T_ASSERT_TRUE(ring.push(i));
+    T_ASSERT_TRUE(ring.push(-i));
+    T_ASSERT_EQ(ring.len(), 2u);
+    T_ASSERT_TRUE(ring.pop(v));
+    T_ASSERT_EQ(v, i);
+    T_ASSERT_TRUE(ring.pop(v));
+    T_ASSERT_EQ(v, -i);
+  }
+  T_ASSERT_TRUE(ring.empty());
+  return true;
+}
+
+bool MpscRingTest::TestFull() {
+  MpscRing<uint32> ring(8u);
+  for (uint32 i = 0u; i < 8u; i++) {
+    T_ASSERT_TRUE(ring.push(i));
+  }
+  T_ASSERT_FALSE(ring.push(8u));
+  uint32 v;
+  T_ASSERT_TRUE(ring.pop(v));
+  T_ASSERT_EQ(v, 0u);
+  T_ASSERT_TRUE(ring.push(8u));
+  T_ASSERT_FALSE(ring.push(9u));
+  for (uint32 i = 1u; i <= 8u; i++) {
+    T_ASSERT_TRUE(ring.pop(v));
+    T_ASSERT_EQ(v, i);
+  }
+  T_ASSERT_FALSE(ring.pop(v));
+  return true;
+}
+
+bool MpscRingTest::TestBatch() {
+  Arena arena(1024u);
+  MpscRing<uint32> ring(8u, false, &arena);
+  T_ASSERT_TRUE(arena.used() >= 8u * sizeof(uint32));
+  uint32 in[12];
+  uint32 out[12];
+  for (uint32 i = 0u; i < 12u; i++) {
+    in[i] = i * 10u;
+  }
+  T_ASSERT_EQ(ring.push(in, 5u), 5u);
+  T_ASSERT_EQ(ring.push(in + 5u, 7u), 3u);
+  T_ASSERT_EQ(ring.push(in, 1u), 0u);
+  T_ASSERT_EQ(ring.pop(out, 3u), 3u);
+  T_ASSERT_EQ(ring.push(in + 8u, 4u), 3u);
+  T_ASSERT_EQ(ring.pop(out + 3u, 12u), 8u);
+  for (uint32 i = 0u; i < 11u; i++) {
+    T_ASSERT_EQ(out[i], in[i]);
+  }
+  T_ASSERT_EQ(ring.pop(out, 12u), 0u);
+  return true;
+}
+
+bool MpscRingTest::TestNonTrivial() {
+  {
+    MpscRing<Str> ring(4u);
+    T_ASSERT_TRUE(ring.push(Str("a string longer than the inline buffer")));
+    Str s;
+    T_ASSERT_TRUE(ring.pop(s));
+    T_ASSERT_TRUE(s == "a string longer than the inline buffer");
+    T_ASSERT_TRUE(ring.push(Str("left in the ring, destroyed with it")));
+  }
+  {
+    MpscRing<counted_t> ring(4u);
+    T_ASSERT_TRUE(ring.push(counted_t(1u)));
+    T_ASSERT_TRUE(ring.push(counted_t(2u)));
+    T_ASSERT_EQ(counted_t::alive, 2);
+    counted_t c;
+    T_ASSERT_TRUE(ring.pop(c));
+    T_ASSERT_EQ(c.value, 1u);
+    T_ASSERT_EQ(counted_t::alive, 2);
+  }
+  T_ASSERT_EQ(counted_t::alive, 0);
+  return true;
+}
+
+bool MpscRingTest::TestConcurrent() {
+  T_ASSERT_TRUE(run(false, false));
+  T_ASSERT_TRUE(run(true, false));
+  return true;
+}
+
+bool MpscRingTest::TestWait() {
+  MpscRing<uint32> ring(4u, true);
+  uint32 v;
+  T_ASSERT_FALSE(ring.pop_wait(v, 1000u));
+  T_ASSERT_TRUE(ring.push(3u));
+  T_ASSERT_TRUE(ring.pop_wait(v, 1000u));
+  T_ASSERT_EQ(v, 3u);
+  T_ASSERT_TRUE(run(false, true));
+  T_ASSERT_TRUE(run(true, true));
+  return true;
+}
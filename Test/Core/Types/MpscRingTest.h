@@ -0,0 +1,17 @@
+#ifndef _MPSC_RING_TEST_H__
+#define _MPSC_RING_TEST_H__
+
+/**
+ @brief Tests multiple producers single consumer ring methods
+**/
+class MpscRingTest {
+public:
+  bool TestPushPop();
+  bool TestFull();
+  bool TestBatch();
+  bool TestNonTrivial();
+  bool TestConcurrent();
+  bool TestWait();
+};
+
+#endif
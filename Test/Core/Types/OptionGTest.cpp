@@ -20,3 +20,8 @@ TEST(optional, maybe) {
   OptionTest tester;
   ASSERT_TRUE(tester.TestMaybe());
 }
+
+TEST(optional, lifetime) {
+  OptionTest tester;
+  ASSERT_TRUE(tester.TestLifetime());
+}
@@ -74,3 +74,34 @@ bool OptionTest::TestMaybe() {
   T_ASSERT_EQ(y.val(), fact(x.val()));
   return true;
 }
+
+namespace {
+int alive = 0;
+
+struct counted_t {
+  int v;
+  counted_t(int x) : v(x) { alive++; }
+  counted_t(const counted_t &o) : v(o.v) { alive++; }
+  ~counted_t() { alive--; }
+};
+} // namespace
+
+bool OptionTest::TestLifetime() {
+  {
+    MARTe::Option<counted_t> a;
+    T_ASSERT_EQ(alive, 0);
+    a = counted_t(1);
+    T_ASSERT_EQ(alive, 1);
+    MARTe::Option<counted_t> b(a);
+    T_ASSERT_EQ(alive, 2);
+    T_ASSERT_EQ(b.val().v, 1);
+    b = MARTe::Option<counted_t>();
+    T_ASSERT_EQ(alive, 1);
+    b = a;
+    b = b;
+    T_ASSERT_EQ(alive, 2);
+    T_ASSERT_EQ(b.val().v, 1);
+  }
+  T_ASSERT_EQ(alive, 0);
+  return true;
+}
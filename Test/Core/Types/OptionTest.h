@@ -7,6 +7,7 @@ public:
   bool TestOperators();
   bool TestAssign();
   bool TestMaybe();
+  bool TestLifetime();
 };
 
 #endif
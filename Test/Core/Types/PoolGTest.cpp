@@ -0,0 +1,27 @@
+#include "PoolTest.h"
+#include "gtest/gtest.h"
+
+TEST(Pool, TestAlloc) {
+  PoolTest tester;
+  ASSERT_TRUE(tester.TestAlloc());
+}
+
+TEST(Pool, TestReuse) {
+  PoolTest tester;
+  ASSERT_TRUE(tester.TestReuse());
+}
+
+TEST(Pool, TestReserve) {
+  PoolTest tester;
+  ASSERT_TRUE(tester.TestReserve());
+}
+
+TEST(Pool, TestCreate) {
+  PoolTest tester;
+  ASSERT_TRUE(tester.TestCreate());
+}
+
+TEST(Pool, TestAllocator) {
+  PoolTest tester;
+  ASSERT_TRUE(tester.TestAllocator());
+}
@@ -0,0 +1,116 @@
+#include "PoolTest.h"
+#include "Arena.h"
+#include "Pool.h"
+#include "TestMacros.h"
+
+using namespace MARTe;
+
+namespace {
+struct pooled_t {
+  static int32 alive;
+  int32 x;
+  int32 y;
+  pooled_t() : x(0), y(0) { alive++; }
+  pooled_t(int32 x_, int32 y_) : x(x_), y(y_) { alive++; }
+  ~pooled_t() { alive--; }
+};
+
+int32 pooled_t::alive = 0;
+} // namespace
+
+bool PoolTest::TestAlloc() {
+  Pool<uint64> pool(4u);
+  T_ASSERT_EQ(pool.capacity(), 0u);
+  uint64 *items[10];
+  for (uint32 i = 0u; i < 10u; i++) {
+    items[i] = pool.alloc();
+    *items[i] = i;
+  }
+  T_ASSERT_EQ(pool.capacity(), 12u);
+  T_ASSERT_EQ(pool.available(), 2u);
+  for (uint32 i = 0u; i < 10u; i++) {
+    T_ASSERT_EQ(*items[i], i);
+    for (uint32 j = 0u; j < i; j++) {
+      T_ASSERT_TRUE(items[i] != items[j]);
+    }
+  }
+  for (uint32 i = 0u; i < 10u; i++) {
+    pool.free(items[i]);
+  }
+  T_ASSERT_EQ(pool.available(), 12u);
+  pool.free(NULL_PTR(uint64 *));
+  T_ASSERT_EQ(pool.available(), 12u);
+  return true;
+}
+
+bool PoolTest::TestReuse() {
+  Pool<int32> pool(8u);
+  int32 *a = pool.alloc();
+  int32 *b = pool.alloc();
+  pool.free(a);
+  // last freed, first reused
+  T_ASSERT_EQ(pool.alloc(), a);
+  pool.free(b);
+  pool.free(a);
+  T_ASSERT_EQ(pool.alloc(), a);
+  T_ASSERT_EQ(pool.alloc(), b);
+  T_ASSERT_EQ(pool.capacity(), 8u);
+  return true;
+}
+
+bool PoolTest::TestReserve() {
+  Pool<int32> pool(4u);
+  pool.reserve(50u);
+  T_ASSERT_EQ(pool.capacity(), 50u);
+  T_ASSERT_EQ(pool.available(), 50u);
+  for (uint32 i = 0u; i < 50u; i++) {
+    (void)pool.alloc();
+  }
+  // no growth within the reserved capacity
+  T_ASSERT_EQ(pool.capacity(), 50u);
+  T_ASSERT_EQ(pool.available(), 0u);
+  pool.reserve(3u);
+  T_ASSERT_EQ(pool.capacity(), 53u);
+  pool.reserve(1u);
+  T_ASSERT_EQ(pool.capacity(), 53u);
+  return true;
+}
+
+bool PoolTest::TestCreate() {
+  {
+    Pool<pooled_t> pool;
+    pooled_t *a = pool.create();
+    pooled_t *b = pool.create(3, 4);
+    T_ASSERT_EQ(pooled_t::alive, 2);
+    T_ASSERT_EQ(a->x, 0);
+    T_ASSERT_EQ(b->x, 3);
+    T_ASSERT_EQ(b->y, 4);
+    pool.destroy(a);
+    T_ASSERT_EQ(pooled_t::alive, 1);
+    pooled_t *c = pool.create(5, 6);
+    T_ASSERT_EQ(c, a);
+    pool.destroy(b);
+    pool.destroy(c);
+    pool.destroy(NULL_PTR(pooled_t *));
+    T_ASSERT_EQ(pooled_t::alive, 0);
+  }
+  return true;
+}
+
+bool PoolTest::TestAllocator() {
+  Arena arena(1024u);
+  {
+    Pool<pooled_t> pool(16u, &arena);
+    pooled_t *items[40];
+    for (int32 i = 0; i < 40; i++) {
+      items[i] = pool.create(i, -i);
+    }
+    T_ASSERT_TRUE(arena.used() >= 40u * sizeof(pooled_t));
+    for (int32 i = 0; i < 40; i++) {
+      T_ASSERT_EQ(items[i]->x, i);
+      pool.destroy(items[i]);
+    }
+    T_ASSERT_EQ(pooled_t::alive, 0);
+  }
+  return true;
+}
@@ -0,0 +1,16 @@
+#ifndef _POOL_TEST_H__
+#define _POOL_TEST_H__
+
+/**
+ @brief Tests object pool methods
+**/
+class PoolTest {
+public:
+  bool TestAlloc();
+  bool TestReuse();
+  bool TestReserve();
+  bool TestCreate();
+  bool TestAllocator();
+};
+
+#endif
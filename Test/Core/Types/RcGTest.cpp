@@ -35,3 +35,13 @@ TEST(Ptr, WeakReferences) {
   PtrTest tester;
   ASSERT_TRUE(tester.TestWeakReferences());
 }
+
+TEST(Ptr, MakeRc) {
+  PtrTest tester;
+  ASSERT_TRUE(tester.TestMakeRc());
+}
+
+TEST(Ptr, ControlBlock) {
+  PtrTest tester;
+  ASSERT_TRUE(tester.TestControlBlock());
+}
@@ -180,3 +180,74 @@ bool PtrTest::TestWeakReferences() {
   T_ASSERT_TRUE(c.isNull())
   return true;
 }
+
+struct counted_t {
+  static int alive;
+  int x;
+  int y;
+  counted_t() : x(0), y(0) { alive++; }
+  counted_t(int x_, int y_) : x(x_), y(y_) { alive++; }
+  counted_t(const counted_t &other) : x(other.x), y(other.y) { alive++; }
+  ~counted_t() { alive--; }
+};
+
+int counted_t::alive = 0;
+
+bool PtrTest::TestMakeRc() {
+  {
+    Rc<counted_t> a = make_rc<counted_t>(1, 2);
+    T_ASSERT_FALSE(a.isNull());
+    T_ASSERT_EQ(a->x, 1);
+    T_ASSERT_EQ(a->y, 2);
+    T_ASSERT_EQ(counted_t::alive, 1);
+    T_ASSERT_EQ(a.referencesCount(), 1u);
+    Rc<counted_t> b = make_rc<counted_t>();
+    T_ASSERT_EQ(b->x, 0);
+    T_ASSERT_EQ(counted_t::alive, 2);
+    b = a;
+    T_ASSERT_EQ(counted_t::alive, 1);
+    T_ASSERT_EQ(a.referencesCount(), 2u);
+    T_ASSERT_TRUE(a.same(b));
+    Rc<counted_t> c(counted_t(3, 4));
+    T_ASSERT_EQ(c->y, 4);
+    T_ASSERT_EQ(counted_t::alive, 2);
+  }
+  T_ASSERT_EQ(counted_t::alive, 0);
+  return true;
+}
+
+bool PtrTest::TestControlBlock() {
+  Rc<counted_t> weak;
+  {
+    Rc<counted_t> a = make_rc<counted_t>(5, 6);
+    weak = ~a;
+    Rc<counted_t> weak_copy(weak);
+    T_ASSERT_EQ(a.referencesCount(), 1u);
+    T_ASSERT_EQ(a.weakReferencesCount(), 2u);
+    Rc<counted_t> hard = +weak;
+    T_ASSERT_FALSE(hard.isWeak());
+    T_ASSERT_EQ(a.referencesCount(), 2u);
+    T_ASSERT_EQ(hard->x, 5);
+  }
+  // the object is gone, the counters are kept alive by the weak pointer
+  T_ASSERT_EQ(counted_t::alive, 0);
+  T_ASSERT_TRUE(weak.isNull());
+  T_ASSERT_TRUE(weak.isWeak());
+  T_ASSERT_EQ(weak.referencesCount(), 0u);
+  Rc<counted_t> hard = +weak;
+  T_ASSERT_TRUE(hard.isNull());
+  weak.del();
+  T_ASSERT_TRUE(weak.isNull());
+
+  // external pointer
+  {
+    Rc<counted_t> a(new counted_t(7, 8));
+    Rc<counted_t> b = ~a;
+    T_ASSERT_EQ(counted_t::alive, 1);
+    a.del();
+    T_ASSERT_EQ(counted_t::alive, 0);
+    T_ASSERT_TRUE(b.isNull());
+  }
+  T_ASSERT_EQ(counted_t::alive, 0);
+  return true;
+}
@@ -10,6 +10,8 @@ public:
 	bool TestOperators();
 	bool TestReferenceCycle();
 	bool TestWeakReferences();
+	bool TestMakeRc();
+	bool TestControlBlock();
 };
 
 #endif
@@ -17,3 +17,8 @@ TEST(Result, Operators) {
   ResultTest tester;
   ASSERT_TRUE(tester.TestOperators());
 }
+
+TEST(Result, Lifetime) {
+  ResultTest tester;
+  ASSERT_TRUE(tester.TestLifetime());
+}
@@ -57,3 +57,37 @@ bool ResultTest::TestOperators() {
   T_ASSERT_EQ(x.val(), 50);
   return true;
 }
+
+namespace {
+int alive = 0;
+
+struct counted_t {
+  int v;
+  counted_t(int x) : v(x) { alive++; }
+  counted_t(const counted_t &o) : v(o.v) { alive++; }
+  ~counted_t() { alive--; }
+};
+} // namespace
+
+bool ResultTest::TestLifetime() {
+  {
+    Result<counted_t, counted_t> a = Result<counted_t, counted_t>::Succ(1);
+    T_ASSERT_EQ(alive, 1);
+    Result<counted_t, counted_t> b =
+        Result<counted_t, counted_t>::Fail(counted_t(2));
+    T_ASSERT_EQ(alive, 2);
+    T_ASSERT_EQ(b.err().v, 2);
+    b = a;
+    T_ASSERT_EQ(alive, 2);
+    T_ASSERT_TRUE(b.succeded());
+    T_ASSERT_EQ(b.val().v, 1);
+    Result<counted_t, int> c = Result<counted_t, int>::Fail(3);
+    T_ASSERT_EQ(alive, 2);
+    c = Result<counted_t, int>::Succ(4);
+    T_ASSERT_EQ(alive, 3);
+    c = Result<counted_t, int>::Fail(5);
+    T_ASSERT_EQ(alive, 2);
+  }
+  T_ASSERT_EQ(alive, 0);
+  return true;
+}
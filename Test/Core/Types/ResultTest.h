@@ -6,6 +6,7 @@ public:
  bool TestConstructor();
  bool TestSucceded();
  bool TestOperators(); 
+ bool TestLifetime();
 };
 
 #endif 
@@ -0,0 +1,27 @@
+#include "SmallVecTest.h"
+#include "gtest/gtest.h"
+
+TEST(SmallVec, TestConstructor) {
+  SmallVecTest tester;
+  ASSERT_TRUE(tester.TestConstructor());
+}
+
+TEST(SmallVec, TestInline) {
+  SmallVecTest tester;
+  ASSERT_TRUE(tester.TestInline());
+}
+
+TEST(SmallVec, TestSpill) {
+  SmallVecTest tester;
+  ASSERT_TRUE(tester.TestSpill());
+}
+
+TEST(SmallVec, TestCopy) {
+  SmallVecTest tester;
+  ASSERT_TRUE(tester.TestCopy());
+}
+
+TEST(SmallVec, TestNonTrivial) {
+  SmallVecTest tester;
+  ASSERT_TRUE(tester.TestNonTrivial());
+}
@@ -0,0 +1,128 @@
+#include "SmallVecTest.h"
+#include "SmallVec.h"
+#include "Str.h"
+#include "TestMacros.h"
+
+bool SmallVecTest::TestConstructor() {
+  MARTe::SmallVec<int, 4> a;
+  T_ASSERT_EQ(a.len(), 0);
+  T_ASSERT_EQ(a.mem_size(), 4);
+
+  int array[] = {1, 2, 3};
+  MARTe::SmallVec<int, 4> b(array, 3);
+  T_ASSERT_EQ(b.len(), 3);
+  T_ASSERT_EQ(b.mem_size(), 4);
+  for (MARTe::uint32 i = 0; i < b.len(); i++) {
+    T_ASSERT_EQ(b[i], array[i]);
+  }
+
+  MARTe::Vec<int> c(array, 3);
+  MARTe::SmallVec<int, 4> d(c);
+  T_ASSERT_TRUE(c == d);
+  T_ASSERT_EQ(d.mem_size(), 4);
+  return true;
+}
+
+bool SmallVecTest::TestInline() {
+  MARTe::SmallVec<int, 4> a;
+  const int *inline_buffer = a.emplace();
+  a.clear();
+  for (MARTe::uint32 i = 0; i < 4; i++) {
+    a += i;
+  }
+  // no allocation up to N elements
+  T_ASSERT_EQ(&a[0], inline_buffer);
+  T_ASSERT_EQ(a.mem_size(), 4);
+  T_ASSERT_TRUE(a.remove(0));
+  T_ASSERT_EQ(a[0], 1);
+  T_ASSERT_EQ(a.len(), 3);
+  a.reduce();
+  T_ASSERT_EQ(&a[0], inline_buffer);
+  // usable as a Vec
+  MARTe::Vec<int> &v = a;
+  v.append(10);
+  T_ASSERT_EQ(v.len(), 4);
+  T_ASSERT_EQ(a[-1], 10);
+  T_ASSERT_TRUE(a.contains(10));
+  int sum = 0;
+  for (MARTe::Vec<int>::iterator it = a.begin(); it != a.end(); ++it) {
+    sum += *it;
+  }
+  T_ASSERT_EQ(sum, 16);
+  return true;
+}
+
+bool SmallVecTest::TestSpill() {
+  MARTe::SmallVec<int, 4> a;
+  for (MARTe::uint32 i = 0; i < 100; i++) {
+    a += i;
+  }
+  T_ASSERT_EQ(a.len(), 100);
+  T_ASSERT_GTE(a.mem_size(), 100);
+  for (MARTe::uint32 i = 0; i < 100; i++) {
+    T_ASSERT_EQ(a[i], (int)i);
+  }
+  a.clear();
+  a += 1;
+  a.reduce();
+  T_ASSERT_EQ(a.len(), 1);
+  T_ASSERT_EQ(a[0], 1);
+  return true;
+}
+
+bool SmallVecTest::TestCopy() {
+  MARTe::SmallVec<int, 2> a;
+  a += 1;
+  MARTe::SmallVec<int, 2> b(a);
+  T_ASSERT_TRUE(a == b);
+  T_ASSERT_TRUE(&a[0] != &b[0]);
+  b += 2;
+  b += 3;
+  T_ASSERT_EQ(b.len(), 3);
+  T_ASSERT_EQ(a.len(), 1);
+  a = b;
+  T_ASSERT_TRUE(a == b);
+  b = a;
+  T_ASSERT_TRUE(a == b);
+  MARTe::SmallVec<int, 2> c;
+  c += 7;
+  a = c;
+  T_ASSERT_EQ(a.len(), 1);
+  T_ASSERT_EQ(a[0], 7);
+  MARTe::Vec<int> d(b);
+  T_ASSERT_TRUE(d == b);
+#if __cplusplus >= 201103L
+  // inline elements are moved, heap buffers are stolen
+  MARTe::SmallVec<int, 2> e(static_cast<MARTe::SmallVec<int, 2> &&>(c));
+  T_ASSERT_EQ(e.len(), 1);
+  T_ASSERT_EQ(e[0], 7);
+  T_ASSERT_EQ(c.len(), 0);
+  const int *heap = &b[0];
+  e = static_cast<MARTe::SmallVec<int, 2> &&>(b);
+  T_ASSERT_EQ(e.len(), 3);
+  T_ASSERT_EQ(&e[0], heap);
+#endif
+  return true;
+}
+
+bool SmallVecTest::TestNonTrivial() {
+  MARTe::SmallVec<MARTe::Str, 2> a;
+  a.append(MARTe::Str("first"));
+  a.append(a[0]);
+  T_ASSERT_EQ(a.len(), 2);
+  a.append(MARTe::Str("third"));
+  T_ASSERT_EQ(a.len(), 3);
+  T_ASSERT_TRUE(a[0] == "first");
+  T_ASSERT_TRUE(a[1] == "first");
+  T_ASSERT_TRUE(a[2] == "third");
+  MARTe::SmallVec<MARTe::Str, 2> b(a);
+  T_ASSERT_TRUE(a == b);
+  T_ASSERT_TRUE(b.remove(0));
+  T_ASSERT_TRUE(b.remove(0));
+  T_ASSERT_TRUE(b[0] == "third");
+  b = a;
+  T_ASSERT_EQ(b.len(), 3);
+  b.clear();
+  T_ASSERT_EQ(b.len(), 0);
+  return true;
+}
@@ -0,0 +1,16 @@
+#ifndef _SMALL_VEC_TEST_H__
+#define _SMALL_VEC_TEST_H__
+
+/**
+ @brief Tests small array methods
+**/
+class SmallVecTest {
+public:
+  bool TestConstructor();
+  bool TestInline();
+  bool TestSpill();
+  bool TestCopy();
+  bool TestNonTrivial();
+};
+
+#endif
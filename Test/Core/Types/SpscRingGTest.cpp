@@ -0,0 +1,32 @@
+#include "SpscRingTest.h"
+#include "gtest/gtest.h"
+
+TEST(SpscRing, TestPushPop) {
+  SpscRingTest tester;
+  ASSERT_TRUE(tester.TestPushPop());
+}
+
+TEST(SpscRing, TestFull) {
+  SpscRingTest tester;
+  ASSERT_TRUE(tester.TestFull());
+}
+
+TEST(SpscRing, TestBatch) {
+  SpscRingTest tester;
+  ASSERT_TRUE(tester.TestBatch());
+}
+
+TEST(SpscRing, TestNonTrivial) {
+  SpscRingTest tester;
+  ASSERT_TRUE(tester.TestNonTrivial());
+}
+
+TEST(SpscRing, TestConcurrent) {
+  SpscRingTest tester;
+  ASSERT_TRUE(tester.TestConcurrent());
+}
+
+TEST(SpscRing, TestWait) {
+  SpscRingTest tester;
+  ASSERT_TRUE(tester.TestWait());
+}
@@ -0,0 +1,198 @@
+#include "SpscRingTest.h"
+#include "SpscRing.h"
+#include "Str.h"
+#include "TestMacros.h"
+#include <pthread.h>
+#include <sched.h>
+
+using namespace MARTe;
+
+#define SPSC_TEST_ITEMS 200000u
+
+namespace {
+
+struct counted_t {
+  static int32 alive;
+  uint32 value;
+  counted_t() : value(0u) { alive++; }
+  counted_t(const uint32 v) : value(v) { alive++; }
+  counted_t(const counted_t &other) : value(other.value) { alive++; }
+  ~counted_t() { alive--; }
+};
+
+int32 counted_t::alive = 0;
+
+typedef SpscRing<uint32, 64u> ring_t;
+
+struct producer_t {
+  ring_t *ring;
+  bool batched;
+};
+
+void *produce(void *arg) {
+  producer_t *p = static_cast<producer_t *>(arg);
+  uint32 next = 0u;
+  while (next < SPSC_TEST_ITEMS) {
+    if (p->batched) {
+      uint32 items[16];
+      uint32 n = SPSC_TEST_ITEMS - next < 16u ? SPSC_TEST_ITEMS - next : 16u;
+      for (uint32 i = 0u; i < n; i++) {
+        items[i] = next + i;
+      }
+      n = p->ring->push(items, n);
+      next += n;
+      if (n == 0u) {
+        sched_yield();
+      }
+    } else if (p->ring->push(next)) {
+      next++;
+    } else {
+      sched_yield();
+    }
+  }
+  return NULL_PTR(void *);
+}
+
+/**
+ @brief pop all the items, checking their order.
+**/
+bool consume(ring_t &ring, const bool batched, const bool wait) {
+  uint32 expected = 0u;
+  while (expected < SPSC_TEST_ITEMS) {
+    uint32 items[16];
+    uint32 n;
+    if (wait) {
+      n = ring.pop_wait(items, batched ? 16u : 1u, 100000u);
+    } else {
+      n = batched ? ring.pop(items, 16u) : (ring.pop(items[0]) ? 1u : 0u);
+    }
+    if (n == 0u && !wait) {
+      sched_yield();
+    }
+    for (uint32 i = 0u; i < n; i++) {
+      if (items[i] != expected) {
+        return false;
+      }
+      expected++;
+    }
+  }
+  return ring.empty();
+}
+
+bool run(const bool batched, const bool wait) {
+  ring_t ring(wait);
+  producer_t producer = {&ring, batched};
+  pthread_t thread;
+  pthread_create(&thread, NULL_PTR(const pthread_attr_t *), produce,
+                 &producer);
+  const bool ok = consume(ring, batched, wait);
+  pthread_join(thread, NULL_PTR(void **));
+  return ok;
+}
+
+} // namespace
+
+bool SpscRingTest::TestPushPop() {
+  SpscRing<int32, 4u> ring;
+  T_ASSERT_EQ(ring.capacity(), 4u);
+  T_ASSERT_TRUE(ring.empty());
+  int32 v = 0;
+  T_ASSERT_FALSE(ring.pop(v));
+  // wraps around the buffer many times
+  for (int32 i = 0; i < 100; i++) {
+    T_ASSERT_TRUE(ring.push(i));
+    T_ASSERT_TRUE(ring.push(-i));
+    T_ASSERT_EQ(ring.len(), 2u);
+    T_ASSERT_TRUE(ring.pop(v));
+    T_ASSERT_EQ(v, i);
+    T_ASSERT_TRUE(ring.pop(v));
+    T_ASSERT_EQ(v, -i);
+  }
+  T_ASSERT_TRUE(ring.empty());
+  return true;
+}
+
+bool SpscRingTest::TestFull() {
+  SpscRing<uint32, 8u> ring;
+  for (uint32 i = 0u; i < 8u; i++) {
+    T_ASSERT_TRUE(ring.push(i));
+  }
+  T_ASSERT_FALSE(ring.push(8u));
+  T_ASSERT_EQ(ring.len(), 8u);
+  uint32 v;
+  T_ASSERT_TRUE(ring.pop(v));
+  T_ASSERT_EQ(v, 0u);
+  T_ASSERT_TRUE(ring.push(8u));
+  T_ASSERT_FALSE(ring.push(9u));
+  for (uint32 i = 1u; i <= 8u; i++) {
+    T_ASSERT_TRUE(ring.pop(v));
+    T_ASSERT_EQ(v, i);
+  }
+  T_ASSERT_FALSE(ring.pop(v));
+  return true;
+}
+
+bool SpscRingTest::TestBatch() {
+  SpscRing<uint32, 8u> ring;
+  uint32 in[12];
+  uint32 out[12];
+  for (uint32 i = 0u; i < 12u; i++) {
+    in[i] = i * 10u;
+  }
+  T_ASSERT_EQ(ring.push(in, 5u), 5u);
+  // only the free slots are filled
+  T_ASSERT_EQ(ring.push(in + 5u, 7u), 3u);
+  T_ASSERT_EQ(ring.push(in, 1u), 0u);
+  T_ASSERT_EQ(ring.pop(out, 3u), 3u);
+  T_ASSERT_EQ(ring.push(in + 8u, 4u), 3u);
+  T_ASSERT_EQ(ring.pop(out + 3u, 12u), 8u);
+  for (uint32 i = 0u; i < 11u; i++) {
+    T_ASSERT_EQ(out[i], in[i]);
+  }
+  T_ASSERT_EQ(ring.pop(out, 12u), 0u);
+  T_ASSERT_EQ(ring.push(in, 0u), 0u);
+  return true;
+}
+
+bool SpscRingTest::TestNonTrivial() {
+  {
+    SpscRing<Str, 4u> ring;
+    T_ASSERT_TRUE(ring.push(Str("a string longer than the inline buffer")));
+    T_ASSERT_TRUE(ring.push(Str("short")));
+    Str s;
+    T_ASSERT_TRUE(ring.pop(s));
+    T_ASSERT_TRUE(s == "a string longer than the inline buffer");
+  }
+  {
+    SpscRing<counted_t, 4u> ring;
+    T_ASSERT_TRUE(ring.push(counted_t(1u)));
+    T_ASSERT_TRUE(ring.push(counted_t(2u)));
+    T_ASSERT_EQ(counted_t::alive, 2);
+    counted_t c;
+    T_ASSERT_TRUE(ring.pop(c));
+    T_ASSERT_EQ(c.value, 1u);
+    T_ASSERT_EQ(counted_t::alive, 2);
+  }
+  // the elements left in the ring are destroyed with it
+  T_ASSERT_EQ(counted_t::alive, 0);
+  return true;
+}
+
+bool SpscRingTest::TestConcurrent() {
+  T_ASSERT_TRUE(run(false, false));
+  T_ASSERT_TRUE(run(true, false));
+  return true;
+}
+
+bool SpscRingTest::TestWait() {
+  SpscRing<uint32, 4u> ring(true);
+  uint32 v;
+  // times out on an empty ring
+  T_ASSERT_FALSE(ring.pop_wait(v, 1000u));
+  T_ASSERT_TRUE(ring.push(3u));
+  T_ASSERT_TRUE(ring.pop_wait(v, 1000u));
+  T_ASSERT_EQ(v, 3u);
+  T_ASSERT_TRUE(run(false, true));
+  T_ASSERT_TRUE(run(true, true));
+  return true;
+}
@@ -0,0 +1,17 @@
+#ifndef _SPSC_RING_TEST_H__
+#define _SPSC_RING_TEST_H__
+
+/**
+ @brief Tests single producer single consumer ring methods
+**/
+class SpscRingTest {
+public:
+  bool TestPushPop();
+  bool TestFull();
+  bool TestBatch();
+  bool TestNonTrivial();
+  bool TestConcurrent();
+  bool TestWait();
+};
+
+#endif
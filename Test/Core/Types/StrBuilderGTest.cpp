@@ -0,0 +1,42 @@
+#include "StrBuilderTest.h"
+#include "gtest/gtest.h"
+
+TEST(StrBuilder, TestAppend) {
+  StrBuilderTest tester;
+  ASSERT_TRUE(tester.TestAppend());
+}
+
+TEST(StrBuilder, TestIntegers) {
+  StrBuilderTest tester;
+  ASSERT_TRUE(tester.TestIntegers());
+}
+
+TEST(StrBuilder, TestFloats) {
+  StrBuilderTest tester;
+  ASSERT_TRUE(tester.TestFloats());
+}
+
+TEST(StrBuilder, TestPadded) {
+  StrBuilderTest tester;
+  ASSERT_TRUE(tester.TestPadded());
+}
+
+TEST(StrBuilder, TestFinish) {
+  StrBuilderTest tester;
+  ASSERT_TRUE(tester.TestFinish());
+}
+
+TEST(StrBuilder, TestGrowth) {
+  StrBuilderTest tester;
+  ASSERT_TRUE(tester.TestGrowth());
+}
+
+TEST(StrBuilder, TestSwap) {
+  StrBuilderTest tester;
+  ASSERT_TRUE(tester.TestSwap());
+}
+
+TEST(StrBuilder, TestJsonEscaped) {
+  StrBuilderTest tester;
+  ASSERT_TRUE(tester.TestJsonEscaped());
+}
@@ -0,0 +1,279 @@
+#include "StrBuilderTest.h"
+#include "TestMacros.h"
+
+#include "StrBuilder.h"
+
+#include <stdio.h>
+#include <string.h>
+
+using namespace MARTe;
+
+namespace {
+struct counting_allocator_t : public Allocator {
+  uint32 allocations;
+  counting_allocator_t() : allocations(0u) {}
+  virtual void *allocate(const uint32 size) {
+    allocations++;
+    return ::operator new(size);
+  }
+  virtual void deallocate(void *ptr, const uint32) { ::operator delete(ptr); }
+};
+
+/**
+ @brief reference JSON escaping, one char at a time
+**/
+void json_escape(Str &out, const char *str, const uint32 len) {
+  for (uint32 i = 0u; i < len; i++) {
+    const uint8 c = static_cast<uint8>(str[i]);
+    char buff[8];
+    if (c == '"' || c == '\\') {
+      out += '\\';
+      out += static_cast<char>(c);
+    } else if (c == '\n') {
+      out.append("\\n");
+    } else if (c == '\t') {
+      out.append("\\t");
+    } else if (c == '\r') {
+      out.append("\\r");
+    } else if (c == '\b') {
+      out.append("\\b");
+    } else if (c == '\f') {
+      out.append("\\f");
+    } else if (c < 0x20u) {
+      snprintf(buff, sizeof(buff), "\\u%04x", static_cast<uint32>(c));
+      out.append(buff);
+    } else {
+      out += static_cast<char>(c);
+    }
+  }
+}
+} // namespace
+
+bool StrBuilderTest::TestAppend() {
+  StrBuilder b;
+  T_ASSERT_EQ(b.len(), 0u);
+  T_ASSERT_STREQ(b.cstr(), "");
+  b.append('[').append("local").append(" x", 2u);
+  b.append(StrView("= 1]]", 2u)).append(Str(" 1"));
+  T_ASSERT_STREQ(b.cstr(), "[local x=  1");
+  T_ASSERT_EQ(b.len(), 12u);
+  T_ASSERT_TRUE(b.view() == "[local x=  1");
+  b.clear();
+  T_ASSERT_EQ(b.len(), 0u);
+  T_ASSERT_STREQ(b.cstr(), "");
+  b.append("again");
+  T_ASSERT_STREQ(b.cstr(), "again");
+  return true;
+}
+
+bool StrBuilderTest::TestIntegers() {
+  const int64 values[] = {0,
+                          1,
+                          -1,
+                          9,
+                          10,
+                          99,
+                          100,
+                          -12345,
+                          2147483647,
+                          -2147483647 - 1,
+                          1234567890123456789LL,
+                          -9223372036854775807LL - 1};
+  char ref[32];
+  for (uint32 i = 0u; i < sizeof(values) / sizeof(values[0]); i++) {
+    StrBuilder b;
+    b.append(values[i]);
+    snprintf(ref, sizeof(ref), "%lld", static_cast<long long>(values[i]));
+    T_ASSERT_STREQ(b.cstr(), ref);
+  }
+  StrBuilder b;
+  b.append(static_cast<uint64>(18446744073709551615ULL));
+  T_ASSERT_STREQ(b.cstr(), "18446744073709551615");
+  b.clear();
+  b.append(static_cast<uint32>(4294967295u)).append(',');
+  b.append(static_cast<int32>(-42));
+  T_ASSERT_STREQ(b.cstr(), "4294967295,-42");
+  // every number of digits
+  uint64 v = 1u;
+  for (uint32 i = 0u; i < 19u; i++) {
+    b.clear();
+    b.append(v);
+    snprintf(ref, sizeof(ref), "%llu", static_cast<unsigned long long>(v));
+    T_ASSERT_STREQ(b.cstr(), ref);
+    v = v * 10u + (i % 10u);
+  }
+  return true;
+}
+
+bool StrBuilderTest::TestFloats() {
+  // values far from the rounding ties
+  const float64 values[] = {0.0,     1.0,       -1.5,        3.14159265,
+                            0.001,   -0.000123, 123456.789,  1e-9,
+                            2.71828, 99.999999, 1e17 + 0.25, -42.0};
+  char ref[64];
+  for (uint32 i = 0u; i < sizeof(values) / sizeof(values[0]); i++) {
+    for (uint32 d = 0u; d <= 9u; d += 3u) {
+      StrBuilder b;
+      b.append(values[i], d);
+      snprintf(ref, sizeof(ref), "%.*f", static_cast<int>(d), values[i]);
+      T_ASSERT_STREQ(b.cstr(), ref);
+    }
+  }
+  StrBuilder b;
+  b.append(0.5, 0u);
+  T_ASSERT_STREQ(b.cstr(), "1");
+  b.clear();
+  b.append(0.9999999, 3u);
+  T_ASSERT_STREQ(b.cstr(), "1.000");
+  b.clear();
+  b.append(2.5e20, 2u);
+  T_ASSERT_STREQ(b.cstr(), "2.50e+20");
+  b.clear();
+  b.append(9.9999e30, 2u);
+  T_ASSERT_STREQ(b.cstr(), "1.00e+31");
+  b.clear();
+  b.append(0.0 / 0.0).append(' ').append(-1.0 / 0.0);
+  T_ASSERT_STREQ(b.cstr(), "nan -inf");
+  b.clear();
+  // float32 promoted, default 6 decimals
+  b.append(0.25f);
+  T_ASSERT_STREQ(b.cstr(), "0.250000");
+  return true;
+}
+
+bool StrBuilderTest::TestPadded() {
+  StrBuilder b;
+  b.append_padded(2026u, 4u).append('-').append_padded(3u, 2u);
+  b.append('-').append_padded(7u, 2u).append('T');
+  b.append_padded(42u, 6u).append('|').append_padded(123u, 2u);
+  b.append('|').append_padded(5u, 3u, ' ');
+  T_ASSERT_STREQ(b.cstr(), "2026-03-07T000042|123|  5");
+  return true;
+}
+
+bool StrBuilderTest::TestFinish() {
+  StrBuilder b;
+  b.append("a string longer than the inline buffer of Str");
+  const char *buffer = b.cstr();
+  Str s = b.finish();
+  T_ASSERT_STREQ(s.cstr(), "a string longer than the inline buffer of Str");
+  // the buffer has been moved, not copied
+  T_ASSERT_TRUE(s.cstr() == buffer);
+  T_ASSERT_EQ(b.len(), 0u);
+  T_ASSERT_STREQ(b.cstr(), "");
+  b.append("short");
+  Str t = b.finish();
+  T_ASSERT_STREQ(t.cstr(), "short");
+  // the allocator is kept after finish
+  counting_allocator_t alloc;
+  {
+    StrBuilder c(0u, &alloc);
+    c.append("x");
+    Str u = c.finish();
+    T_ASSERT_TRUE(u.allocator() == &alloc);
+    const uint32 n = alloc.allocations;
+    c.append(1234u);
+    T_ASSERT_EQ(alloc.allocations, n);
+    Str w = c.finish();
+    T_ASSERT_STREQ(w.cstr(), "1234");
+    T_ASSERT_TRUE(w.allocator() == &alloc);
+  }
+  return true;
+}
+
+bool StrBuilderTest::TestGrowth() {
+  counting_allocator_t alloc;
+  StrBuilder b(0u, &alloc);
+  const uint32 start = alloc.allocations;
+  for (uint32 i = 0u; i < 100000u; i++) {
+    b.append('x');
+  }
+  T_ASSERT_EQ(b.len(), 100000u);
+  // geometric growth: ~log2(100000 / 24) reallocations
+  T_ASSERT_TRUE(alloc.allocations - start < 16u);
+  // clear keeps the buffer
+  b.clear();
+  const uint32 n = alloc.allocations;
+  for (uint32 i = 0u; i < 1000u; i++) {
+    b.append("0123456789", 10u);
+  }
+  T_ASSERT_EQ(alloc.allocations, n);
+  // capacity reserved by the constructor
+  StrBuilder c(1000u, &alloc);
+  const uint32 m = alloc.allocations;
+  for (uint32 i = 0u; i < 100u; i++) {
+    c.append(static_cast<uint32>(1000000000u + i));
+  }
+  T_ASSERT_EQ(alloc.allocations, m);
+  return true;
+}
+
+bool StrBuilderTest::TestSwap() {
+  StrBuilder a;
+  StrBuilder b;
+  a.append("a string longer than the inline buffer of Str");
+  b.append("short");
+  const char *buffer = a.cstr();
+  a.swap(b);
+  T_ASSERT_STREQ(a.cstr(), "short");
+  T_ASSERT_STREQ(b.cstr(), "a string longer than the inline buffer of Str");
+  // the buffer has been exchanged, not copied
+  T_ASSERT_TRUE(b.cstr() == buffer);
+  b.clear();
+  b.swap(a);
+  T_ASSERT_STREQ(b.cstr(), "short");
+  T_ASSERT_EQ(a.len(), 0u);
+  // the allocators follow the buffers
+  counting_allocator_t alloc;
+  {
+    StrBuilder c(0u, &alloc);
+    StrBuilder d;
+    c.append("x");
+    c.swap(d);
+    T_ASSERT_STREQ(d.cstr(), "x");
+    const uint32 n = alloc.allocations;
+    for (uint32 i = 0u; i < 100u; i++) {
+      d.append("0123456789", 10u);
+    }
+    T_ASSERT_TRUE(alloc.allocations > n);
+  }
+  return true;
+}
+
+bool StrBuilderTest::TestJsonEscaped() {
+  StrBuilder b;
+  b.append_json_escaped("", 0u);
+  T_ASSERT_EQ(b.len(), 0u);
+  const char *msg = "say \"hi\"\n\tC:\\dir\r\x01\x1f\x7f caf\xc3\xa9";
+  b.append_json_escaped(msg, static_cast<uint32>(strlen(msg)));
+  T_ASSERT_STREQ(b.cstr(), "say \\\"hi\\\"\\n\\tC:\\\\dir\\r\\u0001\\u001f"
+                           "\x7f caf\xc3\xa9");
+  // every byte, alone
+  for (uint32 c = 0u; c < 256u; c++) {
+    const char ch = static_cast<char>(c);
+    Str expected;
+    json_escape(expected, &ch, 1u);
+    b.clear();
+    b.append_json_escaped(&ch, 1u);
+    T_ASSERT_STREQ(b.cstr(), expected.cstr());
+  }
+  // special chars at every position of clean runs (vector and scalar paths)
+  const char specials[] = {'"', '\\', '\n', 0, 0x1f, ' ', 0x7f};
+  for (uint32 len = 1u; len < 70u; len++) {
+    for (uint32 pos = 0u; pos < len; pos++) {
+      for (uint32 k = 0u; k < sizeof(specials); k++) {
+        char text[70];
+        memset(text, 'a', sizeof(text));
+        text[pos] = specials[k];
+        text[len - 1u] = (pos + 1u == len) ? specials[k] : '\\';
+        Str expected("<");
+        json_escape(expected, text, len);
+        b.clear();
+        b.append('<').append_json_escaped(text, len);
+        T_ASSERT_EQ(b.len(), expected.len());
+        T_ASSERT_TRUE(b.view() == expected.view());
+      }
+    }
+  }
+  return true;
+}
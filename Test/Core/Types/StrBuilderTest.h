@@ -0,0 +1,16 @@
+#ifndef STR_BUILDER_TEST_H__
+#define STR_BUILDER_TEST_H__
+
+class StrBuilderTest {
+public:
+  bool TestAppend();
+  bool TestIntegers();
+  bool TestFloats();
+  bool TestPadded();
+  bool TestFinish();
+  bool TestGrowth();
+  bool TestSwap();
+  bool TestJsonEscaped();
+};
+
+#endif
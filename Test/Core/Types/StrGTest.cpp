@@ -76,3 +76,18 @@ TEST(Str, TestHash) {
   StrTest tester;
   ASSERT_TRUE(tester.TestHash());
 }
+
+TEST(Str, TestSmallString) {
+  StrTest tester;
+  ASSERT_TRUE(tester.TestSmallString());
+}
+
+TEST(Str, TestAppend) {
+  StrTest tester;
+  ASSERT_TRUE(tester.TestAppend());
+}
+
+TEST(Str, TestAllocator) {
+  StrTest tester;
+  ASSERT_TRUE(tester.TestAllocator());
+}
@@ -179,6 +179,14 @@ bool StrTest::TestFind() {
   res = str.find("$ANS");
   T_ASSERT_FALSE(res.empty());
   T_ASSERT_EQ(res.val(), 1);
+  // partial matches must not skip the real one
+  str = "aaab]]";
+  res = str.find("aab");
+  T_ASSERT_FALSE(res.empty());
+  T_ASSERT_EQ(res.val(), 1);
+  res = str.find("]]");
+  T_ASSERT_FALSE(res.empty());
+  T_ASSERT_EQ(res.val(), 4);
   return true;
 }
 
@@ -235,3 +243,122 @@ bool StrTest::TestHash() {
   T_ASSERT_DE(a.hash(), b.hash());
   return true;
 }
+
+bool StrTest::TestSmallString() {
+  MARTe::Str a;
+  T_ASSERT_EQ(a.capacity(), MARTe::Str::inline_size - 1u);
+  MARTe::Str b("an_identifier_of_23_chr");
+  T_ASSERT_EQ(b.len(), 23u);
+  T_ASSERT_EQ(b.capacity(), MARTe::Str::inline_size - 1u);
+  MARTe::Str c = b + "!";
+  T_ASSERT_EQ(c.len(), 24u);
+  T_ASSERT_GTE(c.capacity(), 24u);
+  T_ASSERT_STREQ(c.cstr(), "an_identifier_of_23_chr!");
+  // copies of short strings stay inline
+  MARTe::Str d(b);
+  T_ASSERT_TRUE(d == b);
+  T_ASSERT_TRUE(d.cstr() != b.cstr());
+  d = c;
+  T_ASSERT_TRUE(d == c);
+  d = "short";
+  T_ASSERT_STREQ(d.cstr(), "short");
+  MARTe::Str e("abcdef", 3);
+  T_ASSERT_EQ(e.len(), 3u);
+  T_ASSERT_STREQ(e.cstr(), "abc");
+  return true;
+}
+
+bool StrTest::TestAppend() {
+  MARTe::Str a;
+  MARTe::uint32 reallocations = 0u;
+  MARTe::uint32 capacity = a.capacity();
+  for (MARTe::uint32 i = 0; i < 4096u; i++) {
+    a.append("x");
+    if (a.capacity() != capacity) {
+      capacity = a.capacity();
+      reallocations++;
+    }
+  }
+  T_ASSERT_EQ(a.len(), 4096u);
+  // geometric growth
+  T_ASSERT_LTE(reallocations, 9u);
+  MARTe::Str b("abc");
+  b.append(b).append(b.cstr() + 1, 2).append(MARTe::Str("!"));
+  T_ASSERT_STREQ(b.cstr(), "abcabcbc!");
+  b.reserve(100u);
+  T_ASSERT_GTE(b.capacity(), 100u);
+  T_ASSERT_STREQ(b.cstr(), "abcabcbc!");
+  // appending to itself while growing
+  for (MARTe::uint32 i = 0; i < 4; i++) {
+    b.append(b);
+  }
+  T_ASSERT_EQ(b.len(), 9u * 16u);
+  T_ASSERT_TRUE(b.substr(9, 18) == "abcabcbc!");
+#if __cplusplus >= 201103L
+  MARTe::Str c(static_cast<MARTe::Str &&>(b));
+  T_ASSERT_EQ(c.len(), 9u * 16u);
+  T_ASSERT_EQ(b.len(), 0u);
+  T_ASSERT_STREQ(b.cstr(), "");
+  MARTe::Str d("short");
+  c = static_cast<MARTe::Str &&>(d);
+  T_ASSERT_STREQ(c.cstr(), "short");
+  T_ASSERT_EQ(d.len(), 0u);
+#endif
+  return true;
+}
+
+namespace {
+struct counting_allocator_t : public MARTe::Allocator {
+  MARTe::uint32 allocations;
+  MARTe::uint32 bytes;
+  counting_allocator_t() : allocations(0u), bytes(0u) {}
+  virtual void *allocate(const MARTe::uint32 size) {
+    allocations++;
+    bytes += size;
+    return ::operator new(size);
+  }
+  virtual void deallocate(void *ptr, const MARTe::uint32 size) {
+    bytes -= size;
+    ::operator delete(ptr);
+  }
+};
+} // namespace
+
+bool StrTest::TestAllocator() {
+  counting_allocator_t alloc;
+  {
+    MARTe::Str a(&alloc);
+    T_ASSERT_TRUE(a.allocator() == &alloc);
+    T_ASSERT_EQ(alloc.allocations, 1u);
+    T_ASSERT_EQ(a.len(), 0u);
+    T_ASSERT_STREQ(a.cstr(), "");
+    // never uses the inline buffer
+    a.append("short");
+    T_ASSERT_EQ(alloc.allocations, 1u);
+    a.append(" string growing beyond the inline buffer");
+    T_ASSERT_STREQ(a.cstr(), "short string growing beyond the inline buffer");
+    T_ASSERT_TRUE(a.allocator() == &alloc);
+    // copies use the same allocator, assignments keep their own
+    MARTe::Str b(a);
+    T_ASSERT_TRUE(b.allocator() == &alloc);
+    T_ASSERT_TRUE(b == a);
+    MARTe::Str c;
+    c = a;
+    T_ASSERT_TRUE(c.allocator() == NULL_PTR(MARTe::Allocator *));
+    T_ASSERT_TRUE(c == a);
+    MARTe::Str d("buffer", 3u, &alloc);
+    T_ASSERT_STREQ(d.cstr(), "buf");
+    // the result of an operation is on the heap
+    MARTe::Str e = d + "fer";
+    T_ASSERT_STREQ(e.cstr(), "buffer");
+    T_ASSERT_TRUE(e.allocator() == NULL_PTR(MARTe::Allocator *));
+    d.append(d);
+    T_ASSERT_STREQ(d.cstr(), "bufbuf");
+  }
+  T_ASSERT_EQ(alloc.bytes, 0u);
+  // a null allocator is the heap
+  MARTe::Str f(NULL_PTR(MARTe::Allocator *));
+  T_ASSERT_TRUE(f.allocator() == NULL_PTR(MARTe::Allocator *));
+  T_ASSERT_EQ(f.capacity(), MARTe::Str::inline_size - 1u);
+  return true;
+}
@@ -18,6 +18,9 @@ public:
   bool TestSubstringSimple();
   bool TestSubstringFull();
   bool TestHash();
+  bool TestSmallString();
+  bool TestAppend();
+  bool TestAllocator();
 };
 
 #endif
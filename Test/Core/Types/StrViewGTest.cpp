@@ -0,0 +1,42 @@
+#include "StrViewTest.h"
+#include "gtest/gtest.h"
+
+TEST(StrView, TestConstructor) {
+  StrViewTest tester;
+  ASSERT_TRUE(tester.TestConstructor());
+}
+
+TEST(StrView, TestSubstring) {
+  StrViewTest tester;
+  ASSERT_TRUE(tester.TestSubstring());
+}
+
+TEST(StrView, TestFind) {
+  StrViewTest tester;
+  ASSERT_TRUE(tester.TestFind());
+}
+
+TEST(StrView, TestComparison) {
+  StrViewTest tester;
+  ASSERT_TRUE(tester.TestComparison());
+}
+
+TEST(StrView, TestHash) {
+  StrViewTest tester;
+  ASSERT_TRUE(tester.TestHash());
+}
+
+TEST(StrView, TestFindLong) {
+  StrViewTest tester;
+  ASSERT_TRUE(tester.TestFindLong());
+}
+
+TEST(StrView, TestComparisonLong) {
+  StrViewTest tester;
+  ASSERT_TRUE(tester.TestComparisonLong());
+}
+
+TEST(StrView, TestHash64) {
+  StrViewTest tester;
+  ASSERT_TRUE(tester.TestHash64());
+}
@@ -0,0 +1,206 @@
+#include "Option.h"
+#include "StrViewTest.h"
+#include "TestMacros.h"
+
+#include "Str.h"
+#include "StrView.h"
+
+#include <string.h>
+
+bool StrViewTest::TestConstructor() {
+  MARTe::StrView a;
+  T_ASSERT_EQ(a.len(), 0);
+  T_ASSERT_TRUE(a.empty());
+  const char *code = "local x = 1";
+  MARTe::StrView b(code);
+  T_ASSERT_EQ(b.len(), 11);
+  T_ASSERT_TRUE(b.data() == code);
+  MARTe::StrView c(code, 5);
+  T_ASSERT_EQ(c.len(), 5);
+  T_ASSERT_EQ(c[0], 'l');
+  T_ASSERT_EQ(c[-1], 'l');
+  MARTe::Str d = c.str();
+  T_ASSERT_STREQ(d.cstr(), "local");
+  MARTe::StrView e = d.view();
+  T_ASSERT_TRUE(e.data() == d.cstr());
+  T_ASSERT_TRUE(e == c);
+  return true;
+}
+
+bool StrViewTest::TestSubstring() {
+  MARTe::StrView str("hello world");
+  // same semantic of Str::substr, without copies
+  T_ASSERT_TRUE(str.substr(5) == "hello");
+  T_ASSERT_TRUE(str.substr(-5) == "hello ");
+  T_ASSERT_EQ(str.substr(12).len(), str.len());
+  T_ASSERT_EQ(str.substr(-12).len(), 0);
+  T_ASSERT_TRUE(str.substr(6, 0) == "world");
+  T_ASSERT_TRUE(str.substr(6, 0).data() == str.data() + 6);
+  T_ASSERT_TRUE(str.substr(-5, -1) == "worl");
+  T_ASSERT_TRUE(str.substr(0, 100) == "hello world");
+  T_ASSERT_TRUE(str.substr(7, 6).empty());
+  T_ASSERT_TRUE(str.substr(11, 0).empty());
+  MARTe::Str full("hello world");
+  for (MARTe::int32 i = -12; i < 12; i++) {
+    for (MARTe::int32 j = -12; j < 12; j++) {
+      T_ASSERT_TRUE(str.substr(i, j) == full.substr(i, j).view());
+    }
+  }
+  return true;
+}
+
+bool StrViewTest::TestFind() {
+  MARTe::StrView str("hello world!");
+  MARTe::Option<MARTe::uint32> res = str.find("world");
+  T_ASSERT_FALSE(res.empty());
+  T_ASSERT_EQ(res.val(), 6);
+  res = str.find("hello", 1);
+  T_ASSERT_TRUE(res.empty());
+  res = str.find("!");
+  T_ASSERT_FALSE(res.empty());
+  T_ASSERT_EQ(res.val(), 11);
+  res = str.find("world!!");
+  T_ASSERT_TRUE(res.empty());
+  res = str.find("");
+  T_ASSERT_TRUE(res.empty());
+  res = str.find('o');
+  T_ASSERT_FALSE(res.empty());
+  T_ASSERT_EQ(res.val(), 4);
+  res = str.find('o', 5);
+  T_ASSERT_FALSE(res.empty());
+  T_ASSERT_EQ(res.val(), 7);
+  res = str.find('o', 12);
+  T_ASSERT_TRUE(res.empty());
+  // the view is not null terminated
+  MARTe::StrView sub = str.substr(4);
+  T_ASSERT_TRUE(sub.find('o').empty());
+  T_ASSERT_TRUE(sub.find("hello").empty());
+  // backtracking after partial matches
+  MARTe::StrView brackets("]=]==]==]");
+  res = brackets.find("]==]");
+  T_ASSERT_FALSE(res.empty());
+  T_ASSERT_EQ(res.val(), 2);
+  return true;
+}
+
+bool StrViewTest::TestComparison() {
+  MARTe::StrView a("abc");
+  MARTe::StrView b("abcd", 3);
+  T_ASSERT_TRUE(a == b);
+  T_ASSERT_FALSE(a != b);
+  T_ASSERT_TRUE(a != "abcd");
+  T_ASSERT_TRUE(a < "abcd");
+  T_ASSERT_TRUE(a < "abd");
+  T_ASSERT_TRUE(a > "ab");
+  T_ASSERT_FALSE(a < b);
+  T_ASSERT_FALSE(a > b);
+  T_ASSERT_TRUE(MARTe::StrView() < a);
+  return true;
+}
+
+bool StrViewTest::TestHash() {
+  MARTe::Str a("identifier");
+  MARTe::StrView b("identifier = 1", 10);
+  T_ASSERT_EQ(a.hash(), b.hash());
+  T_ASSERT_DE(b.hash(), MARTe::StrView("identifieR").hash());
+  return true;
+}
+
+namespace {
+// reference implementation of find
+MARTe::int32 naive_find(const char *text, MARTe::uint32 n, const char *needle,
+                        MARTe::uint32 m) {
+  for (MARTe::uint32 i = 0u; i + m <= n; i++) {
+    MARTe::uint32 j = 0u;
+    while (j < m && text[i + j] == needle[j]) {
+      j++;
+    }
+    if (j == m) {
+      return static_cast<MARTe::int32>(i);
+    }
+  }
+  return -1;
+}
+} // namespace
+
+bool StrViewTest::TestFindLong() {
+  // longer than the vector blocks, many partial matches
+  char text[200];
+  for (MARTe::uint32 i = 0u; i < sizeof(text); i++) {
+    text[i] = static_cast<char>('a' + (i * 7u) % 3u);
+  }
+  const char *needles[] = {"ab", "abc", "aacbb", "cbacbacb", "abcabcabcabcabca",
+                           "bacbacbacbacbacbacbacbacbacbacbacbacb", "aaa"};
+  for (MARTe::uint32 k = 0u; k < sizeof(needles) / sizeof(needles[0]); k++) {
+    const MARTe::StrView needle(needles[k]);
+    for (MARTe::uint32 len = 0u; len <= sizeof(text); len += 7u) {
+      const MARTe::StrView str(text, len);
+      for (MARTe::uint32 start = 0u; start < len; start += 13u) {
+        const MARTe::int32 ref = naive_find(text + start, len - start,
+                                            needle.data(), needle.len());
+        MARTe::Option<MARTe::uint32> res = str.find(needle, start);
+        T_ASSERT_EQ(res.empty(), (ref < 0));
+        if (ref >= 0) {
+          T_ASSERT_EQ(res.val(), start + static_cast<MARTe::uint32>(ref));
+        }
+      }
+    }
+  }
+  // match at the very end of a long text
+  MARTe::Str big;
+  for (MARTe::uint32 i = 0u; i < 100u; i++) {
+    big.append("]=]=");
+  }
+  big.append("]==]");
+  MARTe::Option<MARTe::uint32> res = big.find("]==]");
+  T_ASSERT_FALSE(res.empty());
+  T_ASSERT_EQ(res.val(), 400);
+  return true;
+}
+
+bool StrViewTest::TestComparisonLong() {
+  const char *a = "local identifier_with_a_long_name_0";
+  const char *b = "local identifier_with_a_long_name_1";
+  for (MARTe::uint32 len = 0u; len < 35u; len++) {
+    T_ASSERT_TRUE(MARTe::StrView(a, len) == MARTe::StrView(b, len));
+    T_ASSERT_FALSE(MARTe::StrView(a, len) < MARTe::StrView(b, len));
+  }
+  T_ASSERT_TRUE(MARTe::StrView(a) != MARTe::StrView(b));
+  T_ASSERT_TRUE(MARTe::StrView(a) < MARTe::StrView(b));
+  T_ASSERT_TRUE(MARTe::StrView(b) > MARTe::StrView(a));
+  // a difference in every position of a 20 chars string
+  char x[21] = "abcdefghijklmnopqrst";
+  char y[21] = "abcdefghijklmnopqrst";
+  for (MARTe::uint32 i = 0u; i < 20u; i++) {
+    y[i] = 'z';
+    T_ASSERT_TRUE(MARTe::StrView(x) != MARTe::StrView(y));
+    T_ASSERT_TRUE(MARTe::StrView(x) < MARTe::StrView(y));
+    y[i] = '\x80';
+    // chars are compared as unsigned
+    T_ASSERT_TRUE(MARTe::StrView(x) < MARTe::StrView(y));
+    y[i] = x[i];
+  }
+  T_ASSERT_TRUE(MARTe::StrView(x) == MARTe::StrView(y));
+  return true;
+}
+
+bool StrViewTest::TestHash64() {
+  const char *text = "local identifier_with_a_long_name = 1 -- comment "
+                     "that is longer than forty eight characters";
+  const MARTe::uint32 n = static_cast<MARTe::uint32>(strlen(text));
+  MARTe::uint64 prev = MARTe::StrView(text, 0u).hash64();
+  for (MARTe::uint32 len = 1u; len <= n; len++) {
+    const MARTe::StrView v(text, len);
+    const MARTe::uint64 h = v.hash64();
+    // every prefix has a different hash
+    T_ASSERT_DE(h, prev);
+    prev = h;
+    // depends only on the content
+    MARTe::Str copy(text, len);
+    T_ASSERT_EQ(copy.hash64(), h);
+    T_ASSERT_EQ(copy.hash(), v.hash());
+  }
+  T_ASSERT_DE(MARTe::StrView("identifier").hash64(),
+              MARTe::StrView("identifieR").hash64());
+  return true;
+}
@@ -0,0 +1,16 @@
+#ifndef STR_VIEW_TEST_H__
+#define STR_VIEW_TEST_H__
+
+class StrViewTest {
+public:
+  bool TestConstructor();
+  bool TestSubstring();
+  bool TestFind();
+  bool TestComparison();
+  bool TestHash();
+  bool TestFindLong();
+  bool TestComparisonLong();
+  bool TestHash64();
+};
+
+#endif
@@ -42,4 +42,22 @@ TEST(Vec, TestSet) {
   ASSERT_TRUE(tester.TestSet());
 }
 
+TEST(Vec, TestGrowth) {
+  VecTest tester;
+  ASSERT_TRUE(tester.TestGrowth());
+}
+
+TEST(Vec, TestNonTrivial) {
+  VecTest tester;
+  ASSERT_TRUE(tester.TestNonTrivial());
+}
 
+TEST(Vec, TestIterator) {
+  VecTest tester;
+  ASSERT_TRUE(tester.TestIterator());
+}
+
+TEST(Vec, TestAllocator) {
+  VecTest tester;
+  ASSERT_TRUE(tester.TestAllocator());
+}
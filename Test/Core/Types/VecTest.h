@@ -15,6 +15,10 @@ public:
   bool TestFind();
   bool TestEquality();
   bool TestSet();
+  bool TestGrowth();
+  bool TestNonTrivial();
+  bool TestIterator();
+  bool TestAllocator();
 };
 
 